@@ -13,3 +13,18 @@ SUBDIRS = \
 
 CONFIG += ordered
 
+# The layout library tests are built with "-config tests".  Run them
+# with "make check".
+CONFIG(tests) {
+	SUBDIRS += libcola/tests/tests.pro \
+		libavoid/tests/tests.pro
+}
+
+# Benchmark programs for the layout libraries and the Sminthopsys plugin
+# are built with "-config benchmarks".
+CONFIG(benchmarks) {
+	SUBDIRS += libvpsc/tests/benchmarks.pro \
+		libcola/tests/benchmarks.pro \
+		libavoid/tests/benchmarks.pro \
+		plugins/application/sminthopsys/tests/sbml_load_benchmark.pro
+}
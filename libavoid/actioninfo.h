@@ -26,6 +26,7 @@
 #define AVOID_ACTIONINFO_H
 
 #include <list>
+#include <map>
 
 #include "libavoid/actioninfo.h"
 #include "libavoid/connend.h"
@@ -83,6 +84,11 @@ class ActionInfo {
 };
 typedef std::list<ActionInfo> ActionInfoList;
 
+// Indexes the queued actions by their type and object, so the action for 
+// an object can be found and updated without searching the whole list.
+typedef std::map<std::pair<ActionType, const void *>, 
+        ActionInfoList::iterator> ActionInfoIndex;
+
 
 }
 #endif
@@ -71,7 +71,7 @@ ShapeConnectionPin::ShapeConnectionPin(ShapeRef *shape,
     // Create a visibility vertex for this ShapeConnectionPin.
     VertID id(m_shape->id(), kShapeConnectionPin, 
             VertID::PROP_ConnPoint | VertID::PROP_ConnectionPin);
-    m_vertex = new VertInf(m_router, id, this->position());
+    m_vertex = new (m_router) VertInf(m_router, id, this->position());
     m_vertex->visDirections = this->directions();
     
     if (m_vertex->visDirections == ConnDirAll)
@@ -85,6 +85,7 @@ ShapeConnectionPin::ShapeConnectionPin(ShapeRef *shape,
     {
         vertexVisibility(m_vertex, NULL, true, true);
     }
+    m_router->setStaticGraphInvalidated(true);
 }
 
 
@@ -108,13 +109,14 @@ ShapeConnectionPin::ShapeConnectionPin(JunctionRef *junction,
     // Create a visibility vertex for this ShapeConnectionPin.
     VertID id(m_junction->id(), kShapeConnectionPin, 
             VertID::PROP_ConnPoint | VertID::PROP_ConnectionPin);
-    m_vertex = new VertInf(m_router, id, m_junction->position());
+    m_vertex = new (m_router) VertInf(m_router, id, m_junction->position());
     m_vertex->visDirections = visDirs;
 
     if (m_router->m_allows_polyline_routing)
     {
         vertexVisibility(m_vertex, NULL, true, true);
     }
+    m_router->setStaticGraphInvalidated(true);
 }
 
 
@@ -129,6 +131,7 @@ ShapeConnectionPin::~ShapeConnectionPin()
     {
         m_junction->removeConnectionPin(this);
     }
+    m_router->setStaticGraphInvalidated(true);
 
     // Disconnect connend using this pin.
     while (!m_connend_users.empty())
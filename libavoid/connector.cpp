@@ -54,6 +54,8 @@ ConnRef::ConnRef(Router *router, const unsigned int id)
       m_active(false),
       m_hate_crossings(false),
       m_route_dist(0),
+      m_search_cost(0),
+      m_search_expansions(0),
       m_src_vert(NULL),
       m_dst_vert(NULL),
       m_start_vert(NULL),
@@ -83,6 +85,8 @@ ConnRef::ConnRef(Router *router, const ConnEnd& src, const ConnEnd& dst,
       m_active(false),
       m_hate_crossings(false),
       m_route_dist(0),
+      m_search_cost(0),
+      m_search_expansions(0),
       m_src_vert(NULL),
       m_dst_vert(NULL),
       m_callback_func(NULL),
@@ -113,9 +117,19 @@ ConnRef::~ConnRef()
     m_router->m_conn_reroute_flags.removeConn(this);
 
     m_router->removeObjectFromQueuedActions(this);
+    m_router->m_route_cache.erase(this);
 
     freeRoutes();
 
+    if ((m_src_vert && (m_src_vert->visDirections != ConnDirNone)) ||
+            (m_dst_vert && (m_dst_vert->visDirections != ConnDirNone)) ||
+            !m_checkpoint_vertices.empty())
+    {
+        // Some of the vertices being removed are included in the static 
+        // orthogonal visibility graph.
+        m_router->setStaticGraphInvalidated(true);
+    }
+
     if (m_src_vert)
     {
         m_src_vert->removeFromGraph();
@@ -201,11 +215,12 @@ void ConnRef::setRoutingCheckpoints(const std::vector<Checkpoint>& checkpoints)
     {
         VertID ptID(m_id, 2 + i, 
                 VertID::PROP_ConnPoint | VertID::PROP_ConnCheckpoint);
-        VertInf *vertex = new VertInf(m_router, ptID, m_checkpoints[i].point);
+        VertInf *vertex = new (m_router) VertInf(m_router, ptID, m_checkpoints[i].point);
         vertex->visDirections = ConnDirAll;
 
         m_checkpoint_vertices.push_back(vertex);
     }
+    m_router->setStaticGraphInvalidated(true);
     if (m_router->m_allows_polyline_routing)
     {
         for (size_t i = 0; i < m_checkpoints.size(); ++i)
@@ -235,6 +250,13 @@ void ConnRef::common_updateEndPoint(const unsigned int type, ConnEnd connEnd)
     
     VertInf *altered = NULL;
 
+    // Endpoints with visibility are included in the static orthogonal 
+    // visibility graph, so it needs to be rebuilt if one changes.
+    VertInf *previous = 
+            (type == (unsigned int) VertID::src) ? m_src_vert : m_dst_vert;
+    const bool hadVisibility = 
+            previous && (previous->visDirections != ConnDirNone);
+
     VertIDProps properties = VertID::PROP_ConnPoint;
     if (connEnd.isPinConnection())
     {
@@ -249,7 +271,7 @@ void ConnRef::common_updateEndPoint(const unsigned int type, ConnEnd connEnd)
         }
         else
         {
-            m_src_vert = new VertInf(m_router, ptID, point);
+            m_src_vert = new (m_router) VertInf(m_router, ptID, point);
         }
         m_src_vert->visDirections = connEnd.directions();
 
@@ -277,7 +299,7 @@ void ConnRef::common_updateEndPoint(const unsigned int type, ConnEnd connEnd)
         }
         else
         {
-            m_dst_vert = new VertInf(m_router, ptID, point);
+            m_dst_vert = new (m_router) VertInf(m_router, ptID, point);
         }
         m_dst_vert->visDirections = connEnd.directions();
         
@@ -303,7 +325,10 @@ void ConnRef::common_updateEndPoint(const unsigned int type, ConnEnd connEnd)
     altered->removeFromGraph(isConn);
 
     makePathInvalid();
-    m_router->setStaticGraphInvalidated(true);
+    if (hadVisibility || (altered->visDirections != ConnDirNone))
+    {
+        m_router->setStaticGraphInvalidated(true);
+    }
 }
 
 
@@ -505,7 +530,7 @@ bool ConnRef::setEndpoint(const unsigned int type, const VertID& pointID,
     common_updateEndPoint(type, point);
 
     // Give this visibility just to the point it is over.
-    EdgeInf *edge = new EdgeInf(
+    EdgeInf *edge = new (m_router) EdgeInf(
             (type == VertID::src) ? m_src_vert : m_dst_vert, vInf);
     // XXX: We should be able to set this to zero, but can't due to 
     //      assumptions elsewhere in the code.
@@ -857,7 +882,7 @@ std::pair<bool, bool> ConnRef::assignConnectionPinVisibility(const bool connect)
 }
 
 
-bool ConnRef::generatePath(void)
+bool ConnRef::needsPathGeneration(void) const
 {
     if (!m_false_path && !m_needs_reroute_flag)
     {
@@ -871,6 +896,31 @@ bool ConnRef::generatePath(void)
         return false;
     }
     
+    return true;
+}
+
+
+bool ConnRef::hasIndependentPathSearch(void) const
+{
+    // Checkpoint routing changes the visibility of the checkpoint vertices,
+    // and rubber-band routing follows the existing route.
+    if (!m_checkpoints.empty() || m_router->RubberBandRouting)
+    {
+        return false;
+    }
+
+    // Exclusive connection pins are handed out in routing order.
+    if ((m_src_connend && m_src_connend->usesExclusivePins()) ||
+            (m_dst_connend && m_dst_connend->usesExclusivePins()))
+    {
+        return false;
+    }
+    return true;
+}
+
+
+std::pair<bool, bool> ConnRef::beginPathGeneration(void)
+{
     //COLA_ASSERT(_srcVert->point != _dstVert->point);
 
     m_false_path = false;
@@ -879,19 +929,14 @@ bool ConnRef::generatePath(void)
     m_start_vert = m_src_vert;
 
     // Visibility assignment for connection pins.
-    std::pair<bool, bool> isDummyAtEnd = assignConnectionPinVisibility(true);
-    
-    std::vector<Point> path;
-    std::vector<VertInf *> vertices;
-    if (m_checkpoints.empty())
-    {
-        generateStandardPath(path, vertices);
-    }
-    else
-    {
-        generateCheckpointsPath(path, vertices);
-    }
+    return assignConnectionPinVisibility(true);
+}
+
 
+void ConnRef::finishPathGeneration(const std::vector<Point>& path,
+        const std::vector<VertInf *>& vertices, 
+        const std::pair<bool, bool>& isDummyAtEnd)
+{
     COLA_ASSERT(vertices.size() >= 2);
     COLA_ASSERT(vertices[0] == src());
     COLA_ASSERT(vertices[vertices.size() - 1] == dst());
@@ -913,22 +958,22 @@ bool ConnRef::generatePath(void)
         }
 
         VertInf *vertex = vertices[i];
-        if (vertex->pathNext && 
-                (vertex->pathNext->point == vertex->point))
+        VertInf *prevVertex = vertices[i - 1];
+        if (prevVertex->point == vertex->point)
         {
-            if (!(vertex->pathNext->id.isConnPt()) && !(vertex->id.isConnPt()))
+            if (!(prevVertex->id.isConnPt()) && !(vertex->id.isConnPt()))
             {
                 // Check for consecutive points on opposite 
                 // corners of two touching shapes.
-                COLA_ASSERT(abs(vertex->pathNext->id.vn - vertex->id.vn) != 2);
+                COLA_ASSERT(abs(prevVertex->id.vn - vertex->id.vn) != 2);
             }
         }
     }
 
     // Get rid of dummy ShapeConnectionPin bridging points at beginning and end.
     std::vector<Point> clippedPath;
-    std::vector<Point>::iterator pathBegin = path.begin();
-    std::vector<Point>::iterator pathEnd = path.end();
+    std::vector<Point>::const_iterator pathBegin = path.begin();
+    std::vector<Point>::const_iterator pathEnd = path.end();
     if (path.size() > 2 && isDummyAtEnd.first)
     {
         ++pathBegin;
@@ -960,6 +1005,30 @@ bool ConnRef::generatePath(void)
     }
     db_printf("\n\n");
 #endif
+}
+
+
+bool ConnRef::generatePath(void)
+{
+    if (!needsPathGeneration())
+    {
+        return false;
+    }
+
+    std::pair<bool, bool> isDummyAtEnd = beginPathGeneration();
+    
+    std::vector<Point> path;
+    std::vector<VertInf *> vertices;
+    if (m_checkpoints.empty())
+    {
+        generateStandardPath(path, vertices);
+    }
+    else
+    {
+        generateCheckpointsPath(path, vertices);
+    }
+
+    finishPathGeneration(path, vertices, isDummyAtEnd);
 
     return true;
 }
@@ -1001,7 +1070,7 @@ void ConnRef::generateCheckpointsPath(std::vector<Point>& path,
         }
         
         // Route the connector
-        aStarPath(this, start, end, NULL); 
+        aStarPath(this, start, end, NULL, &m_search_expansions);
 
         // Restore changes made for checkpoint visbility directions.
         if (lastSuccessfulIndex > 0)
@@ -1071,35 +1140,99 @@ void ConnRef::generateStandardPath(std::vector<Point>& path,
         std::vector<VertInf *>& vertices)
 {
     VertInf *tar = m_dst_vert;
-    size_t existingPathStart = 0;
-    const PolyLine& currRoute = route();
-    if (m_router->RubberBandRouting)
+    vertices.clear();
+    if (!m_router->RubberBandRouting)
     {
-        COLA_ASSERT(m_router->IgnoreRegions == true);
+        std::vector<VertInf *> found;
+        aStarSearch(this, src(), dst(), start(), found, &m_search_cost,
+                &m_search_expansions);
 
-#ifdef PATHDEBUG
-        db_printf("\n");
-        _srcVert->id.db_print();
-        db_printf(": %g, %g\n", _srcVert->point.x, _srcVert->point.y);
-        tar->id.db_print();
-        db_printf(": %g, %g\n", tar->point.x, tar->point.y);
-        for (size_t i = 0; i < currRoute.ps.size(); ++i)
+        // The search may have started from a segment leading into the 
+        // source, so take the path from where it last leaves the source.
+        std::vector<VertInf *>::reverse_iterator srcPos = 
+                std::find(found.rbegin(), found.rend(), m_src_vert);
+        if (srcPos != found.rend())
+        {
+            vertices.assign(srcPos.base() - 1, found.end());
+        }
+    }
+    else
+    {
+        generateRubberBandPath(vertices);
+    }
+
+    if (vertices.size() < 2)
+    {
+        // There is no valid path.
+        db_printf("Warning: Path not found...\n");
+        m_needs_reroute_flag = true;
+        vertices.clear();
+        vertices.push_back(m_src_vert);
+        vertices.push_back(tar);
+        if ((m_type == ConnType_PolyLine) && m_router->InvisibilityGrph)
         {
-            db_printf("%g, %g  ", currRoute.ps[i].x, currRoute.ps[i].y);
+            // TODO:  Could we know this edge already?
+            //EdgeInf *edge = EdgeInf::existingEdge(m_src_vert, tar);
+            //COLA_ASSERT(edge != NULL);
+            //edge->addCycleBlocker();
         }
-        db_printf("\n");
+    }
+
+    size_t pathlen = vertices.size();
+    path.resize(pathlen);
+    for (size_t j = 1; j < pathlen; ++j)
+    {
+        VertInf *i = vertices[j];
+        path[j] = i->point;
+        if (i->id.isConnPt())
+        {
+            path[j].id = m_id;
+            path[j].vn = kUnassignedVertexNumber;
+        }
+        else
+        {
+            path[j].id = i->id.objID;
+            path[j].vn = i->id.vn;
+        }
+    }
+    path[0] = m_src_vert->point;
+    // Use topbit to differentiate between start and end point of connector.
+    // They need unique IDs for nudging.
+    unsigned int topbit = ((unsigned int) 1) << 31;
+    path[0].id = m_id | topbit; 
+    path[0].vn = kUnassignedVertexNumber;
+}
+
+
+void ConnRef::generateRubberBandPath(std::vector<VertInf *>& vertices)
+{
+    VertInf *tar = m_dst_vert;
+    size_t existingPathStart = 0;
+    const PolyLine& currRoute = route();
+    COLA_ASSERT(m_router->IgnoreRegions == true);
+
+#ifdef PATHDEBUG
+    db_printf("\n");
+    _srcVert->id.db_print();
+    db_printf(": %g, %g\n", _srcVert->point.x, _srcVert->point.y);
+    tar->id.db_print();
+    db_printf(": %g, %g\n", tar->point.x, tar->point.y);
+    for (size_t i = 0; i < currRoute.ps.size(); ++i)
+    {
+        db_printf("%g, %g  ", currRoute.ps[i].x, currRoute.ps[i].y);
+    }
+    db_printf("\n");
 #endif
-        if (currRoute.size() > 2)
+    if (currRoute.size() > 2)
+    {
+        if (m_src_vert->point == currRoute.ps[0])
         {
-            if (m_src_vert->point == currRoute.ps[0])
-            {
-                existingPathStart = currRoute.size() - 2;
-                COLA_ASSERT(existingPathStart != 0);
-                const Point& pnt = currRoute.at(existingPathStart);
-                VertID vID(pnt.id, pnt.vn);
+            existingPathStart = currRoute.size() - 2;
+            COLA_ASSERT(existingPathStart != 0);
+            const Point& pnt = currRoute.at(existingPathStart);
+            VertID vID(pnt.id, pnt.vn);
 
-                m_start_vert = m_router->vertices.getVertexByID(vID);
-            }
+            m_start_vert = m_router->vertices.getVertexByID(vID);
         }
     }
     //db_printf("GO\n");
@@ -1107,7 +1240,7 @@ void ConnRef::generateStandardPath(std::vector<Point>& path,
     bool found = false;
     while (!found)
     {
-        aStarPath(this, src(), dst(), start());
+        aStarPath(this, src(), dst(), start(), &m_search_expansions);
         found = tar->pathLeadsBackTo(m_src_vert);
         if (!found)
         {
@@ -1127,7 +1260,7 @@ void ConnRef::generateStandardPath(std::vector<Point>& path,
             m_start_vert = m_router->vertices.getVertexByID(vID);
             COLA_ASSERT(m_start_vert);
         }
-        else if (m_router->RubberBandRouting)
+        else
         {
             // found.
             bool unwind = false;
@@ -1169,51 +1302,20 @@ void ConnRef::generateStandardPath(std::vector<Point>& path,
         }
     }
 
-    
+
     unsigned int pathlen = tar->pathLeadsBackTo(m_src_vert);
     if (pathlen < 2)
     {
-        // There is no valid path.
-        db_printf("Warning: Path not found...\n");
-        m_needs_reroute_flag = true;
-        pathlen = 2;
-        tar->pathNext = m_src_vert;
-        if ((m_type == ConnType_PolyLine) && m_router->InvisibilityGrph)
-        {
-            // TODO:  Could we know this edge already?
-            //EdgeInf *edge = EdgeInf::existingEdge(m_src_vert, tar);
-            //COLA_ASSERT(edge != NULL);
-            //edge->addCycleBlocker();
-        }
+        return;
     }
-    path.resize(pathlen);
     vertices.resize(pathlen);
-
     unsigned int j = pathlen - 1;
     for (VertInf *i = tar; i != m_src_vert; i = i->pathNext)
     {
-        path[j] = i->point;
         vertices[j] = i;
-        if (i->id.isConnPt())
-        {
-            path[j].id = m_id;
-            path[j].vn = kUnassignedVertexNumber;
-        }
-        else
-        {
-            path[j].id = i->id.objID;
-            path[j].vn = i->id.vn;
-        }
-
         j--;
     }
     vertices[0] = m_src_vert;
-    path[0] = m_src_vert->point;
-    // Use topbit to differentiate between start and end point of connector.
-    // They need unique IDs for nudging.
-    unsigned int topbit = ((unsigned int) 1) << 31;
-    path[0].id = m_id | topbit; 
-    path[0].vn = kUnassignedVertexNumber;
 }
 
 
@@ -1266,13 +1368,19 @@ PointRepVector PtOrder::sortedPoints(const size_t dim)
 }
 
 
-int PtOrder::positionFor(const size_t dim, const ConnRef *conn)
+void PtOrder::sortIfRequired(const size_t dim)
 {
-    // Sort if not already sorted.
     if (sorted[dim] == false)
     {
         sort(dim);
     }
+}
+
+
+int PtOrder::positionFor(const size_t dim, const ConnRef *conn)
+{
+    // Sort if not already sorted.
+    sortIfRequired(dim);
 
     // Just return position from the sorted list.
     size_t i = 0;
@@ -369,10 +369,17 @@ class AVOID_EXPORT ConnRef
         void freeRoutes(void);
         void performCallback(void);
         bool generatePath(void);
+        bool needsPathGeneration(void) const;
+        bool hasIndependentPathSearch(void) const;
+        std::pair<bool, bool> beginPathGeneration(void);
+        void finishPathGeneration(const std::vector<Point>& path,
+                const std::vector<VertInf *>& vertices,
+                const std::pair<bool, bool>& isDummyAtEnd);
         void generateCheckpointsPath(std::vector<Point>& path,
                 std::vector<VertInf *>& vertices);
         void generateStandardPath(std::vector<Point>& path,
                 std::vector<VertInf *>& vertices);
+        void generateRubberBandPath(std::vector<VertInf *>& vertices);
         void unInitialise(void);
         void updateEndPoint(const unsigned int type, const ConnEnd& connEnd);
         void common_updateEndPoint(const unsigned int type, ConnEnd connEnd);
@@ -397,6 +404,11 @@ class AVOID_EXPORT ConnRef
         PolyLine m_route;
         Polygon m_display_route;
         double m_route_dist;
+        // The cost of the route found by the last path search.
+        double m_search_cost;
+        // The number of nodes expanded by path searches for this connector
+        // since the router last collected it for its telemetry.
+        unsigned long m_search_expansions;
         ConnRefList::iterator m_connrefs_pos;
         VertInf *m_src_vert;
         VertInf *m_dst_vert;
@@ -425,6 +437,9 @@ class PtOrder
         void addOrderedPoints(const size_t dim, const PtConnPtrPair& innerArg, 
                 const PtConnPtrPair& outerArg, bool swapped);
         int positionFor(const size_t dim, const ConnRef *conn);
+        // Sorts the order for dimension dim now rather than on the first 
+        // call to positionFor(), which then only reads the order.
+        void sortIfRequired(const size_t dim);
         PointRepVector sortedPoints(const size_t dim);
     private:
         size_t insertPoint(const size_t dim, const PtConnPtrPair& point);
@@ -172,6 +172,28 @@ bool ConnEnd::isPinConnection(void) const
     return (m_type == ConnEndShapePin) || (m_type == ConnEndJunction);
 }
 
+// Returns whether this ConnEnd may connect to an exclusive pin, in which
+// case the pin it gets depends on which connectors were routed before.
+bool ConnEnd::usesExclusivePins(void) const
+{
+    if (!isPinConnection() || !m_anchor_obj)
+    {
+        return false;
+    }
+    for (ShapeConnectionPinSet::const_iterator curr = 
+            m_anchor_obj->m_connection_pins.begin(); 
+            curr != m_anchor_obj->m_connection_pins.end(); ++curr)
+    {
+        ShapeConnectionPin *currPin = *curr;
+        if ((currPin->m_class_id == m_connection_pin_class_id) && 
+                currPin->m_exclusive)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 unsigned int ConnEnd::endpointType(void) const
 {
     COLA_ASSERT(m_conn_ref != NULL);
@@ -331,7 +353,7 @@ void ConnEnd::assignPinVisibilityTo(VertInf *dummyConnectionVert,
             {
                 // This has same ID and is either unconnected or not 
                 // exclusive, so give it visibility.
-                EdgeInf *edge = new EdgeInf(dummyConnectionVert,
+                EdgeInf *edge = new (router) EdgeInf(dummyConnectionVert,
                         currPin->m_vertex, true);
                 // XXX Can't use a zero cost due to assumptions 
                 //     elsewhere in code.
@@ -344,7 +366,7 @@ void ConnEnd::assignPinVisibilityTo(VertInf *dummyConnectionVert,
             {
                 // This has same ID and is either unconnected or not 
                 // exclusive, so give it visibility.
-                EdgeInf *edge = new EdgeInf(dummyConnectionVert,
+                EdgeInf *edge = new (router) EdgeInf(dummyConnectionVert,
                         currPin->m_vertex, false);
                 // XXX Can't use a zero cost due to assumptions 
                 //     elsewhere in code.
@@ -395,7 +417,7 @@ std::pair<bool, VertInf *> ConnEnd::getHyperedgeVertex(Router *router) const
     {
         VertID id(0, kUnassignedVertexNumber,
                 VertID::PROP_ConnPoint);
-        vertex = new VertInf(router, id, m_point);
+        vertex = new (router) VertInf(router, id, m_point);
         vertex->visDirections = m_directions;
         addedVertex = true;
 
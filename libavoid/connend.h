@@ -247,6 +247,7 @@ class AVOID_EXPORT ConnEnd
         void freeActivePin(void);
         unsigned int endpointType(void) const;
         bool isPinConnection(void) const;
+        bool usesExclusivePins(void) const;
         std::vector<Point> possiblePinPoints(void) const;
         void assignPinVisibilityTo(VertInf *dummyConnectionVert, 
                 VertInf *targetVert);
@@ -23,6 +23,7 @@
 */
 
 
+#include <algorithm>
 #include <cmath>
 
 #include "libavoid/debug.h"
@@ -48,7 +49,6 @@ EdgeInf::EdgeInf(VertInf *v1, VertInf *v2, const bool orthogonal)
       m_added(false),
       m_visible(false),
       m_orthogonal(orthogonal),
-      m_isHyperedgeSegment(false),
       m_disabled(false),
       m_vert1(v1),
       m_vert2(v2),
@@ -65,6 +65,26 @@ EdgeInf::EdgeInf(VertInf *v1, VertInf *v2, const bool orthogonal)
 }
 
 
+void *EdgeInf::operator new(size_t size, Router *router)
+{
+    return router->m_edge_pool.allocate(size);
+}
+
+
+void EdgeInf::operator delete(void *object, Router *router)
+{
+    // Only called if the constructor throws.
+    (void)(router);  // Avoid unused parameter warning.
+    BlockPool::deallocate(object);
+}
+
+
+void EdgeInf::operator delete(void *object)
+{
+    BlockPool::deallocate(object);
+}
+
+
 EdgeInf::~EdgeInf()
 {
     if (m_added)
@@ -132,7 +152,7 @@ static inline int orthogTurnOrder(const Point& a, const Point& b,
 // searching.  Forward, then left, then right.  Or if there is no previous 
 // point, then the order is north, east, south, then west.
 // Note: This method assumes the two Edges that share a common point.
-bool EdgeInf::rotationLessThan(const VertInf *lastV, const EdgeInf *rhs) const
+bool EdgeInf::rotationLessThan(const Point *lastPt, const EdgeInf *rhs) const
 {
     if ((m_vert1 == rhs->m_vert1) && (m_vert2 == rhs->m_vert2))
     {
@@ -173,10 +193,11 @@ bool EdgeInf::rotationLessThan(const VertInf *lastV, const EdgeInf *rhs) const
     const Point& commonPt = commonV->point;
     
     // If no lastPt, use one directly to the left;
-    Point lastPt = (lastV) ? lastV->point : Point(commonPt.x - 10,  commonPt.y);
+    Point lastPoint = (lastPt) ? *lastPt : 
+            Point(commonPt.x - 10,  commonPt.y);
 
-    int lhsVal = orthogTurnOrder(lastPt, commonPt, lhsPt);
-    int rhsVal = orthogTurnOrder(lastPt, commonPt, rhsPt);
+    int lhsVal = orthogTurnOrder(lastPoint, commonPt, lhsPt);
+    int rhsVal = orthogTurnOrder(lastPoint, commonPt, rhsPt);
 
     return lhsVal < rhsVal;
 }
@@ -189,6 +210,8 @@ void EdgeInf::makeActive(void)
     if (m_orthogonal)
     {
         COLA_ASSERT(m_visible);
+        m_router->visOrthogGraphSnapshot.invalidate(m_vert1);
+        m_router->visOrthogGraphSnapshot.invalidate(m_vert2);
         m_router->visOrthogGraph.addEdge(this);
         m_pos1 = m_vert1->orthogVisList.insert(m_vert1->orthogVisList.begin(), this);
         m_vert1->orthogVisListSize++;
@@ -225,6 +248,8 @@ void EdgeInf::makeInactive(void)
     if (m_orthogonal)
     {
         COLA_ASSERT(m_visible);
+        m_router->visOrthogGraphSnapshot.invalidate(m_vert1);
+        m_router->visOrthogGraphSnapshot.invalidate(m_vert2);
         m_router->visOrthogGraph.removeEdge(this);
         m_vert1->orthogVisList.erase(m_pos1);
         m_vert1->orthogVisListSize--;
@@ -270,6 +295,11 @@ void EdgeInf::setDist(double dist)
         m_visible = true;
         makeActive();
     }
+    if (m_orthogonal && (m_dist != dist))
+    {
+        m_router->visOrthogGraphSnapshot.invalidate(m_vert1);
+        m_router->visOrthogGraphSnapshot.invalidate(m_vert2);
+    }
     m_dist = dist;
     m_blocker = 0;
 }
@@ -285,11 +315,6 @@ double EdgeInf::mtstDist(void) const
     return m_mtst_dist;
 }
 
-bool EdgeInf::isHyperedgeSegment(void) const
-{
-    return m_isHyperedgeSegment;
-}
-
 bool EdgeInf::isDisabled(void) const
 {
     return m_disabled;
@@ -297,14 +322,14 @@ bool EdgeInf::isDisabled(void) const
 
 void EdgeInf::setDisabled(const bool disabled)
 {
+    if (m_orthogonal && m_added && (m_disabled != disabled))
+    {
+        m_router->visOrthogGraphSnapshot.invalidate(m_vert1);
+        m_router->visOrthogGraphSnapshot.invalidate(m_vert2);
+    }
     m_disabled = disabled;
 }
 
-void EdgeInf::setHyperedgeSegment(const bool hyperedge)
-{
-    m_isHyperedgeSegment = hyperedge;
-}
-
 bool EdgeInf::added(void)
 {
     return m_added;
@@ -596,14 +621,14 @@ EdgeInf *EdgeInf::checkEdgeVisibility(VertInf *i, VertInf *j, bool knownNew)
     if (knownNew)
     {
         COLA_ASSERT(existingEdge(i, j) == NULL);
-        edge = new EdgeInf(i, j);
+        edge = new (i->_router) EdgeInf(i, j);
     }
     else
     {
         edge = existingEdge(i, j);
         if (edge == NULL)
         {
-            edge = new EdgeInf(i, j);
+            edge = new (i->_router) EdgeInf(i, j);
         }
     }
     edge->checkVis();
@@ -776,6 +801,261 @@ EdgeInf *EdgeList::end(void)
 }
 
 
+VisNeighbour::VisNeighbour(EdgeInf *visEdge, const VertInf *from)
+    : edge(visEdge),
+      vert(visEdge->otherVert(from)),
+      point(vert->point),
+      dist(visEdge->getDist()),
+      isDummyConnection(visEdge->isDummyConnection()),
+      isDisabled(visEdge->isDisabled())
+{
+}
+
+
+const unsigned int OrthogonalVisGraphSnapshot::NOT_CONTAINED = 
+        (unsigned int) -1;
+
+
+OrthogonalVisGraphSnapshot::OrthogonalVisGraphSnapshot()
+    : m_active(false),
+      m_abandoned(0)
+{
+}
+
+
+void OrthogonalVisGraphSnapshot::build(Router *router)
+{
+    clear();
+    m_active = true;
+
+    for (VertInf *curr = router->vertices.connsBegin(); 
+            curr != router->vertices.end(); curr = curr->lstNext)
+    {
+        add(curr);
+    }
+}
+
+
+// Adds the stale vertices again, or builds the snapshot if it has not 
+// been built or they have left too many of its neighbours abandoned.
+void OrthogonalVisGraphSnapshot::refresh(Router *router)
+{
+    if (!m_active || (m_abandoned > (m_neighbours.size() / 2)))
+    {
+        build(router);
+        return;
+    }
+    for (std::set<VertInf *>::const_iterator curr = m_stale.begin();
+            curr != m_stale.end(); ++curr)
+    {
+        add(*curr);
+    }
+    m_stale.clear();
+}
+
+
+// Empties the snapshot and stops tracking changes until it is next built.
+// Indexes left in vertices are harmless, since contains() checks them.
+void OrthogonalVisGraphSnapshot::clear(void)
+{
+    m_active = false;
+    m_vertices.clear();
+    m_offsets.clear();
+    m_neighbours.clear();
+    for (int direction = 0; direction < ArrivalCount; ++direction)
+    {
+        m_orders[direction].clear();
+    }
+    m_abandoned = 0;
+    m_stale.clear();
+}
+
+
+// Appends vert, with its neighbours and their exploration orders.
+void OrthogonalVisGraphSnapshot::add(VertInf *vert)
+{
+    COLA_ASSERT(!contains(vert));
+    const size_t first = m_neighbours.size();
+    if (m_offsets.empty())
+    {
+        m_offsets.push_back(first);
+    }
+    vert->orthogVisSnapshotIndex = (unsigned int) m_vertices.size();
+    m_vertices.push_back(vert);
+    for (EdgeInfList::const_iterator edge = vert->orthogVisList.begin();
+            edge != vert->orthogVisList.end(); ++edge)
+    {
+        m_neighbours.push_back(VisNeighbour(*edge, vert));
+    }
+    const size_t count = m_neighbours.size() - first;
+    m_offsets.push_back(m_neighbours.size());
+
+    // The order depends on the previous point only through the direction
+    // it lies in, so each order is found with a point in that direction.
+    // Between orthogonal edges the comparison is by turn order alone, so 
+    // the stable sort is a pass for each turn value.  Dummy connection 
+    // edges are compared differently, so lists with them are sorted, 
+    // exactly as the search would sort.
+    bool allOrthogonal = true;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (!m_neighbours[first + i].edge->isOrthogonal())
+        {
+            allOrthogonal = false;
+            break;
+        }
+    }
+    const Point& p = vert->point;
+    const Point lastPts[ArrivalCount] = { Point(p.x - 10, p.y), 
+            Point(p.x + 10, p.y), Point(p.x, p.y - 10), 
+            Point(p.x, p.y + 10), Point(p.x - 10, p.y - 10) };
+    for (int direction = 0; direction < ArrivalCount; ++direction)
+    {
+        std::vector<unsigned int>& order = m_orders[direction];
+        if (allOrthogonal)
+        {
+            for (int turn = 0; turn <= 4; ++turn)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    if (orthogTurnOrder(lastPts[direction], p, 
+                            m_neighbours[first + i].point) == turn)
+                    {
+                        order.push_back((unsigned int) i);
+                    }
+                }
+            }
+            continue;
+        }
+
+        VisNeighbourList sorted(m_neighbours.begin() + first, 
+                m_neighbours.end());
+        std::stable_sort(sorted.begin(), sorted.end(), 
+                CmpVisEdgeRotation(&(lastPts[direction])));
+        for (size_t i = 0; i < count; ++i)
+        {
+            // Edges are unique within the list, so identify the position.
+            size_t position = 0;
+            while (m_neighbours[first + position].edge != sorted[i].edge)
+            {
+                ++position;
+            }
+            order.push_back((unsigned int) position);
+        }
+    }
+}
+
+
+// Leaves vert out of the snapshot until the next refresh(), since it or 
+// its edges have changed.
+void OrthogonalVisGraphSnapshot::invalidate(VertInf *vert)
+{
+    if (!m_active)
+    {
+        return;
+    }
+    if (contains(vert))
+    {
+        const size_t index = vert->orthogVisSnapshotIndex;
+        m_abandoned += m_offsets[index + 1] - m_offsets[index];
+        m_vertices[index] = NULL;
+        vert->orthogVisSnapshotIndex = NOT_CONTAINED;
+    }
+    m_stale.insert(vert);
+}
+
+
+// Forgets vert, which is being removed from the router.
+void OrthogonalVisGraphSnapshot::remove(VertInf *vert)
+{
+    if (!m_active)
+    {
+        return;
+    }
+    invalidate(vert);
+    m_stale.erase(vert);
+}
+
+
+size_t OrthogonalVisGraphSnapshot::vertexCount(void) const
+{
+    return m_vertices.size();
+}
+
+
+// Returns the vertex with the given index, or NULL if it is no longer 
+// contained.
+VertInf *OrthogonalVisGraphSnapshot::vertex(const size_t index) const
+{
+    COLA_ASSERT(index < m_vertices.size());
+    return m_vertices[index];
+}
+
+
+bool OrthogonalVisGraphSnapshot::contains(const VertInf *vert) const
+{
+    const size_t index = vert->orthogVisSnapshotIndex;
+    return (index < m_vertices.size()) && (m_vertices[index] == vert);
+}
+
+
+const VisNeighbour *OrthogonalVisGraphSnapshot::neighboursBegin(
+        const VertInf *vert) const
+{
+    COLA_ASSERT(contains(vert));
+    if (m_neighbours.empty())
+    {
+        return NULL;
+    }
+    return &(m_neighbours[0]) + m_offsets[vert->orthogVisSnapshotIndex];
+}
+
+
+const VisNeighbour *OrthogonalVisGraphSnapshot::neighboursEnd(
+        const VertInf *vert) const
+{
+    COLA_ASSERT(contains(vert));
+    if (m_neighbours.empty())
+    {
+        return NULL;
+    }
+    return &(m_neighbours[0]) + m_offsets[vert->orthogVisSnapshotIndex + 1];
+}
+
+
+const unsigned int *OrthogonalVisGraphSnapshot::explorationOrder(
+        const VertInf *vert, const VertInf *prev) const
+{
+    COLA_ASSERT(contains(vert));
+    int direction = ArrivalFromLeft;
+    if (prev)
+    {
+        const Point& a = prev->point;
+        const Point& b = vert->point;
+        if ((a.y == b.y) && (a.x != b.x))
+        {
+            direction = (a.x < b.x) ? ArrivalFromLeft : ArrivalFromRight;
+        }
+        else if ((a.x == b.x) && (a.y != b.y))
+        {
+            direction = (a.y < b.y) ? ArrivalFromBelow : ArrivalFromAbove;
+        }
+        else
+        {
+            // Diagonal or coincident points leave all orthogonal edges 
+            // unordered.
+            direction = ArrivalOther;
+        }
+    }
+    if (m_orders[direction].empty())
+    {
+        return NULL;
+    }
+    return &(m_orders[direction][0]) + 
+            m_offsets[vert->orthogVisSnapshotIndex];
+}
+
+
 }
 
 
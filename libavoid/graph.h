@@ -29,7 +29,9 @@
 
 #include <cassert>
 #include <list>
+#include <set>
 #include <utility>
+#include <vector>
 #include "libavoid/vertices.h"
 
 namespace Avoid {
@@ -48,6 +50,11 @@ class EdgeInf
     public:
         EdgeInf(VertInf *v1, VertInf *v2, const bool orthogonal = false);
         ~EdgeInf();
+        // Edges are allocated from the router's edge pool, and so are 
+        // created with "new (router) EdgeInf(...)".
+        static void *operator new(size_t size, Router *router);
+        static void operator delete(void *object, Router *router);
+        static void operator delete(void *object);
         inline double getDist(void)
         {
             return m_dist;
@@ -62,7 +69,7 @@ class EdgeInf
         bool isDummyConnection(void) const;
         bool isDisabled(void) const;
         void setDisabled(const bool disabled);
-        bool rotationLessThan(const VertInf* last, const EdgeInf *rhs) const;
+        bool rotationLessThan(const Point *lastPt, const EdgeInf *rhs) const;
         std::pair<VertID, VertID> ids(void) const;
         std::pair<Point, Point> points(void) const;
         void db_print(void);
@@ -73,8 +80,6 @@ class EdgeInf
         static EdgeInf *existingEdge(VertInf *i, VertInf *j);
         int blocker(void) const;
         
-        bool isHyperedgeSegment(void) const;
-        void setHyperedgeSegment(const bool hyperedge);
         double mtstDist(void) const;
         void setMtstDist(const double joinCost);
 
@@ -94,7 +99,6 @@ class EdgeInf
         bool m_added;
         bool m_visible;
         bool m_orthogonal;
-        bool m_isHyperedgeSegment;
         bool m_disabled;
         VertInf *m_vert1;
         VertInf *m_vert2;
@@ -127,6 +131,116 @@ class EdgeList
 };
 
 
+// A visibility graph edge, as seen from one of its vertices, along with 
+// the edge properties and the position of the other vertex read by the 
+// path search.
+class VisNeighbour
+{
+    public:
+        VisNeighbour(EdgeInf *visEdge, const VertInf *from);
+
+        EdgeInf *edge;
+        VertInf *vert;
+        Point point;
+        double dist;
+        bool isDummyConnection;
+        bool isDisabled;
+};
+typedef std::vector<VisNeighbour> VisNeighbourList;
+
+
+// Orders the edges out of a vertex in the order the orthogonal path search
+// explores them, given the point it arrived from, or NULL at the start.
+class CmpVisEdgeRotation 
+{
+    public:
+        CmpVisEdgeRotation(const Point *lastPt)
+            : _lastPt(lastPt)
+        {
+        }
+        bool operator() (const VisNeighbour& u, const VisNeighbour& v) const 
+        {
+            // Dummy ShapeConnectionPin edges are not orthogonal and 
+            // therefore can't be compared in the same way.
+            if (u.edge->isOrthogonal() && v.edge->isOrthogonal())
+            {
+                return u.edge->rotationLessThan(_lastPt, v.edge);
+            }
+            return u.edge < v.edge;
+        }
+    private:
+        const Point *_lastPt;
+};
+
+
+// A compressed-sparse-row copy of the orthogonal visibility graph.  The 
+// neighbours of each vertex are stored contiguously, in the order of its
+// orthogVisList, along with the orders in which the orthogonal path 
+// search explores them for each direction it may arrive from, so that 
+// searches need not follow or sort the edge lists.
+//
+// The snapshot is built when the static orthogonal visibility graph is 
+// generated, and kept while the graph changes around it: a vertex that
+// is added, or whose edges, position or edge properties change, is 
+// marked as stale and left out until refresh() adds it again.  Searches 
+// use the edge lists for vertices the snapshot does not contain.  It is
+// refreshed before the concurrent path searches in 
+// Router::generatePaths() and MTST constructions in 
+// HyperedgeRerouter::performRerouting(), which then contain every vertex.
+class OrthogonalVisGraphSnapshot
+{
+    public:
+        // The directions a search may arrive at a vertex from, each with
+        // its own exploration order.  The search start, with no previous
+        // vertex, explores as if arriving from the left.
+        enum Arrival 
+        {
+            ArrivalFromLeft = 0,
+            ArrivalFromRight,
+            ArrivalFromBelow,
+            ArrivalFromAbove,
+            ArrivalOther,
+            ArrivalCount
+        };
+
+        OrthogonalVisGraphSnapshot();
+        void build(Router *router);
+        void refresh(Router *router);
+        void clear(void);
+        void invalidate(VertInf *vert);
+        void remove(VertInf *vert);
+        size_t vertexCount(void) const;
+        VertInf *vertex(const size_t index) const;
+        bool contains(const VertInf *vert) const;
+        const VisNeighbour *neighboursBegin(const VertInf *vert) const;
+        const VisNeighbour *neighboursEnd(const VertInf *vert) const;
+        // The positions in neighboursBegin(vert) of its neighbours, in 
+        // the order they are explored when arriving from prev.
+        const unsigned int *explorationOrder(const VertInf *vert, 
+                const VertInf *prev) const;
+
+        static const unsigned int NOT_CONTAINED;
+    private:
+        void add(VertInf *vert);
+
+        bool m_active;
+        std::vector<VertInf *> m_vertices;
+        // The neighbours of the vertex with index i are at positions 
+        // m_offsets[i] to m_offsets[i + 1] - 1 of m_neighbours, and its 
+        // exploration order for an arrival direction at the same 
+        // positions of m_orders[direction].
+        std::vector<size_t> m_offsets;
+        std::vector<VisNeighbour> m_neighbours;
+        std::vector<unsigned int> m_orders[ArrivalCount];
+        // Neighbours of vertices that have since been removed or become
+        // stale.
+        size_t m_abandoned;
+        // Vertices that are not contained, since they were added or 
+        // became stale, and must be added again by refresh().
+        std::set<VertInf *> m_stale;
+};
+
+
 }
 
 
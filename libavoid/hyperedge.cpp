@@ -22,6 +22,11 @@
  * Author(s):   Michael Wybrow <mjwybrow@users.sourceforge.net>
 */
 
+#include <vector>
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
 #include "libavoid/hyperedge.h"
 #include "libavoid/hyperedgetree.h"
 #include "libavoid/mtst.h"
@@ -31,6 +36,7 @@
 #include "libavoid/connend.h"
 #include "libavoid/shape.h"
 #include "libavoid/router.h"
+#include "libavoid/timer.h"
 #include "libavoid/assertions.h"
 
 
@@ -408,26 +414,79 @@ void HyperedgeRerouter::performRerouting(void)
     fprintf(fp, "</g>\n");
 #endif
     
-    // For each hyperedge...
-    const size_t num_hyperedges = count();
-    for (size_t i = 0; i < num_hyperedges; ++i)
+    // For each hyperedge, execute the MTST method to find good junction
+    // positions and an initial path.  A hyperedge tree will be build for 
+    // the new route.  The constructions only read the visibility graph, 
+    // through its snapshot, so they are run in parallel, each thread 
+    // reusing its own scratch storage for the search.
+    const int num_hyperedges = (int) count();
+    std::vector<MinimumTerminalSpanningTree *> mtsts(num_hyperedges);
+    std::vector<JunctionHyperEdgeTreeNodeMap> hyperEdgeTreeJunctions(
+            num_hyperedges);
+    m_router->timers.Register(tmHyperedgeAlt, timerStart);
+    if (num_hyperedges > 0)
+    {
+        // Bring the snapshot used by the path searches up to date with
+        // the vertices added for the terminals.
+        m_router->visOrthogGraphSnapshot.refresh(m_router);
+    }
+
+    // The connectors being replaced are deleted as each hyperedge is 
+    // rerouted, so the constructions ignore the vertices at their ends, 
+    // other than as terminals, rather than route through connection pins
+    // via the old connectors of other hyperedges.
+    VertexList oldConnectorVertices;
+    for (int i = 0; i < num_hyperedges; ++i)
+    {
+        for (ConnRefList::iterator curr = 
+                m_deleted_connectors_vector[i].begin();
+                curr != m_deleted_connectors_vector[i].end(); ++curr)
+        {
+            oldConnectorVertices.push_back((*curr)->m_src_vert);
+            oldConnectorVertices.push_back((*curr)->m_dst_vert);
+        }
+    }
+
+    int workers = 1;
+#if defined(_OPENMP) && !defined(HYPEREDGE_DEBUG)
+    workers = (m_router->workerCount() > 0) ? 
+            (int) m_router->workerCount() : omp_get_num_procs();
+#endif
+    std::vector<MTSTScratch> scratch(workers);
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic) num_threads(workers) \
+            if((workers > 1) && (num_hyperedges > 1))
+#endif
+    for (int i = 0; i < num_hyperedges; ++i)
     {
-        // Execute the MTST method to find good junction positions and an
-        // initial path.  A hyperedge tree will be build for the new route.
-        JunctionHyperEdgeTreeNodeMap hyperEdgeTreeJunctions;
-        MinimumTerminalSpanningTree mtst(m_router, 
-                m_terminal_vertices_vector[i], &hyperEdgeTreeJunctions);
+#ifdef _OPENMP
+        MTSTScratch *threadScratch = &(scratch[omp_get_thread_num()]);
+#else
+        MTSTScratch *threadScratch = &(scratch[0]);
+#endif
+        mtsts[i] = new MinimumTerminalSpanningTree(m_router, 
+                m_terminal_vertices_vector[i], &(hyperEdgeTreeJunctions[i]),
+                threadScratch);
+        mtsts[i]->setIgnoredVertices(&oldConnectorVertices);
 #ifdef HYPEREDGE_DEBUG
-        mtst.setDebuggingOutput(fp, i);
+        mtsts[i]->setDebuggingOutput(fp, i);
 #endif
         // The older MTST construction method (faster, worse results).
-        //mtst.constructSequential();
+        // It modifies the graph, so cannot be run in parallel.
+        //mtsts[i]->constructSequential();
         
         // The preferred MTST construction method.
         // Slightly slower, better quality results.
-        mtst.constructInterleaved();
+        mtsts[i]->constructInterleaved();
+    }
+    m_router->timers.Stop();
 
-        HyperEdgeTreeNode *treeRoot = mtst.rootJunction();
+    for (int i = 0; i < num_hyperedges; ++i)
+    {
+        MinimumTerminalSpanningTree *mtst = mtsts[i];
+        mtst->createJunctions();
+
+        HyperEdgeTreeNode *treeRoot = mtst->rootJunction();
         COLA_ASSERT(treeRoot);
         
         // Fill in connector information and join them to junctions of endpoints
@@ -463,6 +522,8 @@ void HyperedgeRerouter::performRerouting(void)
         {
             m_router->deleteJunction(*curr);
         }
+
+        delete mtst;
     }
 
     // Clear the input to this class, so that new objects can be registered
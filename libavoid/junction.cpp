@@ -80,6 +80,12 @@ Rectangle JunctionRef::makeRectangle(Router *router, const Point& position)
 
 void JunctionRef::setPositionFixed(bool fixed)
 {
+    if (fixed != m_position_fixed)
+    {
+        // Only fixed junctions are obstacles in the orthogonal 
+        // visibility graph.
+        m_router->setStaticGraphInvalidated(true);
+    }
     m_position_fixed = fixed;
 }
 
@@ -16,11 +16,13 @@ SOURCES += connector.cpp geometry.cpp geomtypes.cpp graph.cpp makepath.cpp ortho
     hyperedge.cpp \
     hyperedgetree.cpp \
     actioninfo.cpp \
-    scanline.cpp
+    scanline.cpp \
+    pool.cpp
 HEADERS += assertions.h connector.h debug.h geometry.h geomtypes.h graph.h libavoid.h makepath.h orthogonal.h router.h shape.h timer.h vertices.h viscluster.h visibility.h vpsc.h connend.h connectionpin.h junction.h obstacle.h \
     mtst.h \
     hyperedge.h \
     hyperedgetree.h \
     actioninfo.h \
     scanline.h \
+    pool.h \
     dllexport.h
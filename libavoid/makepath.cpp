@@ -29,6 +29,8 @@
 
 #include <algorithm>
 #include <vector>
+#include <list>
+#include <map>
 #include <climits>
 
 #include "libavoid/vertices.h"
@@ -37,6 +39,7 @@
 #include "libavoid/viscluster.h"
 #include "libavoid/graph.h"
 #include "libavoid/router.h"
+#include "libavoid/makepath.h"
 #include "libavoid/debug.h"
 #include "libavoid/assertions.h"
 
@@ -105,6 +108,144 @@ bool operator<(const ANode &a, const ANode &b)
 }
 
 
+// An ANode is identified by its vertex and the vertex it was reached from.
+// The search keeps at most one ANode for each of these pairs.
+typedef std::pair<VertInf *, VertInf *> ANodeKey;
+
+static ANodeKey aNodeKey(const ANode& node, const std::vector<ANode>& done)
+{
+    VertInf *prevInf = (node.prevIndex >= 0) ? done[node.prevIndex].inf : NULL;
+    return std::make_pair(node.inf, prevInf);
+}
+
+
+// The PENDING set for the A* search.  This is a binary heap with the 
+// lowest cost ANode at its head.  It records the heap position of each 
+// node, so that a node can be looked up by its key and be replaced in 
+// place when a cheaper path to it is found, rather than searching the
+// whole set and then rebuilding the heap.
+//
+class PendingANodes
+{
+    public:
+        bool empty(void) const
+        {
+            return heap.empty();
+        }
+        // Removes and returns the node with the lowest f value.
+        ANode pop(void)
+        {
+            COLA_ASSERT(!heap.empty());
+            const size_t headId = heap.front();
+            indexes.erase(keys[headId]);
+            heapPositions[headId] = NOT_PENDING;
+            const size_t lastId = heap.back();
+            heap.pop_back();
+            if (!heap.empty())
+            {
+                heap[0] = lastId;
+                heapPositions[lastId] = 0;
+                siftDown(0);
+            }
+            return nodes[headId];
+        }
+        void push(const ANodeKey& key, const ANode& node)
+        {
+            COLA_ASSERT(find(key) == NOT_PENDING);
+            const size_t id = nodes.size();
+            nodes.push_back(node);
+            keys.push_back(key);
+            heapPositions.push_back(heap.size());
+            heap.push_back(id);
+            indexes[key] = id;
+            siftUp(heap.size() - 1);
+        }
+        // Returns the identifier of the pending node with the given key,
+        // or NOT_PENDING if there is none.
+        size_t find(const ANodeKey& key) const
+        {
+            std::map<ANodeKey, size_t>::const_iterator found = 
+                    indexes.find(key);
+            if (found == indexes.end())
+            {
+                return NOT_PENDING;
+            }
+            return found->second;
+        }
+        const ANode& at(const size_t id) const
+        {
+            return nodes[id];
+        }
+        // Replaces a pending node with one for the same key.
+        void replace(const size_t id, const ANode& node)
+        {
+            COLA_ASSERT(heapPositions[id] != NOT_PENDING);
+            nodes[id] = node;
+            siftUp(heapPositions[id]);
+            siftDown(heapPositions[id]);
+        }
+
+        static const size_t NOT_PENDING = (size_t) -1;
+
+    private:
+        // Since the ANode operator< is reversed, a node is placed above
+        // those it is not less than.
+        bool above(const size_t id1, const size_t id2) const
+        {
+            return nodes[id2] < nodes[id1];
+        }
+        void moveTo(const size_t pos, const size_t id)
+        {
+            heap[pos] = id;
+            heapPositions[id] = pos;
+        }
+        void siftUp(size_t pos)
+        {
+            const size_t id = heap[pos];
+            while (pos > 0)
+            {
+                const size_t parent = (pos - 1) / 2;
+                if (!above(id, heap[parent]))
+                {
+                    break;
+                }
+                moveTo(pos, heap[parent]);
+                pos = parent;
+            }
+            moveTo(pos, id);
+        }
+        void siftDown(size_t pos)
+        {
+            const size_t id = heap[pos];
+            const size_t size = heap.size();
+            while ((2 * pos + 1) < size)
+            {
+                size_t child = 2 * pos + 1;
+                if (((child + 1) < size) && above(heap[child + 1], heap[child]))
+                {
+                    ++child;
+                }
+                if (!above(heap[child], id))
+                {
+                    break;
+                }
+                moveTo(pos, heap[child]);
+                pos = child;
+            }
+            moveTo(pos, id);
+        }
+
+        // Every node pushed, by identifier.
+        std::vector<ANode> nodes;
+        std::vector<ANodeKey> keys;
+        std::vector<size_t> heapPositions;
+        // The identifiers of the pending nodes, in heap order.
+        std::vector<size_t> heap;
+        // The identifiers of the pending nodes, by key.
+        std::map<ANodeKey, size_t> indexes;
+};
+
+
 static double Dot(const Point& l, const Point& r)
 {
     return (l.x * r.x) + (l.y * r.y);
@@ -136,23 +277,25 @@ static double angleBetween(const Point& p1, const Point& p2, const Point& p3)
 
 
 // Construct a temporary Polygon path given several VertInf's for a connector.
+// The path follows the ANodes back from inf1Index and ends at inf2.  It 
+// doesn't depend on the point after inf2, so it is the same for every 
+// segment considered from inf2.
 //
 static void constructPolygonPath(Polygon& connRoute, VertInf *inf2, 
-        VertInf *inf3, std::vector<ANode>& done, int inf1Index)
+        std::vector<ANode>& done, int inf1Index)
 {
     // Don't include colinear points.
     bool simplified = true;
 
-    int routeSize = 2;
+    int routeSize = 1;
     for (int curr = inf1Index; curr >= 0; curr = done[curr].prevIndex)
     {
         routeSize += 1;
     }
     connRoute.ps.resize(routeSize);
     int arraySize = routeSize;
-    connRoute.ps[routeSize - 1] = inf3->point;
-    connRoute.ps[routeSize - 2] = inf2->point;
-    routeSize -= 3;
+    connRoute.ps[routeSize - 1] = inf2->point;
+    routeSize -= 2;
     for (int curr = inf1Index; curr >= 0; curr = done[curr].prevIndex)
     {
         if (!simplified)
@@ -198,13 +341,32 @@ static void constructPolygonPath(Polygon& connRoute, VertInf *inf2,
 }
 
 
+// Construct the path for a connector with the segment inf2--inf3 added.
+// The path to inf2 is kept in inf2Route, so it is only constructed once 
+// for all the segments considered from inf2.
+//
+static void constructPolygonPath(Polygon& connRoute, Polygon& inf2Route,
+        VertInf *inf2, VertInf *inf3, std::vector<ANode>& done, 
+        int inf1Index)
+{
+    if (inf2Route.empty())
+    {
+        constructPolygonPath(inf2Route, inf2, done, inf1Index);
+    }
+    connRoute = inf2Route;
+    connRoute.ps.push_back(inf3->point);
+}
+
+
 // Given the two points for a new segment of a path (inf2 & inf3)
 // as well as the distance between these points (dist), as well as
 // possibly the previous point (inf1) [from inf1--inf2], return a
-// cost associated with this route.
+// cost associated with this route.  inf2Route caches the path to inf2
+// between calls for the same inf2, and should be empty initially.
 //
 static double cost(ConnRef *lineRef, const double dist, VertInf *inf2, 
-        VertInf *inf3, std::vector<ANode>& done, int inf1Index)
+        VertInf *inf3, std::vector<ANode>& done, int inf1Index, 
+        Polygon& inf2Route)
 {
     VertInf *inf1 = (inf1Index >= 0) ?  done[inf1Index].inf : NULL;
     double result = dist;
@@ -260,7 +422,8 @@ static double cost(ConnRef *lineRef, const double dist, VertInf *inf2,
     {
         if (connRoute.empty())
         {
-            constructPolygonPath(connRoute, inf2, inf3, done, inf1Index);
+            constructPolygonPath(connRoute, inf2Route, inf2, inf3, done, 
+                    inf1Index);
         }
         // There are clusters so do cluster routing.
         for (ClusterRefList::const_iterator cl = router->clusterRefs.begin(); 
@@ -306,7 +469,8 @@ static double cost(ConnRef *lineRef, const double dist, VertInf *inf2,
     {
         if (connRoute.empty())
         {
-            constructPolygonPath(connRoute, inf2, inf3, done, inf1Index);
+            constructPolygonPath(connRoute, inf2Route, inf2, inf3, done, 
+                    inf1Index);
         }
         ConnRefList::const_iterator curr, finish = router->connRefs.end();
         for (curr = router->connRefs.begin(); curr != finish; ++curr)
@@ -394,28 +558,6 @@ static double estimatedCost(ConnRef *lineRef, const Point *last,
 }
 
 
-class CmpVisEdgeRotation 
-{
-    public:
-        CmpVisEdgeRotation(const VertInf* lastPt)
-            : _lastPt(lastPt)
-        {
-        }
-        bool operator() (const EdgeInf* u, const EdgeInf* v) const 
-        {
-            // Dummy ShapeConnectionPin edges are not orthogonal and 
-            // therefore can't be compared in the same way.
-            if (u->isOrthogonal() && v->isOrthogonal())
-            {
-                return u->rotationLessThan(_lastPt, v);
-            }
-            return u < v;
-        }
-    private:
-        const VertInf *_lastPt;
-};
-
-
 static inline bool pointAlignedWithOneOf(const Point& point, 
         const std::vector<Point>& points, const size_t dim)
 {
@@ -430,17 +572,58 @@ static inline bool pointAlignedWithOneOf(const Point& point,
 }
 
 
+// Each ANode is for a vertex and the vertex before it, so the chain of
+// ANodes back from tar may pass through the same vertex more than once.
+// This cuts out the loop between the first and last visits to each 
+// vertex, leaving the path that following pathNext links written back 
+// along the chain from tar would give, since the write from the first 
+// visit is the one that remains.
+static void removeRevisits(std::vector<VertInf *>& path)
+{
+    if (path.size() < 3)
+    {
+        return;
+    }
+
+    // The first position of each vertex, other than the start of the path.
+    typedef std::map<VertInf *, size_t> FirstPositionMap;
+    FirstPositionMap first;
+    for (size_t i = path.size() - 1; i > 0; --i)
+    {
+        first[path[i]] = i;
+    }
+    if (first.size() == path.size() - 1)
+    {
+        // No vertex is visited twice.
+        return;
+    }
+
+    std::vector<VertInf *> result;
+    size_t i = path.size() - 1;
+    result.push_back(path[i]);
+    while (i > 0)
+    {
+        i = first[path[i]] - 1;
+        result.push_back(path[i]);
+    }
+    std::reverse(result.begin(), result.end());
+    path.swap(result);
+}
+
+
 // Returns the best path from src to tar using the cost function.
 //
 // The path is worked out using the aStar algorithm, and is encoded via
 // prevIndex values for each ANode which point back to the previous ANode's
 // position in the DONE vector.  At completion, this order is written into
-// the pathNext links in each of the VerInfs along the path.
+// path, from the first ANode in DONE through to tar.
 //
 // The aStar STL code is based on public domain code available on the
 // internet.
 //
-void aStarPath(ConnRef *lineRef, VertInf *src, VertInf *tar, VertInf *start)
+void aStarSearch(ConnRef *lineRef, VertInf *src, VertInf *tar, 
+        VertInf *start, std::vector<VertInf *>& path, double *pathCost,
+        unsigned long *expansions)
 {
     bool isOrthogonal = (lineRef->routingType() == ConnType_Orthogonal);
 
@@ -457,12 +640,25 @@ void aStarPath(ConnRef *lineRef, VertInf *src, VertInf *tar, VertInf *start)
     }
     endPoints.push_back(tar->point);
     
-    std::vector<ANode> PENDING;     // STL Vectors chosen because of rapid
-    std::vector<ANode> DONE;        // insertions/deletions at back,
+    PendingANodes PENDING;
+    std::vector<ANode> DONE;        // STL Vector chosen because of rapid
+                                    // insertions at back.
     size_t DONE_size = 0;
     ANode Node, BestNode;           // Temporary Node and BestNode
     bool bNodeFound = false;        // Flag if node is found in container
     int timestamp = 1;
+    // The positions in DONE of the ANodes, by key.  Rather than search the
+    // complete DONE list, which may get very large in the worst case, we 
+    // look up the ANode for the vertex and previous vertex.
+    typedef std::map<ANodeKey, unsigned int> DoneIndexMap;
+    DoneIndexMap doneIndexes;
+    // The path to the node being expanded, shared by the cost() calls for
+    // each of its edges.
+    Polygon bestNodeRoute;
+    // The edges out of the node being expanded, in exploration order.
+    VisNeighbourList neighbours;
+
+    path.clear();
 
     if (start == NULL)
     {
@@ -470,6 +666,10 @@ void aStarPath(ConnRef *lineRef, VertInf *src, VertInf *tar, VertInf *start)
     }
 
     Router *router = lineRef->router();
+    // Concurrent searches read the orthogonal visibility graph through its
+    // snapshot, when one has been built.
+    const OrthogonalVisGraphSnapshot& snapshot = 
+            router->visOrthogGraphSnapshot;
     if (router->RubberBandRouting && (start != src))
     {
         COLA_ASSERT(router->IgnoreRegions == true);
@@ -501,8 +701,9 @@ void aStarPath(ConnRef *lineRef, VertInf *src, VertInf *tar, VertInf *start)
             {
                 double edgeDist = dist(BestNode.inf->point, curr->point);
 
+                bestNodeRoute.clear();
                 Node.g = BestNode.g + cost(lineRef, edgeDist, BestNode.inf, 
-                        Node.inf, DONE, BestNode.prevIndex);
+                        Node.inf, DONE, BestNode.prevIndex, bestNodeRoute);
 
                 // Calculate the Heuristic.
                 Node.h = estimatedCost(lineRef, &(BestNode.inf->point),
@@ -520,12 +721,13 @@ void aStarPath(ConnRef *lineRef, VertInf *src, VertInf *tar, VertInf *start)
                 BestNode = Node;
 
                 DONE.push_back(BestNode);
-                BestNode.inf->aStarDoneIndexes.push_back(DONE_size);
+                doneIndexes.insert(
+                        std::make_pair(aNodeKey(BestNode, DONE), DONE_size));
                 DONE_size++;
             }
             else
             {
-                PENDING.push_back(Node);
+                PENDING.push(aNodeKey(Node, DONE), Node);
             }
 
             rIndx++;
@@ -555,35 +757,24 @@ void aStarPath(ConnRef *lineRef, VertInf *src, VertInf *tar, VertInf *start)
         // Set a null parent, so cost function knows this is the first segment.
 
         // Populate the PENDING container with the first location
-        PENDING.push_back(Node);
+        PENDING.push(aNodeKey(Node, DONE), Node);
     }
 
-    tar->pathNext = NULL;
-
-    // Create a heap from PENDING for sorting
-    using std::make_heap; using std::push_heap; using std::pop_heap;
-    make_heap( PENDING.begin(), PENDING.end() );
-
     // Continue until the queue is empty.
+    unsigned long expanded = 0;
     while (!PENDING.empty())
     {
-        // Set the Node with lowest f value to BESTNODE.
-        // Since the ANode operator< is reversed, the head of the
-        // heap is the node with the lowest f value.
-        BestNode = PENDING.front();
-
-        // Pop off the heap.  Actually this moves the
-        // far left value to the far right.  The node
-        // is not actually removed since the pop is to
-        // the heap and not the container.
-        pop_heap(PENDING.begin(), PENDING.end());
-        // Remove node from right (the value we pop_heap'd)
-        PENDING.pop_back();
+        // Set the Node with lowest f value to BESTNODE, removing it
+        // from the heap.
+        BestNode = PENDING.pop();
+        ++expanded;
 
         // Push the BestNode onto DONE
         DONE.push_back(BestNode);
-        BestNode.inf->aStarDoneIndexes.push_back(DONE_size);
+        doneIndexes.insert(
+                std::make_pair(aNodeKey(BestNode, DONE), DONE_size));
         DONE_size++;
+        bestNodeRoute.clear();
 
         VertInf *prevInf = (BestNode.prevIndex >= 0) ?
                 DONE[BestNode.prevIndex].inf : NULL;
@@ -608,43 +799,74 @@ void aStarPath(ConnRef *lineRef, VertInf *src, VertInf *tar, VertInf *start)
                     (int) DONE_size, BestNode.f);
 #endif
             
-            // Correct all the pathNext pointers.
+            // Follow the ANodes back to give the path.
             ANode curr;
             for (curr = BestNode; curr.prevIndex > 0; 
                     curr = DONE[curr.prevIndex])
             {
-                curr.inf->pathNext = DONE[curr.prevIndex].inf;
+                path.push_back(curr.inf);
             }
             // Check that we've gone through the complete path.
             COLA_ASSERT(curr.prevIndex == 0);
-            // Fill in the final pathNext pointer.
-            curr.inf->pathNext = DONE[curr.prevIndex].inf;
+            path.push_back(curr.inf);
+            path.push_back(DONE[curr.prevIndex].inf);
+            std::reverse(path.begin(), path.end());
+            removeRevisits(path);
+            if (pathCost)
+            {
+                *pathCost = BestNode.g;
+            }
 
             // Exit from the search
             break;
         }
 
         // Check adjacent points in graph and add them to the queue.
-        EdgeInfList& visList = (!isOrthogonal) ?
-                BestNode.inf->visList : BestNode.inf->orthogVisList;
-        if (isOrthogonal)
+        // Orthogonal searches explore them in a structured way, in an 
+        // order the snapshot holds for each direction of arrival.  For 
+        // vertices it does not contain, a sorted copy of the list is 
+        // used, since other searches may be reading the list.
+        const VisNeighbour *neighbourList = NULL;
+        const unsigned int *order = NULL;
+        size_t neighbourCount = 0;
+        if (isOrthogonal && snapshot.contains(BestNode.inf))
+        {
+            neighbourList = snapshot.neighboursBegin(BestNode.inf);
+            neighbourCount = snapshot.neighboursEnd(BestNode.inf) - 
+                    neighbourList;
+            order = snapshot.explorationOrder(BestNode.inf, prevInf);
+        }
+        else
         {
-            // We would like to explore in a structured way, 
-            // so sort the points in the visList...
-            CmpVisEdgeRotation compare(prevInf);
-            visList.sort(compare);
+            const EdgeInfList& visList = (!isOrthogonal) ?
+                    BestNode.inf->visList : BestNode.inf->orthogVisList;
+            neighbours.clear();
+            for (EdgeInfList::const_iterator edge = visList.begin(); 
+                    edge != visList.end(); ++edge)
+            {
+                neighbours.push_back(VisNeighbour(*edge, BestNode.inf));
+            }
+            if (isOrthogonal)
+            {
+                CmpVisEdgeRotation compare(
+                        (prevInf) ? &(prevInf->point) : NULL);
+                std::stable_sort(neighbours.begin(), neighbours.end(), 
+                        compare);
+            }
+            neighbourList = (neighbours.empty()) ? NULL : &(neighbours[0]);
+            neighbourCount = neighbours.size();
         }
-        EdgeInfList::const_iterator finish = visList.end();
-        for (EdgeInfList::const_iterator edge = visList.begin(); 
-                edge != finish; ++edge)
+        for (size_t n = 0; n < neighbourCount; ++n)
         {
-            if ((*edge)->isDisabled())
+            const VisNeighbour *neighbour = 
+                    neighbourList + ((order) ? order[n] : n);
+            if (neighbour->isDisabled)
             {
                 // Skip disabled edges.
                 continue;
             }
 
-            Node = ANode((*edge)->otherVert(BestNode.inf), timestamp++);
+            Node = ANode(neighbour->vert, timestamp++);
 
             // Set the index to the previous ANode that we reached
             // this ANode through (the last BestNode pushed onto DONE).
@@ -684,7 +906,7 @@ void aStarPath(ConnRef *lineRef, VertInf *src, VertInf *tar, VertInf *start)
                 }
             }
 
-            if (isOrthogonal && !(*edge)->isDummyConnection())
+            if (isOrthogonal && !neighbour->isDummyConnection)
             {
                 // Orthogonal routing optimisation.
                 // Skip the edges that don't lead to shape edges, or the 
@@ -694,8 +916,8 @@ void aStarPath(ConnRef *lineRef, VertInf *src, VertInf *tar, VertInf *start)
                 // Also, don't check if the previous point was a dummy for a
                 // connection pin and this happens to be placed diagonally 
                 // from here, i.e., when both of notInline{X,Y} are true.
-                Point& bestPt = BestNode.inf->point;
-                Point& nextPt = Node.inf->point;
+                const Point& bestPt = BestNode.inf->point;
+                const Point& nextPt = neighbour->point;
 
                 bool notInlineX = prevInf && (prevInf->point.x != bestPt.x);
                 bool notInlineY = prevInf && (prevInf->point.y != bestPt.y);
@@ -741,7 +963,7 @@ void aStarPath(ConnRef *lineRef, VertInf *src, VertInf *tar, VertInf *start)
                 }
             }
 
-            double edgeDist = (*edge)->getDist();
+            double edgeDist = neighbour->dist;
 
             if (edgeDist == 0)
             {
@@ -760,11 +982,11 @@ void aStarPath(ConnRef *lineRef, VertInf *src, VertInf *tar, VertInf *start)
             }
 
             Node.g = BestNode.g + cost(lineRef, edgeDist, BestNode.inf, 
-                    Node.inf, DONE, BestNode.prevIndex);
+                    Node.inf, DONE, BestNode.prevIndex, bestNodeRoute);
 
             // Calculate the Heuristic.
             Node.h = estimatedCost(lineRef, &(BestNode.inf->point),
-                    Node.inf->point, tar->point);
+                    neighbour->point, tar->point);
 
             // The A* formula
             Node.f = Node.g + Node.h;
@@ -776,90 +998,62 @@ void aStarPath(ConnRef *lineRef, VertInf *src, VertInf *tar, VertInf *start)
             db_printf(" - g: %3.1f h: %3.1f \n", Node.g, Node.h);
 #endif
 
+            // The ANode this was reached from is the last BestNode.
+            const ANodeKey key(Node.inf, BestNode.inf);
             bNodeFound = false;
 
             // Check to see if already on PENDING
-            size_t PENDING_size = PENDING.size();
-            for (unsigned int i = 0; i < PENDING_size; i++)
+            const size_t pendingId = PENDING.find(key);
+            if (pendingId != PendingANodes::NOT_PENDING)
             {
-                ANode& ati = PENDING[i];
-                if ((Node.inf == ati.inf) &&
-                        (DONE[Node.prevIndex].inf == DONE[ati.prevIndex].inf))
+                // If already on PENDING
+                if (Node.g < PENDING.at(pendingId).g)
                 {
-                    // If already on PENDING
-                    if (Node.g < ati.g)
-                    {
-                        PENDING[i] = Node;
-
-                        make_heap( PENDING.begin(), PENDING.end() );
-                    }
-                    bNodeFound = true;
-                    break;
+                    PENDING.replace(pendingId, Node);
                 }
+                bNodeFound = true;
             }
-            if ( !bNodeFound ) // If Node NOT found on PENDING
+            else
             {
                 // Check to see if already on DONE.
-                // Rather than iterate through the complete DONE list, which
-                // may get very large in the worst case, we look at just the
-                // ANodes for this vertex.  This is cheaper for us even than
-                // using a hash map for DONE, especially since a good hash 
-                // function on the unique combination of vertex and previous 
-                // vertex is very difficult.
-                for (std::list<unsigned int>::const_iterator currInd = 
-                        Node.inf->aStarDoneIndexes.begin();
-                        currInd != Node.inf->aStarDoneIndexes.end(); ++currInd)
+                DoneIndexMap::const_iterator nodeDone = doneIndexes.find(key);
+                if (nodeDone != doneIndexes.end())
                 {
-                    ANode& ati = DONE[*currInd];
-                    if ((Node.inf == ati.inf) && 
-                            (DONE[Node.prevIndex].inf == DONE[ati.prevIndex].inf))
-                    {
-                        COLA_ASSERT(Node.g >= (ati.g - 10e-10));
-                        // This node is already in DONE, and the current 
-                        // node also has a higher g-value, so we don't
-                        // need to consider this node.
-                        bNodeFound = true;
-                        break;
-                    }
+                    COLA_ASSERT(Node.g >= (DONE[nodeDone->second].g - 10e-10));
+                    // This node is already in DONE, and the current 
+                    // node also has a higher g-value, so we don't
+                    // need to consider this node.
+                    bNodeFound = true;
                 }
             }
 
             if (!bNodeFound ) // If Node NOT found on PENDING or DONE
             {
                 // Push NewNode onto PENDING
-                PENDING.push_back(Node);
-                // Push NewNode onto heap
-                push_heap( PENDING.begin(), PENDING.end() );
-
-#if 0
-                using std::cout; using std::endl;
-                // Display PENDING and DONE containers (For Debugging)
-                cout << "PENDING:   ";
-                for (unsigned int i = 0; i < PENDING.size(); i++)
-                {
-                    cout << PENDING[i].g << "," << PENDING[i].h << ",";
-                    cout << PENDING[i].inf << "," << PENDING[i].pp << "  ";
-                }
-                cout << endl;
-                cout << "DONE:   ";
-                for (unsigned int i = 0; i < DONE_size; i++)
-                {
-                    cout << DONE[i].g << "," << DONE[i].h << ",";
-                    cout << DONE[i].inf << "," << DONE[i].pp << "  ";
-                }
-                cout << endl << endl;
-#endif
+                PENDING.push(key, Node);
             }
         }
     }
 
-    // Cleanup lists used to store positions in DONE list for ANodes at each
-    // vertex.
-    VertInf *endVert = router->vertices.end();
-    for (VertInf *k = router->vertices.connsBegin(); k != endVert;
-            k = k->lstNext)
+    if (expansions)
+    {
+        *expansions += expanded;
+    }
+}
+
+
+void aStarPath(ConnRef *lineRef, VertInf *src, VertInf *tar, VertInf *start,
+        unsigned long *expansions)
+{
+    tar->pathNext = NULL;
+
+    std::vector<VertInf *> path;
+    aStarSearch(lineRef, src, tar, start, path, NULL, expansions);
+
+    // Write the path into the pathNext pointers, working back from tar.
+    for (size_t i = path.size(); i > 1; --i)
     {
-        k->aStarDoneIndexes.clear();
+        path[i - 1]->pathNext = path[i - 2];
     }
 }
 
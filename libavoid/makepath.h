@@ -26,13 +26,30 @@
 #ifndef AVOID_MAKEPATH_H
 #define AVOID_MAKEPATH_H
 
+#include <vector>
+#include <cstddef>
+
 
 namespace Avoid {
 
 class ConnRef;
-
+class VertInf;
+
+// Finds the best path for lineRef from src to tar and returns the vertices
+// along it, ending with tar, in path.  The path is left empty if there is
+// none.  If pathCost is given, the cost of the path is stored there.
+// If expansions is given, the number of nodes expanded is added to it.
+// The search keeps all its state locally and only reads the visibility 
+// graph, so searches for several connectors may be run at the same time 
+// as long as nothing modifies the graph meanwhile.
+extern void aStarSearch(ConnRef *lineRef, VertInf *src, VertInf *tar,
+        VertInf *start, std::vector<VertInf *>& path, 
+        double *pathCost = NULL, unsigned long *expansions = NULL);
+
+// As aStarSearch(), but the path is instead encoded in the pathNext links
+// of the vertices along it.
 extern void aStarPath(ConnRef *lineRef, VertInf *src, VertInf *tar,
-        VertInf *start);
+        VertInf *start, unsigned long *expansions = NULL);
 
 }
 
@@ -61,6 +61,84 @@ bool CmpEdgeInf::operator()(const EdgeInf *a, const EdgeInf *b) const
 }
 
 
+// Comparison for the vertex heap in the interleaved construction.
+bool HeapCmpMTSTVertex::operator()(const MTSTVertex *a, 
+        const MTSTVertex *b) const
+{
+    return a->sptfDist > b->sptfDist;
+}
+
+
+// Ordering for sets of MTSTVertex records.
+bool CmpMTSTVertex::operator()(const MTSTVertex *a, 
+        const MTSTVertex *b) const
+{
+    if (a->vert != b->vert)
+    {
+        return a->vert < b->vert;
+    }
+    return a->isPartner < b->isPartner;
+}
+
+
+// Comparison for the bridging edge heap in the interleaved construction.
+bool CmpMTSTBridgingEdge::operator()(const MTSTBridgingEdge& a, 
+        const MTSTBridgingEdge& b) const
+{
+    return *(a.mtstDist) > *(b.mtstDist);
+}
+
+
+void MTSTScratch::reset(Router *router)
+{
+    const OrthogonalVisGraphSnapshot& snapshot = 
+            router->visOrthogGraphSnapshot;
+    const size_t vertexCount = snapshot.vertexCount();
+
+    // The vertex and its orthogonal partner are adjacent.
+    m_vertices.resize(2 * vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+        MTSTVertex *vert = &(m_vertices[2 * i]);
+        MTSTVertex *partner = vert + 1;
+
+        vert->vert = snapshot.vertex(i);
+        vert->partner = partner;
+        vert->pathNext = NULL;
+        vert->treeRoot = NULL;
+        vert->treeNode = NULL;
+        vert->sptfDist = DBL_MAX;
+        vert->partnerEdgeDist = 0;
+        vert->partnerEdgeMtstDist = 0;
+        vert->isPartner = false;
+        vert->hasPartner = false;
+        vert->isIgnored = false;
+
+        *partner = *vert;
+        partner->partner = vert;
+        partner->isPartner = true;
+        partner->hasPartner = true;
+    }
+    m_edge_mtst_dists.clear();
+    vHeap.clear();
+    beHeap.clear();
+}
+
+
+MTSTVertex *MTSTScratch::vertex(const VertInf *vert)
+{
+    COLA_ASSERT(2 * vert->orthogVisSnapshotIndex < m_vertices.size());
+    COLA_ASSERT(m_vertices[2 * vert->orthogVisSnapshotIndex].vert == vert);
+    return &(m_vertices[2 * vert->orthogVisSnapshotIndex]);
+}
+
+
+double *MTSTScratch::edgeMtstDist(EdgeInf *edge)
+{
+    return &(m_edge_mtst_dists[edge]);
+}
+
+
 struct delete_vertex
 {
     void operator()(VertInf *ptr)
@@ -72,18 +150,25 @@ struct delete_vertex
 
 
 MinimumTerminalSpanningTree::MinimumTerminalSpanningTree(Router *router,
-        std::set<VertInf *> terminals, JunctionHyperEdgeTreeNodeMap *hyperEdgeTreeJunctions)
+        std::set<VertInf *> terminals, JunctionHyperEdgeTreeNodeMap *hyperEdgeTreeJunctions,
+        MTSTScratch *scratch)
     : router(router),
       isOrthogonal(true),
       terminals(terminals),
       hyperEdgeTreeJunctions(hyperEdgeTreeJunctions),
       m_rootJunction(NULL),
       bendPenalty(2000),
+      ignoredVertices(NULL),
       debug_fp(NULL),
       debug_count(0),
+      scratch(scratch),
+      ownsScratch(scratch == NULL),
       dimensionChangeVertexID(0, 42)
 {
-
+    if (ownsScratch)
+    {
+        this->scratch = new MTSTScratch();
+    }
 }
 
 MinimumTerminalSpanningTree::~MinimumTerminalSpanningTree()
@@ -92,6 +177,11 @@ MinimumTerminalSpanningTree::~MinimumTerminalSpanningTree()
     m_rootJunction->deleteEdgesExcept(NULL);
     delete m_rootJunction;
     m_rootJunction = NULL;
+
+    if (ownsScratch)
+    {
+        delete scratch;
+    }
 }
 
 
@@ -103,6 +193,13 @@ void MinimumTerminalSpanningTree::setDebuggingOutput(FILE *fp,
 }
 
 
+void MinimumTerminalSpanningTree::setIgnoredVertices(
+        const std::list<VertInf *> *vertices)
+{
+    ignoredVertices = vertices;
+}
+
+
 HyperEdgeTreeNode *MinimumTerminalSpanningTree::rootJunction(void) const
 {
     return m_rootJunction;
@@ -183,7 +280,7 @@ HyperEdgeTreeNode *MinimumTerminalSpanningTree::addNode(VertInf *vertex,
 }
 
 void MinimumTerminalSpanningTree::buildHyperEdgeTreeToRoot(VertInf *currVert,
-        HyperEdgeTreeNode *prevNode, VertInf *prevVert, bool markEdges)
+        HyperEdgeTreeNode *prevNode)
 {
     COLA_ASSERT(currVert != NULL);
 
@@ -194,29 +291,108 @@ void MinimumTerminalSpanningTree::buildHyperEdgeTreeToRoot(VertInf *currVert,
         // Add the node, if necessary.
         HyperEdgeTreeNode *addedNode = addNode(currVert, prevNode);
 
-        if (markEdges)
+        if (debug_fp)
+        {
+            fprintf(debug_fp, "<path id=\"%s-%u\" d=\"M %g %g L %g %g\" "
+                    "class=\"hyperedge\" style=\"stroke: %s;\" />\n", 
+                    debug_label, step_count,
+                    currVert->point.x, currVert->point.y,
+                    prevNode->point.x, prevNode->point.y, "blue");
+            ++step_count;
+        }
+        
+        if (addedNode == NULL)
+        {
+            // We've reached a junction, so stop.
+            break;
+        }
+
+        if (currVert->pathNext == NULL)
         {
-            //COLA_ASSERT( !(currVert->id == dimensionChangeVertexID) );
-            //COLA_ASSERT( !(prevVert->id == dimensionChangeVertexID) );
-            EdgeInf *edge = prevVert->hasNeighbour(currVert, isOrthogonal);
-            if (edge == NULL && (currVert->id == dimensionChangeVertexID))
+            // This is a terminal of the hyperedge, mark the node with the 
+            // vertex representing the endpoint of the connector so we can
+            // later use this to set the correct ConnEnd for the connector.
+            addedNode->finalVertex = currVert;
+        }
+        prevNode = addedNode;
+        currVert = currVert->pathNext;
+    }
+}
+
+
+HyperEdgeTreeNode *MinimumTerminalSpanningTree::addNode(MTSTVertex *vertex, 
+        HyperEdgeTreeNode *prevNode)
+{
+    // Do we already have a node for this vertex?
+    if (vertex->treeNode == NULL)
+    {
+        // Not found.  Create new node.
+        HyperEdgeTreeNode *newNode = new HyperEdgeTreeNode();
+        newNode->point = vertex->vert->point;
+        // Remember it.
+        vertex->treeNode = newNode;
+        // Join it to the previous node.
+        new HyperEdgeTreeEdge(prevNode, newNode, NULL);
+
+        return newNode;
+    }
+    else
+    {
+        // Found.
+        HyperEdgeTreeNode *junctionNode = vertex->treeNode;
+        if (std::find(m_junction_nodes.begin(), m_junction_nodes.end(),
+                    junctionNode) == m_junction_nodes.end())
+        {
+            // This needs a junction, if it isn't already marked as one.
+            // They are created later, by createJunctions().
+            m_junction_nodes.push_back(junctionNode);
+            if (m_rootJunction == NULL)
             {
-                VertInf *modCurr = (currVert->id == dimensionChangeVertexID) ? 
-                        currVert->m_orthogonalPartner : currVert;
-                VertInf *modPrev = (prevVert->id == dimensionChangeVertexID) ? 
-                        prevVert->m_orthogonalPartner : prevVert;
-                edge = modPrev->hasNeighbour(modCurr, isOrthogonal);
+                // Remember the first junction node, so we can use it to 
+                // traverse the tree, added and connecting connectors to 
+                // junctions and endpoints.
+                m_rootJunction = junctionNode;
             }
-            COLA_ASSERT(edge);
-            edge->setHyperedgeSegment(true);
         }
+        // Joint to junction
+        new HyperEdgeTreeEdge(prevNode, junctionNode, NULL);
+
+        return NULL;
+    }
+}
+
+
+void MinimumTerminalSpanningTree::createJunctions(void)
+{
+    for (size_t i = 0; i < m_junction_nodes.size(); ++i)
+    {
+        HyperEdgeTreeNode *junctionNode = m_junction_nodes[i];
+        junctionNode->junction = new JunctionRef(router, junctionNode->point);
+        router->removeObjectFromQueuedActions(junctionNode->junction);
+        junctionNode->junction->makeActive();
+    }
+    m_junction_nodes.clear();
+}
+
+
+void MinimumTerminalSpanningTree::buildHyperEdgeTreeToRoot(
+        MTSTVertex *currVert, HyperEdgeTreeNode *prevNode)
+{
+    COLA_ASSERT(currVert != NULL);
+
+    // This method follows branches in a shortest path tree back to the
+    // root, generating hyperedge tree nodes and branches as it goes.
+    while (currVert)
+    {
+        // Add the node, if necessary.
+        HyperEdgeTreeNode *addedNode = addNode(currVert, prevNode);
 
         if (debug_fp)
         {
             fprintf(debug_fp, "<path id=\"%s-%u\" d=\"M %g %g L %g %g\" "
                     "class=\"hyperedge\" style=\"stroke: %s;\" />\n", 
                     debug_label, step_count,
-                    currVert->point.x, currVert->point.y,
+                    currVert->vert->point.x, currVert->vert->point.y,
                     prevNode->point.x, prevNode->point.y, "blue");
             ++step_count;
         }
@@ -232,16 +408,16 @@ void MinimumTerminalSpanningTree::buildHyperEdgeTreeToRoot(VertInf *currVert,
             // This is a terminal of the hyperedge, mark the node with the 
             // vertex representing the endpoint of the connector so we can
             // later use this to set the correct ConnEnd for the connector.
-            addedNode->finalVertex = currVert;
+            addedNode->finalVertex = currVert->vert;
         }
         prevNode = addedNode;
-        prevVert = currVert;
         currVert = currVert->pathNext;
     }
 }
 
 
-VertInf **MinimumTerminalSpanningTree::resetDistsForPath(VertInf *currVert, VertInf **newRootVertPtr)
+MTSTVertex **MinimumTerminalSpanningTree::resetDistsForPath(
+        MTSTVertex *currVert, MTSTVertex **newRootVertPtr)
 {
     COLA_ASSERT(currVert != NULL);
 
@@ -251,16 +427,16 @@ VertInf **MinimumTerminalSpanningTree::resetDistsForPath(VertInf *currVert, Vert
     {
         if (currVert->sptfDist == 0)
         {
-            VertInf **oldTreeRootPtr = currVert->treeRootPointer();
+            MTSTVertex **oldTreeRootPtr = currVert->treeRoot;
             // We've reached a junction, so stop.
             rewriteRestOfHyperedge(currVert, newRootVertPtr);
             return oldTreeRootPtr;
         }
 
         currVert->sptfDist = 0;
-        currVert->setTreeRootPointer(newRootVertPtr);
+        currVert->treeRoot = newRootVertPtr;
 
-        terminals.insert(currVert);
+        searchTerminals.insert(currVert);
 
         currVert = currVert->pathNext;
     }
@@ -381,7 +557,7 @@ void MinimumTerminalSpanningTree::constructSequential(void)
                 if ( ! extraVertex )
                 {
                     // Create the dummy node if necessary.
-                    extraVertex = new VertInf(router, dimensionChangeVertexID,
+                    extraVertex = new (router) VertInf(router, dimensionChangeVertexID,
                            u->point, false);
                     extraVertices.push_back(extraVertex);
                     extraVertex->sptfDist = bendPenalty + u->sptfDist;
@@ -392,7 +568,7 @@ void MinimumTerminalSpanningTree::constructSequential(void)
                 }
                 // Add a copy of the ignored edge to the dummy node, so it
                 // may be explored later.
-                EdgeInf *extraEdge = new EdgeInf(extraVertex, v, isOrthogonal);
+                EdgeInf *extraEdge = new (router) EdgeInf(extraVertex, v, isOrthogonal);
                 extraEdge->setDist(edgeDist);                
                 continue;
             }
@@ -511,8 +687,8 @@ void MinimumTerminalSpanningTree::constructSequential(void)
                         e->m_vert2->point.x, e->m_vert2->point.y, "red");
                 ++step_count;
             }
-            buildHyperEdgeTreeToRoot(e->m_vert1->pathNext, node1, e->m_vert1);
-            buildHyperEdgeTreeToRoot(e->m_vert2->pathNext, node2, e->m_vert2);
+            buildHyperEdgeTreeToRoot(e->m_vert1->pathNext, node1);
+            buildHyperEdgeTreeToRoot(e->m_vert2->pathNext, node2);
         }
     }
     if (debug_fp)
@@ -529,36 +705,46 @@ void MinimumTerminalSpanningTree::constructSequential(void)
     router->timers.Stop();
 }
 
-VertInf *MinimumTerminalSpanningTree::orthogonalPartner(VertInf *vert, 
+MTSTVertex *MinimumTerminalSpanningTree::orthogonalPartner(MTSTVertex *vert, 
         double penalty)
 {
     if (penalty == 0)
     {
         penalty = bendPenalty;
     }
-    if (vert->m_orthogonalPartner == NULL)
+    if (vert->hasPartner == false)
     {
-        vert->m_orthogonalPartner = new VertInf(router, 
-                dimensionChangeVertexID, vert->point, false);
-        vert->m_orthogonalPartner->m_orthogonalPartner = vert;
-        extraVertices.push_back(vert->m_orthogonalPartner);
-        EdgeInf *extraEdge = new EdgeInf(vert->m_orthogonalPartner, vert,
-                isOrthogonal);
-        extraEdge->setDist(penalty);
+        vert->hasPartner = true;
+        vert->partnerEdgeDist = penalty;
     }
-    return vert->m_orthogonalPartner;
+    return vert->partner;
+}
+
+MTSTVertex **MinimumTerminalSpanningTree::makeTreeRootPointer(
+        MTSTVertex *vert, MTSTVertex *root)
+{
+    rootVertexPointers.push_back(root);
+    vert->treeRoot = &(rootVertexPointers.back());
+    return vert->treeRoot;
+}
+
+static inline MTSTVertex *treeRootOf(const MTSTVertex *vert)
+{
+    return (vert->treeRoot) ? *(vert->treeRoot) : NULL;
 }
 
 void MinimumTerminalSpanningTree::popInvalidBridgingEdges()
 {
+    std::vector<MTSTBridgingEdge>& beHeap = scratch->beHeap;
     while (!beHeap.empty())
     {
         // Take the lowest cost bridging edge.
-        EdgeInf *e = beHeap.front();
+        const MTSTBridgingEdge& e = beHeap.front();
 
-        VertexPair ends = realVerticesCountingPartners(e);
-        if ((ends.first->treeRoot() != ends.second->treeRoot()) &&
-                ends.first->treeRoot() && ends.second->treeRoot())
+        std::pair<MTSTVertex *, MTSTVertex *> ends = 
+                realVerticesCountingPartners(e);
+        if ((treeRootOf(ends.first) != treeRootOf(ends.second)) &&
+                treeRootOf(ends.first) && treeRootOf(ends.second))
         {
             // We have a real bridging edge on top, so carry on with the
             // search.
@@ -572,56 +758,78 @@ void MinimumTerminalSpanningTree::popInvalidBridgingEdges()
     }
 }
 
-LayeredOrthogonalEdgeList MinimumTerminalSpanningTree::
-        getOrthogonalEdgesFromVertex(VertInf *vert, VertInf *prev)
+MTSTEdgeList MinimumTerminalSpanningTree::getOrthogonalEdgesFromVertex(
+        MTSTVertex *vert, MTSTVertex *prev)
 {
-    LayeredOrthogonalEdgeList edgeList;
+    MTSTEdgeList edgeList;
 
     COLA_ASSERT(vert);
     
     double penalty = (prev == NULL) ? 0.1 : 0;
     orthogonalPartner(vert, penalty);
 
-    bool isRealVert = (vert->id != dimensionChangeVertexID);
-    VertInf *realVert = (isRealVert) ? vert : orthogonalPartner(vert);
-    COLA_ASSERT(realVert->id != dimensionChangeVertexID);
-    EdgeInfList& visList = (!isOrthogonal) ? realVert->visList : realVert->orthogVisList;
-    EdgeInfList::const_iterator finish = visList.end();
-    for (EdgeInfList::const_iterator edge = visList.begin(); edge != finish; ++edge)
+    bool isRealVert = !vert->isPartner;
+    MTSTVertex *realVert = (isRealVert) ? vert : orthogonalPartner(vert);
+    COLA_ASSERT(!realVert->isPartner);
+
+    // The edge joining the vertex to its orthogonal partner is considered
+    // first, as it is at the front of the vertex's visibility list.
+    MTSTBridgingEdge partnerEdge;
+    partnerEdge.vert1 = realVert->partner;
+    partnerEdge.vert2 = realVert;
+    partnerEdge.edge = NULL;
+    partnerEdge.dist = realVert->partnerEdgeDist;
+    partnerEdge.mtstDist = &(realVert->partnerEdgeMtstDist);
+    MTSTVertex *partnerEnd = (isRealVert) ? realVert->partner : realVert;
+    if (partnerEnd != prev)
     {
-        VertInf *other = (*edge)->otherVert(realVert);
-        
-        if (other == orthogonalPartner(realVert))
+        edgeList.push_back(std::make_pair(partnerEdge, partnerEnd));
+    }
+
+    const OrthogonalVisGraphSnapshot& snapshot = 
+            router->visOrthogGraphSnapshot;
+    const VisNeighbour *finish = snapshot.neighboursEnd(realVert->vert);
+    for (const VisNeighbour *neighbour = 
+            snapshot.neighboursBegin(realVert->vert); neighbour != finish;
+            ++neighbour)
+    {
+        EdgeInf *visEdge = neighbour->edge;
+        MTSTVertex *other = scratch->vertex(neighbour->vert);
+        if (other->isIgnored)
         {
-            VertInf *partner = (isRealVert) ? other : orthogonalPartner(other);
-            if (partner != prev)
-            {
-                edgeList.push_back(std::make_pair(*edge, partner));
-            }
             continue;
         }
         
-        VertInf *partner = (isRealVert) ? other : orthogonalPartner(other);
+        MTSTBridgingEdge edge;
+        edge.vert1 = scratch->vertex(visEdge->m_vert1);
+        edge.vert2 = scratch->vertex(visEdge->m_vert2);
+        edge.edge = visEdge;
+        edge.dist = neighbour->dist;
+        edge.mtstDist = NULL;
+        
+        MTSTVertex *partner = (isRealVert) ? other : orthogonalPartner(other);
         COLA_ASSERT(partner);
         
-        if (other->point.y == realVert->point.y)
+        const Point& otherPoint = other->vert->point;
+        const Point& realPoint = realVert->vert->point;
+        if (otherPoint.y == realPoint.y)
         {
             if (isRealVert && (prev != partner))
             {
-                edgeList.push_back(std::make_pair(*edge, partner));
+                edgeList.push_back(std::make_pair(edge, partner));
             }
         }
-        else if (other->point.x == realVert->point.x)
+        else if (otherPoint.x == realPoint.x)
         {
             if (!isRealVert && (prev != partner))
             {
-                edgeList.push_back(std::make_pair(*edge, partner));
+                edgeList.push_back(std::make_pair(edge, partner));
             }
         }
         else
         {
             printf("Warning, nonorthogonal edge.\n");
-            edgeList.push_back(std::make_pair(*edge, other));
+            edgeList.push_back(std::make_pair(edge, other));
         }
     }
         
@@ -634,38 +842,43 @@ void MinimumTerminalSpanningTree::constructInterleaved(void)
     // Perform an interleaved construction of the MTST and SPTF
     // ========================================================
     //
-    router->timers.Register(tmHyperedgeAlt, timerStart);
     strcpy(debug_label, "int");
 
-    origTerminals = terminals;
-
     // Initialisation
     //
-    VertInf *endVert = router->vertices.end();
-    for (VertInf *k = router->vertices.connsBegin(); k != endVert;
-            k = k->lstNext)
-    {
-        k->sptfDist = DBL_MAX;
-        k->pathNext = NULL;
-        k->setTreeRootPointer(NULL);
-        k->m_orthogonalPartner = NULL;
-    }
+    scratch->reset(router);
+    std::vector<MTSTVertex *>& vHeap = scratch->vHeap;
+    std::vector<MTSTBridgingEdge>& beHeap = scratch->beHeap;
 
     COLA_ASSERT(rootVertexPointers.empty());
     for (std::set<VertInf *>::iterator ti = terminals.begin();
             ti != terminals.end(); ++ti)
     {
-        VertInf *t = *ti;
+        searchTerminals.insert(scratch->vertex(*ti));
+    }
+    origTerminals = searchTerminals;
+    if (ignoredVertices)
+    {
+        for (std::list<VertInf *>::const_iterator vi = 
+                ignoredVertices->begin(); vi != ignoredVertices->end(); ++vi)
+        {
+            MTSTVertex *vert = scratch->vertex(*vi);
+            if (searchTerminals.find(vert) == searchTerminals.end())
+            {
+                vert->isIgnored = true;
+                vert->partner->isIgnored = true;
+            }
+        }
+    }
+    for (MTSTVertexSet::iterator ti = searchTerminals.begin();
+            ti != searchTerminals.end(); ++ti)
+    {
+        MTSTVertex *t = *ti;
         // This is a terminal, set a distance of zero.
         t->sptfDist = 0;
-        rootVertexPointers.push_back(t->makeTreeRootPointer(t));
+        makeTreeRootPointer(t, t);
         vHeap.push_back(t);
     }
-    for (EdgeInf *t = router->visOrthogGraph.begin();
-            t != router->visOrthogGraph.end(); t = t->lstNext)
-    {
-        t->setHyperedgeSegment(false);
-    }
 
     std::make_heap(vHeap.begin(), vHeap.end(), vHeapCompare);
     
@@ -686,13 +899,13 @@ void MinimumTerminalSpanningTree::constructInterleaved(void)
     while ( ! vHeap.empty() )
     {
         // Take the lowest vertex from heap.
-        VertInf *u = vHeap.front();
+        MTSTVertex *u = vHeap.front();
 
         // Pop the lowest vertex off the heap.
         std::pop_heap(vHeap.begin(), vHeap.end(), vHeapCompare);
         vHeap.pop_back();
      
-        if ((u->treeRoot() == NULL))
+        if (treeRootOf(u) == NULL)
         {
             // This is an orphaned vertex.
             continue;
@@ -701,18 +914,22 @@ void MinimumTerminalSpanningTree::constructInterleaved(void)
 
         popInvalidBridgingEdges();
 
-        if (!beHeap.empty() && u->sptfDist >= (0.5 * beHeap.front()->mtstDist()))
+        if (!beHeap.empty() && 
+                u->sptfDist >= (0.5 * *(beHeap.front().mtstDist)))
         {
             // Take the lowest cost edge.
-            EdgeInf *e = beHeap.front();
+            MTSTBridgingEdge e = beHeap.front();
 
             // Pop the lowest cost edge off of the heap.
             std::pop_heap(beHeap.begin(), beHeap.end(), beHeapCompare);
             beHeap.pop_back();
 
-            VertexPair ends = realVerticesCountingPartners(e);
-            if (origTerminals.find(ends.first->treeRoot()) == origTerminals.end() ||
-                origTerminals.find(ends.second->treeRoot()) == origTerminals.end() )
+            std::pair<MTSTVertex *, MTSTVertex *> ends = 
+                    realVerticesCountingPartners(e);
+            if (origTerminals.find(treeRootOf(ends.first)) == 
+                        origTerminals.end() ||
+                origTerminals.find(treeRootOf(ends.second)) == 
+                        origTerminals.end() )
             {
                 continue;
             }
@@ -730,25 +947,26 @@ void MinimumTerminalSpanningTree::constructInterleaved(void)
         }
 
         // For each edge from this vertex...
-        LayeredOrthogonalEdgeList edgeList = getOrthogonalEdgesFromVertex(u,
-                u->pathNext);
-        for (LayeredOrthogonalEdgeList::const_iterator edge = edgeList.begin(); 
+        MTSTEdgeList edgeList = getOrthogonalEdgesFromVertex(u, u->pathNext);
+        for (MTSTEdgeList::iterator edge = edgeList.begin(); 
                 edge != edgeList.end(); ++edge)
         {
-            VertInf *v = edge->second;
-            EdgeInf *e = edge->first;
-            double edgeDist = e->getDist();
+            MTSTVertex *v = edge->second;
+            MTSTBridgingEdge& e = edge->first;
+            double edgeDist = e.dist;
 
             // Assign a distance (length) of 1 for dummy visibility edges
             // which may not accurately reflect the real distance of the edge.
-            if (v->id.isDummyPinHelper() || u->id.isDummyPinHelper())
+            // Orthogonal partners are never dummy pin helpers.
+            if ((!v->isPartner && v->vert->id.isDummyPinHelper()) || 
+                    (!u->isPartner && u->vert->id.isDummyPinHelper()))
             {
                 edgeDist = 1;
             }
 
             // Don't do anything more here if this is an intra-tree edge that
             // would just bridge branches of the same tree.
-            if (u->treeRoot() == v->treeRoot())
+            if (treeRootOf(u) == treeRootOf(v))
             {
                 continue;
             }
@@ -762,9 +980,9 @@ void MinimumTerminalSpanningTree::constructInterleaved(void)
             // at the current position and give the edge an distance equal to
             // the bend penalty.  We add equivalent edges for the right-angled
             // original edges, so these may be explored when the algorithm
-            // explores the dummy node.  Obviously we also need to clean up
-            // these dummy nodes and edges later.
-            if (v->treeRoot() == NULL)
+            // explores the dummy node.  In this version, the dummy nodes are
+            // the orthogonal partners of the search vertices.
+            if (treeRootOf(v) == NULL)
             {
                 double newCost = (u->sptfDist + edgeDist);
             
@@ -774,7 +992,7 @@ void MinimumTerminalSpanningTree::constructInterleaved(void)
                 // to the heap of potentials to explore.
                 v->sptfDist = newCost;
                 v->pathNext = u;
-                v->setTreeRootPointer(u->treeRootPointer());
+                v->treeRoot = u->treeRoot;
                 vHeap.push_back(v);
                 std::push_heap(vHeap.begin(), vHeap.end(), vHeapCompare);
 
@@ -782,8 +1000,8 @@ void MinimumTerminalSpanningTree::constructInterleaved(void)
                 {
                     fprintf(debug_fp, "<path id=\"frst-%u\" class=\"forest\" "
                             "d=\"M %g %g L %g %g\" />\n", step_count,
-                            v->point.x, v->point.y, u->point.x,
-                            u->point.y);
+                            v->vert->point.x, v->vert->point.y, 
+                            u->vert->point.x, u->vert->point.y);
                     ++step_count;
                 }
             }
@@ -793,8 +1011,12 @@ void MinimumTerminalSpanningTree::constructInterleaved(void)
                 // a different tree.  Set the MTST distance for the bridging
                 // edge and push it to the priority queue of edges to consider
                 // during the extended Kruskal's algorithm.
-                double cost = v->sptfDist + u->sptfDist + e->getDist();
-                e->setMtstDist(cost);
+                double cost = v->sptfDist + u->sptfDist + e.dist;
+                if (e.mtstDist == NULL)
+                {
+                    e.mtstDist = scratch->edgeMtstDist(e.edge);
+                }
+                *(e.mtstDist) = cost;
                 beHeap.push_back(e);
                 std::push_heap(beHeap.begin(), beHeap.end(), beHeapCompare);
             }
@@ -807,19 +1029,11 @@ void MinimumTerminalSpanningTree::constructInterleaved(void)
         //printf("-- %d %d %d\n", (int) origTerminals.size(), 
         //        (int) vHeap.size(), (int) beHeap.size());
     }
-    router->timers.Stop();
 
     // Free Root Vertex Points from all vertices.
-    for (std::list<VertInf **>::iterator curr = rootVertexPointers.begin();
-            curr != rootVertexPointers.end(); ++curr)
-    {
-        delete *curr;
-    }
     rootVertexPointers.clear();
-
-    // Free the dummy nodes and edges created earlier.
-    for_each(extraVertices.begin(), extraVertices.end(), delete_vertex());
-    extraVertices.clear();
+    searchTerminals.clear();
+    origTerminals.clear();
 }
 
 bool MinimumTerminalSpanningTree::connectsWithoutBend(VertInf *oldLeaf,
@@ -829,37 +1043,9 @@ bool MinimumTerminalSpanningTree::connectsWithoutBend(VertInf *oldLeaf,
 
     if (oldLeaf->sptfDist == 0)
     {
-        bool hyperedgeConnection = false;
-        EdgeInfList& visList = (!isOrthogonal) ? 
-                oldLeaf->visList : oldLeaf->orthogVisList;
-        EdgeInfList::const_iterator finish = visList.end();
-        for (EdgeInfList::const_iterator edge = visList.begin();
-                edge != finish; ++edge)
-        {
-            VertInf *other = (*edge)->otherVert(oldLeaf);
-
-            if (other == newLeaf)
-            {
-                continue;
-            }
-         
-            if (other->point == oldLeaf->point)
-            {
-                continue;
-            }
-
-            if ((*edge)->isHyperedgeSegment())
-            {
-                hyperedgeConnection = true;
-                if (colinear(other->point, oldLeaf->point, newLeaf->point))
-                {
-                    return true;
-                }
-            }
-        }
-        // If there was no hyperedge to connect to, then its a tree source
-        // and we can connect without a bend.
-        return (!hyperedgeConnection) ? true : false;
+        // This is a terminal, so the source of its tree, and we can
+        // connect without a bend.
+        return true;
     }
     else
     {
@@ -876,19 +1062,18 @@ bool MinimumTerminalSpanningTree::connectsWithoutBend(VertInf *oldLeaf,
     }
 }
 
-void MinimumTerminalSpanningTree::rewriteRestOfHyperedge(VertInf *vert,
-        VertInf **newTreeRootPtr)
+void MinimumTerminalSpanningTree::rewriteRestOfHyperedge(MTSTVertex *vert,
+        MTSTVertex **newTreeRootPtr)
 {
-    vert->setTreeRootPointer(newTreeRootPtr);
+    vert->treeRoot = newTreeRootPtr;
 
-    LayeredOrthogonalEdgeList edgeList = getOrthogonalEdgesFromVertex(vert,
-                NULL);
-    for (LayeredOrthogonalEdgeList::const_iterator edge = edgeList.begin(); 
+    MTSTEdgeList edgeList = getOrthogonalEdgesFromVertex(vert, NULL);
+    for (MTSTEdgeList::const_iterator edge = edgeList.begin(); 
             edge != edgeList.end(); ++edge)
     {
-        VertInf *v = edge->second;
+        MTSTVertex *v = edge->second;
 
-        if (v->treeRootPointer() == newTreeRootPtr)
+        if (v->treeRoot == newTreeRootPtr)
         {
             // Already marked.
             continue;
@@ -903,55 +1088,58 @@ void MinimumTerminalSpanningTree::rewriteRestOfHyperedge(VertInf *vert,
     }
 }
 
-void MinimumTerminalSpanningTree::drawForest(VertInf *vert, VertInf *prev)
+void MinimumTerminalSpanningTree::drawForest(MTSTVertex *vert, 
+        MTSTVertex *prev)
 {
     if (prev == NULL)
     {
         char colour[40];
         strcpy(colour, "green");
         /*
-        if (vert->id == dimensionChangeVertexID)
+        if (vert->isPartner)
         {
             strcpy(colour, "blue");
         }
         */
 
-        if (vert->treeRoot() == NULL)
+        if (treeRootOf(vert) == NULL)
         {
             strcpy(colour, "red");
         }
 
-        COLA_ASSERT(vert->treeRootPointer() != NULL);
-        COLA_ASSERT(vert->treeRoot() != NULL);
+        COLA_ASSERT(vert->treeRoot != NULL);
+        COLA_ASSERT(treeRootOf(vert) != NULL);
         fprintf(debug_fp, "<circle cx=\"%g\" cy=\"%g\" r=\"3\" db:sptfDist=\"%g\" "
                 "style=\"fill: %s; stroke: %s; fill-opacity: 0.5; "
                 "stroke-width: 1px; stroke-opacity:0.5\" />\n",
-                vert->point.x, vert->point.y, vert->sptfDist, colour, "black");
+                vert->vert->point.x, vert->vert->point.y, vert->sptfDist, 
+                colour, "black");
     }
     
-    LayeredOrthogonalEdgeList edgeList = getOrthogonalEdgesFromVertex(vert,
-            prev);
-    for (LayeredOrthogonalEdgeList::const_iterator edge = edgeList.begin(); 
+    MTSTEdgeList edgeList = getOrthogonalEdgesFromVertex(vert, prev);
+    for (MTSTEdgeList::const_iterator edge = edgeList.begin(); 
             edge != edgeList.end(); ++edge)
     {
-        VertInf *v = edge->second;
+        MTSTVertex *v = edge->second;
 
         if (v->sptfDist == 0)
         {
             continue;
         }
 
-        if (v->treeRoot() == vert->treeRoot())
+        if (treeRootOf(v) == treeRootOf(vert))
         {
             if (v->pathNext == vert)
             {
-                if (debug_fp && (vert->point != v->point))
+                const Point& vertPoint = vert->vert->point;
+                const Point& vPoint = v->vert->point;
+                if (debug_fp && (vertPoint != vPoint))
                 {
                     fprintf(debug_fp, "<path d=\"M %g %g L %g %g\" db:sptfDist=\"%g\" "
                             "style=\"fill: none; stroke: %s; "
                             "stroke-width: 1px;\" />\n",
-                            vert->point.x, vert->point.y, v->point.x,
-                            v->point.y, v->sptfDist, "purple");
+                            vertPoint.x, vertPoint.y, vPoint.x,
+                            vPoint.y, v->sptfDist, "purple");
                 }
                 drawForest(v, vert);
             }
@@ -959,26 +1147,26 @@ void MinimumTerminalSpanningTree::drawForest(VertInf *vert, VertInf *prev)
     }
 }
 
-VertexPair MinimumTerminalSpanningTree::
-        realVerticesCountingPartners(EdgeInf *edge)
+std::pair<MTSTVertex *, MTSTVertex *> MinimumTerminalSpanningTree::
+        realVerticesCountingPartners(const MTSTBridgingEdge& edge)
 {
-    VertInf *v1 = edge->m_vert1;
-    VertInf *v2 = edge->m_vert2;
+    MTSTVertex *v1 = edge.vert1;
+    MTSTVertex *v2 = edge.vert2;
 
-    VertexPair realVertices = std::make_pair(v1, v2);
+    std::pair<MTSTVertex *, MTSTVertex *> realVertices = 
+            std::make_pair(v1, v2);
 
-    if ((v1->id != dimensionChangeVertexID) && 
-            (v2->id != dimensionChangeVertexID) && 
-            (v1->point != v2->point) && 
-            (v1->point.x == v2->point.x))
+    const Point& p1 = v1->vert->point;
+    const Point& p2 = v2->vert->point;
+    if (!v1->isPartner && !v2->isPartner && (p1 != p2) && (p1.x == p2.x))
     {
-        if (v1->m_orthogonalPartner)
+        if (v1->hasPartner)
         {
-            realVertices.first = v1->m_orthogonalPartner;
+            realVertices.first = v1->partner;
         }
-        if (v2->m_orthogonalPartner)
+        if (v2->hasPartner)
         {
-            realVertices.second = v2->m_orthogonalPartner;
+            realVertices.second = v2->partner;
         }
     }
 
@@ -986,31 +1174,34 @@ VertexPair MinimumTerminalSpanningTree::
 }
 
 
-void MinimumTerminalSpanningTree::commitToBridgingEdge(EdgeInf *e, unsigned& step)
+void MinimumTerminalSpanningTree::commitToBridgingEdge(
+        const MTSTBridgingEdge& e, unsigned& step)
 {
-    VertexPair ends = realVerticesCountingPartners(e);
-    VertInf *newRoot = std::min(ends.first->treeRoot(), ends.second->treeRoot());
-    VertInf *oldRoot = std::max(ends.first->treeRoot(), ends.second->treeRoot());
+    std::pair<MTSTVertex *, MTSTVertex *> ends = 
+            realVerticesCountingPartners(e);
+    MTSTVertex *newRoot = 
+            std::min(treeRootOf(ends.first), treeRootOf(ends.second));
+    MTSTVertex *oldRoot = 
+            std::max(treeRootOf(ends.first), treeRootOf(ends.second));
 
     // Connect this edge into the MTST by building HyperEdgeTree nodes
     // and edges for this edge and the path back to the tree root.
     HyperEdgeTreeNode *node1 = NULL;
     HyperEdgeTreeNode *node2 = NULL;
 
-    VertInf *vert1 = ends.first;
-    VertInf *vert2 = ends.second;
+    MTSTVertex *vert1 = ends.first;
+    MTSTVertex *vert2 = ends.second;
     if (hyperEdgeTreeJunctions)
     {
         node1 = new HyperEdgeTreeNode();
-        node1->point = ends.first->point;
-        nodes[vert1] = node1;
+        node1->point = vert1->vert->point;
+        vert1->treeNode = node1;
 
         node2 = new HyperEdgeTreeNode();
-        node2->point = ends.second->point;
-        nodes[vert2] = node2;
+        node2->point = vert2->vert->point;
+        vert2->treeNode = node2;
 
         new HyperEdgeTreeEdge(node1, node2, NULL);
-        e->setHyperedgeSegment(true);
     }
     if (debug_fp)
     {
@@ -1019,31 +1210,30 @@ void MinimumTerminalSpanningTree::commitToBridgingEdge(EdgeInf *e, unsigned& ste
                 "inkscape:label=\"join-%02u\">\n", step - 1, step - 1);
         fprintf(debug_fp, "<path d=\"M %g %g L %g %g\" "
                 "style=\"fill: none; stroke: %s; "
-                "stroke-width: 1px;\" />\n", vert1->point.x,
-                vert1->point.y, vert2->point.x,
-                vert2->point.y, "red");
+                "stroke-width: 1px;\" />\n", vert1->vert->point.x,
+                vert1->vert->point.y, vert2->vert->point.x,
+                vert2->vert->point.y, "red");
     }
-    buildHyperEdgeTreeToRoot(vert1->pathNext, node1, vert1, true);
-    buildHyperEdgeTreeToRoot(vert2->pathNext, node2, vert2, true);
+    buildHyperEdgeTreeToRoot(vert1->pathNext, node1);
+    buildHyperEdgeTreeToRoot(vert2->pathNext, node2);
     
     if (debug_fp)
     {
         fprintf(debug_fp, "</g>\n<g inkscape:groupmode=\"layer\" "
                 "style=\"display: none;\" "
                 "inkscape:label=\"forest-%02u\">\n", step -1);
-        for (std::set<VertInf *>::iterator ti = terminals.begin();
-                ti != terminals.end(); ++ti)
+        for (MTSTVertexSet::iterator ti = searchTerminals.begin();
+                ti != searchTerminals.end(); ++ti)
         {
             drawForest(*ti, NULL);
         }
     }
     
-    VertInf **oldTreeRootPtr1 = vert1->treeRootPointer();
-    VertInf **oldTreeRootPtr2 = vert2->treeRootPointer();
+    MTSTVertex **oldTreeRootPtr1 = vert1->treeRoot;
+    MTSTVertex **oldTreeRootPtr2 = vert2->treeRoot;
     origTerminals.erase(oldRoot);
-    VertInf **newTreeRootPtr = vert1->makeTreeRootPointer(newRoot);
-    rootVertexPointers.push_back(newTreeRootPtr);
-    vert2->setTreeRootPointer(newTreeRootPtr);
+    MTSTVertex **newTreeRootPtr = makeTreeRootPointer(vert1, newRoot);
+    vert2->treeRoot = newTreeRootPtr;
 
     // Zero paths and add vertices on path to the terminal set.
     COLA_ASSERT(newRoot);
@@ -1060,8 +1250,8 @@ void MinimumTerminalSpanningTree::commitToBridgingEdge(EdgeInf *e, unsigned& ste
         fprintf(debug_fp, "</g>\n<g id=\"pruned-%u\" "
                 "inkscape:groupmode=\"layer\" style=\"display: none;\" "
                 "inkscape:label=\"pruned-%02u\">\n", step - 1, step - 1);
-        for (std::set<VertInf *>::iterator ti = terminals.begin();
-                ti != terminals.end(); ++ti)
+        for (MTSTVertexSet::iterator ti = searchTerminals.begin();
+                ti != searchTerminals.end(); ++ti)
         {
             drawForest(*ti, NULL);
         }
@@ -1082,8 +1272,9 @@ void MinimumTerminalSpanningTree::commitToBridgingEdge(EdgeInf *e, unsigned& ste
     }
 
     // Reset all terminals to zero.
-    for (std::set<VertInf *>::iterator v2 = terminals.begin(); 
-            v2 != terminals.end(); ++v2)
+    std::vector<MTSTVertex *>& vHeap = scratch->vHeap;
+    for (MTSTVertexSet::iterator v2 = searchTerminals.begin(); 
+            v2 != searchTerminals.end(); ++v2)
     {
         COLA_ASSERT((*v2)->sptfDist == 0);
         vHeap.push_back(*v2);
@@ -1092,4 +1283,3 @@ void MinimumTerminalSpanningTree::commitToBridgingEdge(EdgeInf *e, unsigned& ste
 }
 
 }
-
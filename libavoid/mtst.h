@@ -28,6 +28,8 @@
 #include <cstdio>
 #include <set>
 #include <list>
+#include <map>
+#include <vector>
 #include <utility>
 
 #include "libavoid/vertices.h"
@@ -43,9 +45,6 @@ class EdgeInf;
 
 typedef std::list<VertexSet> VertexSetList;
 
-typedef std::pair<EdgeInf *, VertInf *> LayeredOrthogonalEdge;
-typedef std::list<LayeredOrthogonalEdge> LayeredOrthogonalEdgeList;
-
 // Comparison for the vertex heap in the extended Dijkstra's algorithm.
 struct HeapCmpVertInf
 {
@@ -60,6 +59,95 @@ struct CmpEdgeInf
 };
 
 
+// The state of a vertex during the interleaved MTST construction.  Each
+// vertex of the orthogonal visibility graph has two of these: one for the
+// vertex itself, from which horizontal edges are explored, and one for its
+// orthogonal partner, from which vertical edges are explored.  Moving 
+// between the two costs a bend penalty.  Keeping this state outside the
+// VertInf objects lets several trees be constructed at once over the 
+// same graph.
+struct MTSTVertex
+{
+    VertInf *vert;
+    MTSTVertex *partner;
+    MTSTVertex *pathNext;
+    MTSTVertex **treeRoot;
+    HyperEdgeTreeNode *treeNode;
+    double sptfDist;
+    // The length and MTST distance of the edge joining a vertex to its 
+    // orthogonal partner.  Only set for vertices that are not partners, 
+    // once hasPartner is true.
+    double partnerEdgeDist;
+    double partnerEdgeMtstDist;
+    bool isPartner;
+    bool hasPartner;
+    // Set for vertices the search should treat as absent from the graph.
+    bool isIgnored;
+};
+
+
+// An edge bridging the shortest path trees of different terminals in the
+// interleaved MTST construction.  This is either an edge of the orthogonal
+// visibility graph, or the edge joining a vertex to its orthogonal partner,
+// in which case edge is NULL.
+struct MTSTBridgingEdge
+{
+    MTSTVertex *vert1;
+    MTSTVertex *vert2;
+    EdgeInf *edge;
+    double dist;
+    double *mtstDist;
+};
+typedef std::vector<std::pair<MTSTBridgingEdge, MTSTVertex *> > 
+        MTSTEdgeList;
+
+
+// Comparison for the vertex heap in the interleaved construction.
+struct HeapCmpMTSTVertex
+{
+    bool operator()(const MTSTVertex *a, const MTSTVertex *b) const;
+};
+
+
+// Ordering for sets of MTSTVertex records.  This follows the underlying
+// VertInf objects, so it does not depend on where the snapshot placed them.
+struct CmpMTSTVertex
+{
+    bool operator()(const MTSTVertex *a, const MTSTVertex *b) const;
+};
+typedef std::set<MTSTVertex *, CmpMTSTVertex> MTSTVertexSet;
+
+
+// Comparison for the bridging edge heap in the interleaved construction.
+struct CmpMTSTBridgingEdge
+{
+    bool operator()(const MTSTBridgingEdge& a, 
+            const MTSTBridgingEdge& b) const;
+};
+
+
+// Storage for the search state of the interleaved MTST construction,
+// indexed by the router's orthogonal visibility graph snapshot.  Nothing
+// is kept between constructions, so each thread can reuse one instance 
+// for all the trees it constructs.
+class MTSTScratch
+{
+    public:
+        void reset(Router *router);
+        MTSTVertex *vertex(const VertInf *vert);
+        double *edgeMtstDist(EdgeInf *edge);
+
+        // Vertex heap for extended Dijkstra's algorithm.
+        std::vector<MTSTVertex *> vHeap;
+        // Bridging edge heap for the extended Kruskal's algorithm.
+        std::vector<MTSTBridgingEdge> beHeap;
+
+    private:
+        std::vector<MTSTVertex> m_vertices;
+        std::map<EdgeInf *, double> m_edge_mtst_dists;
+};
+
+
 // This class is not intended for public use.
 // It is used by the hyperedge routing code to build a minimum terminal
 // spanning tree for a set of terminal vertices.
@@ -68,67 +156,85 @@ class MinimumTerminalSpanningTree
     public:
         MinimumTerminalSpanningTree(Router *router,
                 std::set<VertInf *> terminals,
-                JunctionHyperEdgeTreeNodeMap *hyperEdgeTreeJunctions = NULL);
+                JunctionHyperEdgeTreeNodeMap *hyperEdgeTreeJunctions = NULL,
+                MTSTScratch *scratch = NULL);
         ~MinimumTerminalSpanningTree();
 
         // Uses Interleaved construction of the MTST and SPTF (heuristic 2 
         // from paper).  This is the preferred construction approach.
+        // It requires the router's orthogonal visibility graph snapshot,
+        // which it only reads, and it leaves the creation of junctions to
+        // createJunctions(), so trees for different hyperedges may be 
+        // constructed concurrently, each with its own scratch storage.
         void constructInterleaved(void);
         // Uses Sequential construction of the MTST (heuristic 1 from paper).
         void constructSequential(void);
+        // Creates the junctions for the tree found by constructInterleaved().
+        void createJunctions(void);
         
         void setDebuggingOutput(FILE *fp, unsigned int counter);
+        // Vertices, other than terminals, that constructInterleaved() 
+        // should not route through.
+        void setIgnoredVertices(const std::list<VertInf *> *vertices);
         HyperEdgeTreeNode *rootJunction(void) const;
 
     private:
         void buildHyperEdgeTreeToRoot(VertInf *curr, 
-                HyperEdgeTreeNode *prevNode, VertInf *prevVert, 
-                bool markEdges = false);
-        VertInf **resetDistsForPath(VertInf *currVert, VertInf **newRootVertPtr);
-        void rewriteRestOfHyperedge(VertInf *vert, VertInf **newTreeRootPtr);
-        void drawForest(VertInf *vert, VertInf *prev);
+                HyperEdgeTreeNode *prevNode);
+        void buildHyperEdgeTreeToRoot(MTSTVertex *curr, 
+                HyperEdgeTreeNode *prevNode);
+        MTSTVertex **resetDistsForPath(MTSTVertex *currVert, 
+                MTSTVertex **newRootVertPtr);
+        void rewriteRestOfHyperedge(MTSTVertex *vert, 
+                MTSTVertex **newTreeRootPtr);
+        void drawForest(MTSTVertex *vert, MTSTVertex *prev);
 
         void makeSet(VertInf *vertex);
         VertexSetList::iterator findSet(VertInf *vertex);
         void unionSets(VertexSetList::iterator s1, VertexSetList::iterator s2);
         HyperEdgeTreeNode *addNode(VertInf *vertex, HyperEdgeTreeNode *prevNode);
+        HyperEdgeTreeNode *addNode(MTSTVertex *vertex, 
+                HyperEdgeTreeNode *prevNode);
 
         void popInvalidBridgingEdges(void);
-        void commitToBridgingEdge(EdgeInf *e, unsigned& step);
+        void commitToBridgingEdge(const MTSTBridgingEdge& e, unsigned& step);
         bool connectsWithoutBend(VertInf *oldLeaf, VertInf *newLeaf);
-        LayeredOrthogonalEdgeList getOrthogonalEdgesFromVertex(VertInf *vert, 
-                VertInf *prev);
-        VertInf *orthogonalPartner(VertInf *vert, double penalty = 0);
-        VertexPair realVerticesCountingPartners(EdgeInf *edge);
+        MTSTEdgeList getOrthogonalEdgesFromVertex(MTSTVertex *vert, 
+                MTSTVertex *prev);
+        MTSTVertex *orthogonalPartner(MTSTVertex *vert, double penalty = 0);
+        std::pair<MTSTVertex *, MTSTVertex *> realVerticesCountingPartners(
+                const MTSTBridgingEdge& edge);
+        MTSTVertex **makeTreeRootPointer(MTSTVertex *vert, MTSTVertex *root);
 
 
         Router *router;
         bool isOrthogonal;
         std::set<VertInf *> terminals;
-        std::set<VertInf *> origTerminals;
+        MTSTVertexSet searchTerminals;
+        MTSTVertexSet origTerminals;
         JunctionHyperEdgeTreeNodeMap *hyperEdgeTreeJunctions;
 
         VertexNodeMap nodes;
         HyperEdgeTreeNode *m_rootJunction;
+        std::vector<HyperEdgeTreeNode *> m_junction_nodes;
         double bendPenalty;
         VertexSetList allsets;
         std::list<VertInf *> visitedVertices;
         std::list<VertInf *> extraVertices;
         std::list<VertInf *> unusedVertices;
-        std::list<VertInf **> rootVertexPointers;
+        std::list<MTSTVertex *> rootVertexPointers;
+        const std::list<VertInf *> *ignoredVertices;
 
         FILE *debug_fp;
         unsigned int debug_count;
         unsigned int step_count;
         char debug_label[5];
 
-        // Vertex heap for extended Dijkstra's algorithm.
-        std::vector<VertInf *> vHeap;
-        HeapCmpVertInf vHeapCompare;
-
-        // Bridging edge heap for the extended Kruskal's algorithm.
-        std::vector<EdgeInf *> beHeap;
-        CmpEdgeInf beHeapCompare;
+        // Search state for the interleaved construction.
+        MTSTScratch *scratch;
+        bool ownsScratch;
+        HeapCmpMTSTVertex vHeapCompare;
+        CmpMTSTBridgingEdge beHeapCompare;
 
         const VertID dimensionChangeVertexID;
 };
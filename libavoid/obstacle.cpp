@@ -49,7 +49,7 @@ Obstacle::Obstacle(Router *router, Polygon ply, const unsigned int id)
     VertInf *node = NULL;
     for (size_t pt_i = 0; pt_i < routingPoly.size(); ++pt_i)
     {
-        node = new VertInf(m_router, i, routingPoly.ps[pt_i], addToRouterNow);
+        node = new (m_router) VertInf(m_router, i, routingPoly.ps[pt_i], addToRouterNow);
 
         if (!m_first_vert)
         {
@@ -29,7 +29,11 @@
 #include <cmath>
 #include <set>
 #include <list>
+#include <vector>
 #include <algorithm>
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
 
 #include "libavoid/router.h"
 #include "libavoid/geomtypes.h"
@@ -897,7 +901,7 @@ public:
         }
         if (!found)
         {
-            found = new VertInf(router, dummyOrthogID, Point(posX, pos));
+            found = new (router) VertInf(router, dummyOrthogID, Point(posX, pos));
             vertInfs.insert(found);
         }
         return found;
@@ -915,7 +919,7 @@ public:
         {
             if (begin != -DBL_MAX)
             {
-                vertInfs.insert(new
+                vertInfs.insert(new (router)
                         VertInf(router, dummyOrthogID, Point(begin, pos)));
             }
         }
@@ -934,7 +938,7 @@ public:
         {
             if (finish != DBL_MAX)
             {
-                vertInfs.insert(new
+                vertInfs.insert(new (router)
                         VertInf(router, dummyOrthogID, Point(finish, pos)));
             }
         }
@@ -1167,7 +1171,7 @@ public:
                 // Add begin point.
                 Point point(pos, pos);
                 point[dim] = begin;
-                VertInf *vert = new VertInf(router, dummyOrthogID, point);
+                VertInf *vert = new (router) VertInf(router, dummyOrthogID, point);
                 breakPoints.insert(PosVertInf(begin, vert));
             }
         }
@@ -1187,7 +1191,7 @@ public:
                 // Add begin point.
                 Point point(pos, pos);
                 point[dim] = finish;
-                VertInf *vert = new VertInf(router, dummyOrthogID, point);
+                VertInf *vert = new (router) VertInf(router, dummyOrthogID, point);
                 breakPoints.insert(PosVertInf(finish, vert));
             }
         }
@@ -1248,7 +1252,7 @@ public:
                     bool canSeeDown = (vert->dirs & VisDirDown);
                     if (canSeeDown && !(side->vert->id.isConnPt()))
                     {
-                        EdgeInf *edge = new 
+                        EdgeInf *edge = new (router)
                                 EdgeInf(side->vert, vert->vert, orthogonal);
                         edge->setDist(vert->vert->point[dim] - 
                                 side->vert->point[dim]);
@@ -1265,7 +1269,7 @@ public:
                     bool canSeeUp = (last->dirs & VisDirUp);
                     if (canSeeUp && (side != breakPoints.end()))
                     {
-                        EdgeInf *edge = new 
+                        EdgeInf *edge = new (router)
                                 EdgeInf(last->vert, side->vert, orthogonal);
                         edge->setDist(side->vert->point[dim] - 
                                 last->vert->point[dim]);
@@ -1295,7 +1299,7 @@ public:
                 if (generateEdge)
                 {
                     EdgeInf *edge = 
-                            new EdgeInf(last->vert, vert->vert, orthogonal);
+                            new (router) EdgeInf(last->vert, vert->vert, orthogonal);
                     edge->setDist(vert->vert->point[dim] - 
                             last->vert->point[dim]);
                 }
@@ -1531,9 +1535,9 @@ static void processEventVert(Router *router, NodeSet& scanline,
             if (minLimitMax >= maxLimitMin)
             {
                 // These vertices represent the shape corners.
-                VertInf *vI1 = new VertInf(router, dummyOrthogShapeID, 
+                VertInf *vI1 = new (router) VertInf(router, dummyOrthogShapeID, 
                             Point(minShape, lineY));
-                VertInf *vI2 = new VertInf(router, dummyOrthogShapeID, 
+                VertInf *vI2 = new (router) VertInf(router, dummyOrthogShapeID, 
                             Point(maxShape, lineY));
                 
                 // There are no overlapping shapes, so give full visibility.
@@ -1559,7 +1563,7 @@ static void processEventVert(Router *router, NodeSet& scanline,
                     LineSegment *line = segments.insert(
                             LineSegment(minLimit, minLimitMax, lineY, true));
                     // Shape corner:
-                    VertInf *vI1 = new VertInf(router, dummyOrthogShapeID, 
+                    VertInf *vI1 = new (router) VertInf(router, dummyOrthogShapeID, 
                                 Point(minShape, lineY));
                     line->vertInfs.insert(vI1);
                 }
@@ -1568,7 +1572,7 @@ static void processEventVert(Router *router, NodeSet& scanline,
                     LineSegment *line = segments.insert(
                             LineSegment(maxLimitMin, maxLimit, lineY, true));
                     // Shape corner:
-                    VertInf *vI2 = new VertInf(router, dummyOrthogShapeID, 
+                    VertInf *vI2 = new (router) VertInf(router, dummyOrthogShapeID, 
                                 Point(maxShape, lineY));
                     line->vertInfs.insert(vI2);
                 }
@@ -1614,7 +1618,7 @@ static void processEventVert(Router *router, NodeSet& scanline,
                 // *through* connector endpoint vertices).
                 if (line1 || line2)
                 {
-                    VertInf *cent = new VertInf(router, dummyOrthogID, cp);
+                    VertInf *cent = new (router) VertInf(router, dummyOrthogID, cp);
                     if (line1)
                     {
                         line1->vertInfs.insert(cent);
@@ -1645,7 +1649,6 @@ static void processEventVert(Router *router, NodeSet& scanline,
         if (e->type == ConnPoint)
         {
             scanline.erase(v->iter);
-            delete v;
         }
         else  // if (e->type == Close)
         {
@@ -1653,7 +1656,6 @@ static void processEventVert(Router *router, NodeSet& scanline,
             result = scanline.erase(v);
             COLA_ASSERT(result == 1);
             COLA_UNUSED(result);  // Avoid warning.
-            delete v;
         }
     }
 }
@@ -1716,9 +1718,9 @@ static void processEventHori(Router *router, NodeSet& scanline,
                         LineSegment(minLimit, maxLimit, lineX));
 
                 // Shape corners:
-                VertInf *vI1 = new VertInf(router, dummyOrthogShapeID, 
+                VertInf *vI1 = new (router) VertInf(router, dummyOrthogShapeID, 
                         Point(lineX, minShape));
-                VertInf *vI2 = new VertInf(router, dummyOrthogShapeID, 
+                VertInf *vI2 = new (router) VertInf(router, dummyOrthogShapeID, 
                         Point(lineX, maxShape));
                 line->vertInfs.insert(vI1);
                 line->vertInfs.insert(vI2);
@@ -1731,7 +1733,7 @@ static void processEventHori(Router *router, NodeSet& scanline,
                             LineSegment(minLimit, minLimitMax, lineX));
 
                     // Shape corner:
-                    VertInf *vI1 = new VertInf(router, dummyOrthogShapeID, 
+                    VertInf *vI1 = new (router) VertInf(router, dummyOrthogShapeID, 
                                 Point(lineX, minShape));
                     line->vertInfs.insert(vI1);
                 }
@@ -1741,7 +1743,7 @@ static void processEventHori(Router *router, NodeSet& scanline,
                             LineSegment(maxLimitMin, maxLimit, lineX));
 
                     // Shape corner:
-                    VertInf *vI2 = new VertInf(router, dummyOrthogShapeID, 
+                    VertInf *vI2 = new (router) VertInf(router, dummyOrthogShapeID, 
                                 Point(lineX, maxShape));
                     line->vertInfs.insert(vI2);
                 }
@@ -1788,7 +1790,6 @@ static void processEventHori(Router *router, NodeSet& scanline,
         if (e->type == ConnPoint)
         {
             scanline.erase(v->iter);
-            delete v;
         }
         else  // if (e->type == Close)
         {
@@ -1796,7 +1797,6 @@ static void processEventHori(Router *router, NodeSet& scanline,
             result = scanline.erase(v);
             COLA_ASSERT(result == 1);
             COLA_UNUSED(result);  // Avoid warning.
-            delete v;
         }
     }
 }
@@ -1809,6 +1809,14 @@ extern void generateStaticOrthogonalVisGraph(Router *router)
     // Set up the events for the vertical sweep.
     size_t totalEvents = (2 * n) + cpn;
     Event **events = new Event*[totalEvents];
+    // The nodes and events for each sweep are stored contiguously and 
+    // freed together once the sweep is done, rather than allocated one
+    // at a time.  Their storage is reserved up front and never grows,
+    // since the scanline and event list point into it.
+    std::vector<Node> nodes;
+    nodes.reserve(n + cpn);
+    std::vector<Event> eventStore;
+    eventStore.reserve(totalEvents);
     unsigned ctr = 0;
     ObstacleList::iterator obstacleIt = router->m_obstacles.begin();
     for (unsigned i = 0; i < n; i++)
@@ -1827,9 +1835,12 @@ extern void generateStaticOrthogonalVisGraph(Router *router)
 
         Box bbox = obstacle->routingBox();
         double midX = bbox.min.x + ((bbox.max.x - bbox.min.x) / 2);
-        Node *v = new Node(obstacle, midX);
-        events[ctr++] = new Event(Open, v, bbox.min.y);
-        events[ctr++] = new Event(Close, v, bbox.max.y);
+        nodes.push_back(Node(obstacle, midX));
+        Node *v = &nodes.back();
+        eventStore.push_back(Event(Open, v, bbox.min.y));
+        events[ctr++] = &eventStore.back();
+        eventStore.push_back(Event(Close, v, bbox.max.y));
+        events[ctr++] = &eventStore.back();
 
         ++obstacleIt;
     }
@@ -1847,8 +1858,10 @@ extern void generateStaticOrthogonalVisGraph(Router *router)
         }
         Point& point = curr->point;
 
-        Node *v = new Node(curr, point.x);
-        events[ctr++] = new Event(ConnPoint, v, point.y);
+        nodes.push_back(Node(curr, point.x));
+        Node *v = &nodes.back();
+        eventStore.push_back(Event(ConnPoint, v, point.y));
+        events[ctr++] = &eventStore.back();
     }
     qsort((Event*)events, (size_t) totalEvents, sizeof(Event*), compare_events);
 
@@ -1892,10 +1905,8 @@ extern void generateStaticOrthogonalVisGraph(Router *router)
         processEventVert(router, scanline, segments, events[i], pass);
     }
     COLA_ASSERT(scanline.size() == 0);
-    for (unsigned i = 0; i < totalEvents; ++i)
-    {
-        delete events[i];
-    }
+    nodes.clear();
+    eventStore.clear();
 
     segments.list().sort();
 
@@ -1917,9 +1928,12 @@ extern void generateStaticOrthogonalVisGraph(Router *router)
 #endif
         Box bbox = obstacle->routingBox();
         double midY = bbox.min.y + ((bbox.max.y - bbox.min.y) / 2);
-        Node *v = new Node(obstacle, midY);
-        events[ctr++] = new Event(Open, v, bbox.min.x);
-        events[ctr++] = new Event(Close, v, bbox.max.x);
+        nodes.push_back(Node(obstacle, midY));
+        Node *v = &nodes.back();
+        eventStore.push_back(Event(Open, v, bbox.min.x));
+        events[ctr++] = &eventStore.back();
+        eventStore.push_back(Event(Close, v, bbox.max.x));
+        events[ctr++] = &eventStore.back();
 
         ++obstacleIt;
     }
@@ -1936,8 +1950,10 @@ extern void generateStaticOrthogonalVisGraph(Router *router)
         }
         Point& point = curr->point;
 
-        Node *v = new Node(curr, point.y);
-        events[ctr++] = new Event(ConnPoint, v, point.x);
+        nodes.push_back(Node(curr, point.y));
+        Node *v = &nodes.back();
+        eventStore.push_back(Event(ConnPoint, v, point.x));
+        events[ctr++] = &eventStore.back();
     }
     qsort((Event*)events, (size_t) totalEvents, sizeof(Event*), compare_events);
 
@@ -1986,10 +2002,6 @@ extern void generateStaticOrthogonalVisGraph(Router *router)
         processEventHori(router, scanline, vertSegments, events[i], pass);
     }
     COLA_ASSERT(scanline.size() == 0);
-    for (unsigned i = 0; i < totalEvents; ++i)
-    {
-        delete events[i];
-    }
     delete [] events;
 
     // Add portions of the horizontal line that are after the final vertical
@@ -2094,7 +2106,6 @@ static void processShiftEvent(NodeSet& scanline, Event *e, size_t dim,
         result = scanline.erase(v);
         COLA_ASSERT(result == 1);
         COLA_UNUSED(result);  // Avoid warning.
-        delete v;
     }
 }
 
@@ -2449,6 +2460,12 @@ static void buildOrthogonalChannelInfo(Router *router,
     // Set up the events for the sweep.
     size_t totalEvents = 2 * (n + cpn);
     Event **events = new Event*[totalEvents];
+    // As for the visibility graph sweeps, the nodes and events are stored
+    // contiguously in storage that must not grow during the sweep.
+    std::vector<Node> nodes;
+    nodes.reserve(n + cpn);
+    std::vector<Event> eventStore;
+    eventStore.reserve(totalEvents);
     unsigned ctr = 0;
     ObstacleList::iterator obstacleIt = router->m_obstacles.begin();
     for (unsigned i = 0; i < n; i++)
@@ -2466,9 +2483,12 @@ static void buildOrthogonalChannelInfo(Router *router,
         Point min = bBox.min;
         Point max = bBox.max;
         double mid = min[dim] + ((max[dim] - min[dim]) / 2);
-        Node *v = new Node(obstacle, mid);
-        events[ctr++] = new Event(Open, v, min[altDim]);
-        events[ctr++] = new Event(Close, v, max[altDim]);
+        nodes.push_back(Node(obstacle, mid));
+        Node *v = &nodes.back();
+        eventStore.push_back(Event(Open, v, min[altDim]));
+        events[ctr++] = &eventStore.back();
+        eventStore.push_back(Event(Close, v, max[altDim]));
+        events[ctr++] = &eventStore.back();
 
         ++obstacleIt;
     }
@@ -2480,9 +2500,12 @@ static void buildOrthogonalChannelInfo(Router *router,
 
         COLA_ASSERT(lowPt[dim] == highPt[dim]);
         COLA_ASSERT(lowPt[altDim] < highPt[altDim]);
-        Node *v = new Node(*curr, lowPt[dim]);
-        events[ctr++] = new Event(SegOpen, v, lowPt[altDim]);
-        events[ctr++] = new Event(SegClose, v, highPt[altDim]);
+        nodes.push_back(Node(*curr, lowPt[dim]));
+        Node *v = &nodes.back();
+        eventStore.push_back(Event(SegOpen, v, lowPt[altDim]));
+        events[ctr++] = &eventStore.back();
+        eventStore.push_back(Event(SegClose, v, highPt[altDim]));
+        events[ctr++] = &eventStore.back();
     }
     qsort((Event*)events, (size_t) totalEvents, sizeof(Event*), compare_events);
 
@@ -2524,10 +2547,6 @@ static void buildOrthogonalChannelInfo(Router *router,
         processShiftEvent(scanline, events[i], dim, pass);
     }
     COLA_ASSERT(scanline.size() == 0);
-    for (unsigned i = 0; i < totalEvents; ++i)
-    {
-        delete events[i];
-    }
     delete [] events;
 }
 
@@ -2696,9 +2715,17 @@ class CmpLineOrder
             Point& unchanged = (lhsLow[altDim] > rhsLow[altDim]) ?
                     lhsLow : rhsLow;
 
-            PtOrder& lowOrder = orders[unchanged];
-            int lhsPos = lowOrder.positionFor(dimension, lhs->connRef);
-            int rhsPos = lowOrder.positionFor(dimension, rhs->connRef);
+            // There is no order at all if neither point was seen when 
+            // building the orders.  Don't insert one, since regions are 
+            // compared concurrently.
+            int lhsPos = -1;
+            int rhsPos = -1;
+            PtOrderMap::iterator lowOrder = orders.find(unchanged);
+            if (lowOrder != orders.end())
+            {
+                lhsPos = lowOrder->second.positionFor(dimension, lhs->connRef);
+                rhsPos = lowOrder->second.positionFor(dimension, rhs->connRef);
+            }
             if ((lhsPos == -1) || (rhsPos == -1))
             {
                 // A value for rhsPos or lhsPos mean the points are not directly
@@ -2858,9 +2885,11 @@ class PotentialSegmentConstraint
         const Variables& vs;
 };
 
-static void nudgeOrthogonalRoutes(Router *router, size_t dimension, 
-        PtOrderMap& pointOrders, ShiftSegmentList& segmentList, 
-        bool justUnifying = false)
+// Nudges a region of segments that overlap one another, but not the 
+// segments of any other region.  The segments are deleted afterwards.
+static void nudgeOrthogonalRegion(Router *router, size_t dimension, 
+        PtOrderMap& pointOrders, ShiftSegmentList& currentRegion, 
+        bool justUnifying)
 {
     bool nudgeFinalSegments = router->routingOption(
             nudgeOrthogonalSegmentsConnectedToShapes);
@@ -2870,473 +2899,507 @@ static void nudgeOrthogonalRoutes(Router *router, size_t dimension,
     // we try 10 times, reducing each time by a 10th of the original amount.
     double reductionSteps = 10.0;
 
-    // Do the actual nudging.
-    ShiftSegmentList currentRegion;
-    while (!segmentList.empty())
+    if (! justUnifying)
     {
-        // Take a reference segment
-        ShiftSegment *currentSegment = segmentList.front();
-        // Then, find the segments that overlap this one.
-        currentRegion.clear();
-        currentRegion.push_back(currentSegment);
-        segmentList.erase(segmentList.begin());
-        for (ShiftSegmentList::iterator curr = segmentList.begin();
-                curr != segmentList.end(); )
-        {
-            bool overlaps = false;
-            for (ShiftSegmentList::iterator curr2 = currentRegion.begin();
-                    curr2 != currentRegion.end(); ++curr2)
-            {
-                if ((*curr)->overlapsWith(*curr2, dimension))
-                {
-                    overlaps = true;
-                    break;
-                }
-            }
-            if (overlaps)
-            {
-                currentRegion.push_back(*curr);
-                segmentList.erase(curr);
-                // Consider segments from the beginning, since we may have
-                // since passed segments that overlap with the new set.
-                curr = segmentList.begin();
-            }
-            else
-            {
-                ++curr;
-            }
-        }
-
-        if (! justUnifying)
-        {
-            CmpLineOrder lineSortComp(pointOrders, dimension);
-            currentRegion = linesort(nudgeFinalSegments, currentRegion,
-                    lineSortComp);
-        }
+        CmpLineOrder lineSortComp(pointOrders, dimension);
+        currentRegion = linesort(nudgeFinalSegments, currentRegion,
+                lineSortComp);
+    }
 
-        if (currentRegion.size() == 1)
+    if (currentRegion.size() == 1)
+    {
+        // Save creating the solver instance if there is just one
+        // immovable segment, or if we are in the unifying stage.
+        if (currentRegion.front()->immovable() || justUnifying)
         {
-            // Save creating the solver instance if there is just one
-            // immovable segment, or if we are in the unifying stage.
-            if (currentRegion.front()->immovable() || justUnifying)
-            {
-                delete currentRegion.front();
-                continue;
-            }
+            delete currentRegion.front();
+            return;
         }
+    }
 
-        // Process these segments.
-        std::list<unsigned> freeIndexes;
-        Variables vs;
-        Constraints cs;
-        Constraints gapcs;
-        ShiftSegmentPtrList prevVars;
-        double sepDist = baseSepDist;
+    // Process these segments.
+    std::list<unsigned> freeIndexes;
+    Variables vs;
+    Constraints cs;
+    Constraints gapcs;
+    ShiftSegmentPtrList prevVars;
+    double sepDist = baseSepDist;
 #ifdef NUDGE_DEBUG 
-        fprintf(stderr, "-------------------------------------------------------\n");
-        fprintf(stderr, "%s -- size: %d\n", (justUnifying) ? "Unifying" : "Nudging",
-                (int) currentRegion.size());
+    fprintf(stderr, "-------------------------------------------------------\n");
+    fprintf(stderr, "%s -- size: %d\n", (justUnifying) ? "Unifying" : "Nudging",
+            (int) currentRegion.size());
 #endif
 #ifdef NUDGE_DEBUG_SVG
-        printf("\n\n");
+    printf("\n\n");
 #endif
-        for (ShiftSegmentList::iterator currSegmentIt = currentRegion.begin();
-                currSegmentIt != currentRegion.end(); ++currSegmentIt )
-        {
-            NudgingShiftSegment *currSegment = dynamic_cast<NudgingShiftSegment *> (*currSegmentIt);
-            
-            // Create a solver variable for the position of this segment.
-            currSegment->createSolverVariable(justUnifying);
-            
-            vs.push_back(currSegment->variable);
-            size_t index = vs.size() - 1;
+    for (ShiftSegmentList::iterator currSegmentIt = currentRegion.begin();
+            currSegmentIt != currentRegion.end(); ++currSegmentIt )
+    {
+        NudgingShiftSegment *currSegment = dynamic_cast<NudgingShiftSegment *> (*currSegmentIt);
+        
+        // Create a solver variable for the position of this segment.
+        currSegment->createSolverVariable(justUnifying);
+        
+        vs.push_back(currSegment->variable);
+        size_t index = vs.size() - 1;
 #ifdef NUDGE_DEBUG
-            fprintf(stderr,"line(%d)  %.15f  dim: %d pos: %.16f\n"
-                   "min: %.16f  max: %.16f\n"
-                   "minEndPt: %.16f  maxEndPt: %.16f weight: %g cc: %d\n",
-                    currSegment->connRef->id(),
-                    currSegment->lowPoint()[dimension], (int) dimension, 
-                    currSegment->variable->desiredPosition, 
-                    currSegment->minSpaceLimit, currSegment->maxSpaceLimit,
-                    currSegment->lowPoint()[!dimension], currSegment->highPoint()[!dimension], 
-                    currSegment->variable->weight, 
-                    (int) currSegment->checkpoints.size());
+        fprintf(stderr,"line(%d)  %.15f  dim: %d pos: %.16f\n"
+               "min: %.16f  max: %.16f\n"
+               "minEndPt: %.16f  maxEndPt: %.16f weight: %g cc: %d\n",
+                currSegment->connRef->id(),
+                currSegment->lowPoint()[dimension], (int) dimension, 
+                currSegment->variable->desiredPosition, 
+                currSegment->minSpaceLimit, currSegment->maxSpaceLimit,
+                currSegment->lowPoint()[!dimension], currSegment->highPoint()[!dimension], 
+                currSegment->variable->weight, 
+                (int) currSegment->checkpoints.size());
 #endif
 #ifdef NUDGE_DEBUG_SVG
-            // Debugging info:
-            double minP = std::max(currSegment->minSpaceLimit, -5000.0);
-            double maxP = std::min(currSegment->maxSpaceLimit, 5000.0);
-            fprintf(stdout, "<rect style=\"fill: #f00; opacity: 0.2;\" "
-                    "x=\"%g\" y=\"%g\" width=\"%g\" height=\"%g\" />\n",
-                    currSegment->lowPoint()[XDIM], minP, 
-                    currSegment->highPoint()[XDIM] - currSegment->lowPoint()[XDIM], 
-                    maxP - minP);
-            fprintf(stdout, "<line style=\"stroke: #000;\" x1=\"%g\" "
-                    "y1=\"%g\" x2=\"%g\" y2=\"%g\" />\n",
-                    currSegment->lowPoint()[XDIM], currSegment->lowPoint()[YDIM],
-                    currSegment->highPoint()[XDIM], currSegment->highPoint()[YDIM]);
+        // Debugging info:
+        double minP = std::max(currSegment->minSpaceLimit, -5000.0);
+        double maxP = std::min(currSegment->maxSpaceLimit, 5000.0);
+        fprintf(stdout, "<rect style=\"fill: #f00; opacity: 0.2;\" "
+                "x=\"%g\" y=\"%g\" width=\"%g\" height=\"%g\" />\n",
+                currSegment->lowPoint()[XDIM], minP, 
+                currSegment->highPoint()[XDIM] - currSegment->lowPoint()[XDIM], 
+                maxP - minP);
+        fprintf(stdout, "<line style=\"stroke: #000;\" x1=\"%g\" "
+                "y1=\"%g\" x2=\"%g\" y2=\"%g\" />\n",
+                currSegment->lowPoint()[XDIM], currSegment->lowPoint()[YDIM],
+                currSegment->highPoint()[XDIM], currSegment->highPoint()[YDIM]);
 #endif
 
-            // Constrain to channel boundary.
-            if (!currSegment->fixed)
+        // Constrain to channel boundary.
+        if (!currSegment->fixed)
+        {
+            // If this segment sees a channel boundary to its left,
+            // then constrain its placement as such.
+            if (currSegment->minSpaceLimit > -CHANNEL_MAX)
             {
-                // If this segment sees a channel boundary to its left,
-                // then constrain its placement as such.
-                if (currSegment->minSpaceLimit > -CHANNEL_MAX)
-                {
-                    vs.push_back(new Variable(channelLeftID,
-                                currSegment->minSpaceLimit, fixedWeight));
-                    cs.push_back(new Constraint(vs[vs.size() - 1], vs[index],
-                                0.0));
-                }
+                vs.push_back(new Variable(channelLeftID,
+                            currSegment->minSpaceLimit, fixedWeight));
+                cs.push_back(new Constraint(vs[vs.size() - 1], vs[index],
+                            0.0));
             }
+        }
 
-            if (justUnifying)
+        if (justUnifying)
+        {
+            // Just doing centring, not nudging.
+            // Record the index of the variable so we can use it as 
+            // a segment to potentially constrain to other segments.
+            if (currSegment->variable->weight == freeWeight)
             {
-                // Just doing centring, not nudging.
-                // Record the index of the variable so we can use it as 
-                // a segment to potentially constrain to other segments.
-                if (currSegment->variable->weight == freeWeight)
-                {
-                    freeIndexes.push_back(index);
-                }
-                // Thus, we don't need to constrain position against other
-                // segments.
-                prevVars.push_back(&(*currSegment));
-                continue;
+                freeIndexes.push_back(index);
             }
+            // Thus, we don't need to constrain position against other
+            // segments.
+            prevVars.push_back(&(*currSegment));
+            continue;
+        }
 
-            // Constrain position in relation to previously seen segments,
-            // if necessary (i.e. when they could overlap).
-            for (ShiftSegmentPtrList::iterator prevVarIt = prevVars.begin();
-                    prevVarIt != prevVars.end(); ++prevVarIt)
+        // Constrain position in relation to previously seen segments,
+        // if necessary (i.e. when they could overlap).
+        for (ShiftSegmentPtrList::iterator prevVarIt = prevVars.begin();
+                prevVarIt != prevVars.end(); ++prevVarIt)
+        {
+            NudgingShiftSegment *prevSeg =
+                    dynamic_cast<NudgingShiftSegment *> (*prevVarIt);
+            Variable *prevVar = prevSeg->variable;
+            
+            if (currSegment->overlapsWith(prevSeg, dimension) &&
+                    (!(currSegment->fixed) || !(prevSeg->fixed)))
             {
-                NudgingShiftSegment *prevSeg =
-                        dynamic_cast<NudgingShiftSegment *> (*prevVarIt);
-                Variable *prevVar = prevSeg->variable;
-                
-                if (currSegment->overlapsWith(prevSeg, dimension) &&
-                        (!(currSegment->fixed) || !(prevSeg->fixed)))
-                {
-                    // If there is a previous segment to the left that 
-                    // could overlap this in the shift direction, then 
-                    // constrain the two segments to be separated.
-                    // Though don't add the constraint if both the 
-                    // segments are fixed in place.
-                    double thisSepDist = sepDist;
-                    bool equality = false;
-                    if (currSegment->shouldAlignWith(prevSeg, dimension))
-                    {
-                        // Handles the case where the two end segments can
-                        // be brought together to make a single segment. This
-                        // can help in situations where having the small kink
-                        // can restrict other kinds of nudging.
-                        thisSepDist = 0;
-                        equality = true;
-                    }
-                    else if (currSegment->connRef == prevSeg->connRef)
-                    {
-                        // We need to address the problem of two neighbouring
-                        // segments of the same connector being kept separated
-                        // due only to a kink created in the other dimension.
-                        // Here, we let such segments drift back together.
-                        thisSepDist = 0;
-                    }
-
-                    Constraint *constraint = new Constraint(prevVar, 
-                            vs[index], thisSepDist, equality);
-                    cs.push_back(constraint);
-                    if (thisSepDist)
-                    {
-                        // Add to the list of gap constraints so we can 
-                        // rewrite the separation distance later.
-                        gapcs.push_back(constraint);
-                    }
+                // If there is a previous segment to the left that 
+                // could overlap this in the shift direction, then 
+                // constrain the two segments to be separated.
+                // Though don't add the constraint if both the 
+                // segments are fixed in place.
+                double thisSepDist = sepDist;
+                bool equality = false;
+                if (currSegment->shouldAlignWith(prevSeg, dimension))
+                {
+                    // Handles the case where the two end segments can
+                    // be brought together to make a single segment. This
+                    // can help in situations where having the small kink
+                    // can restrict other kinds of nudging.
+                    thisSepDist = 0;
+                    equality = true;
+                }
+                else if (currSegment->connRef == prevSeg->connRef)
+                {
+                    // We need to address the problem of two neighbouring
+                    // segments of the same connector being kept separated
+                    // due only to a kink created in the other dimension.
+                    // Here, we let such segments drift back together.
+                    thisSepDist = 0;
                 }
-            }
 
-            if (!currSegment->fixed)
-            {
-                // If this segment sees a channel boundary to its right,
-                // then constrain its placement as such.
-                if (currSegment->maxSpaceLimit < CHANNEL_MAX)
+                Constraint *constraint = new Constraint(prevVar, 
+                        vs[index], thisSepDist, equality);
+                cs.push_back(constraint);
+                if (thisSepDist)
                 {
-                    vs.push_back(new Variable(channelRightID,
-                                currSegment->maxSpaceLimit, fixedWeight));
-                    cs.push_back(new Constraint(vs[index], vs[vs.size() - 1],
-                                0.0));
+                    // Add to the list of gap constraints so we can 
+                    // rewrite the separation distance later.
+                    gapcs.push_back(constraint);
                 }
             }
+        }
 
-            prevVars.push_back(&(*currSegment));
+        if (!currSegment->fixed)
+        {
+            // If this segment sees a channel boundary to its right,
+            // then constrain its placement as such.
+            if (currSegment->maxSpaceLimit < CHANNEL_MAX)
+            {
+                vs.push_back(new Variable(channelRightID,
+                            currSegment->maxSpaceLimit, fixedWeight));
+                cs.push_back(new Constraint(vs[index], vs[vs.size() - 1],
+                            0.0));
+            }
         }
 
-        std::list<PotentialSegmentConstraint> potentialConstraints;
-        if (justUnifying)
+        prevVars.push_back(&(*currSegment));
+    }
+
+    std::list<PotentialSegmentConstraint> potentialConstraints;
+    if (justUnifying)
+    {
+        for (std::list<unsigned>::iterator curr = freeIndexes.begin();
+                curr != freeIndexes.end(); ++curr)
         {
-            for (std::list<unsigned>::iterator curr = freeIndexes.begin();
-                    curr != freeIndexes.end(); ++curr)
+            for (std::list<unsigned>::iterator curr2 = curr;
+                    curr2 != freeIndexes.end(); ++curr2)
             {
-                for (std::list<unsigned>::iterator curr2 = curr;
-                        curr2 != freeIndexes.end(); ++curr2)
+                if (curr == curr2)
                 {
-                    if (curr == curr2)
-                    {
-                        continue;
-                    }
-                    potentialConstraints.push_back(
-                            PotentialSegmentConstraint(*curr, *curr2, vs));
+                    continue;
                 }
+                potentialConstraints.push_back(
+                        PotentialSegmentConstraint(*curr, *curr2, vs));
             }
         }
+    }
 #ifdef NUDGE_DEBUG
-        for (unsigned i = 0;i < vs.size(); ++i)
-        {
-            fprintf(stderr, "-vs[%d]=%f\n", i, vs[i]->desiredPosition);
-        }
+    for (unsigned i = 0;i < vs.size(); ++i)
+    {
+        fprintf(stderr, "-vs[%d]=%f\n", i, vs[i]->desiredPosition);
+    }
 #endif
-        // Repeatedly try solving this.  There are two cases:
-        //  -  When Unifying, we greedily place as many free segments as 
-        //     possible at the same positions, that way they have more 
-        //     accurate nudging orders determined for them in the Nudging
-        //     stage.
-        //  -  When Nudging, if we can't fit all the segments with the 
-        //     default nudging distance we try smaller separation 
-        //     distances till we find a solution that is satisfied.
-        bool justAddedConstraint = false;
-        bool satisfied;
-
-        typedef std::pair<size_t, size_t> UnsatisfiedRange;
-        std::list<UnsatisfiedRange> unsatisfiedRanges;
-        do 
-        {
-            IncSolver f(vs, cs);
-            f.solve();
-
-            // Determine if the problem was satisfied.
-            satisfied = true;
-            for (size_t i = 0; i < vs.size(); ++i) 
-            {
-                // For each variable...
-                if (vs[i]->id >= fixedSegmentID)
-                {
-                    // If it is a fixed segment (should stay still)
-                    if (fabs(vs[i]->finalPosition - 
-                            vs[i]->desiredPosition) > 0.01)
-                    {
-                        // And it is not at it's desired position, then 
-                        // we consider the problem to be unsatisfied.
-                        satisfied = false;
+    // Repeatedly try solving this.  There are two cases:
+    //  -  When Unifying, we greedily place as many free segments as 
+    //     possible at the same positions, that way they have more 
+    //     accurate nudging orders determined for them in the Nudging
+    //     stage.
+    //  -  When Nudging, if we can't fit all the segments with the 
+    //     default nudging distance we try smaller separation 
+    //     distances till we find a solution that is satisfied.
+    bool justAddedConstraint = false;
+    bool satisfied;
+
+    typedef std::pair<size_t, size_t> UnsatisfiedRange;
+    std::list<UnsatisfiedRange> unsatisfiedRanges;
+    do 
+    {
+        IncSolver f(vs, cs);
+        f.solve();
+
+        // Determine if the problem was satisfied.
+        satisfied = true;
+        for (size_t i = 0; i < vs.size(); ++i) 
+        {
+            // For each variable...
+            if (vs[i]->id >= fixedSegmentID)
+            {
+                // If it is a fixed segment (should stay still)
+                if (fabs(vs[i]->finalPosition - 
+                        vs[i]->desiredPosition) > 0.01)
+                {
+                    // And it is not at it's desired position, then 
+                    // we consider the problem to be unsatisfied.
+                    satisfied = false;
 
-                        // We record ranges of unsatisfied variables based on
-                        // the channel edges.
-                        if (vs[i]->id == channelLeftID)
+                    // We record ranges of unsatisfied variables based on
+                    // the channel edges.
+                    if (vs[i]->id == channelLeftID)
+                    {
+                        // This is the left-hand-side of a channel.
+                        if (unsatisfiedRanges.empty() || 
+                                (unsatisfiedRanges.back().first !=
+                                unsatisfiedRanges.back().second))
                         {
-                            // This is the left-hand-side of a channel.
-                            if (unsatisfiedRanges.empty() || 
-                                    (unsatisfiedRanges.back().first !=
-                                    unsatisfiedRanges.back().second))
-                            {
-                                // There are no existing unsatisfied ranges,
-                                // or there are but they are a valid range 
-                                // (we've encountered the right-hand channel
-                                // edges already).
-                                // So, start a new unsatisfied range.
-                                unsatisfiedRanges.push_back(
-                                        std::make_pair(i, i));
-                            }
+                            // There are no existing unsatisfied ranges,
+                            // or there are but they are a valid range 
+                            // (we've encountered the right-hand channel
+                            // edges already).
+                            // So, start a new unsatisfied range.
+                            unsatisfiedRanges.push_back(
+                                    std::make_pair(i, i));
                         }
-                        else if (vs[i]->id == channelRightID)
+                    }
+                    else if (vs[i]->id == channelRightID)
+                    {
+                        // This is the left-hand-side of a channel.
+                        COLA_ASSERT(unsatisfiedRanges.size() > 0);
+                        // Expand the existing range to include it.
+                        unsatisfiedRanges.back().second = i;
+                    }
+                    else if (vs[i]->id == fixedSegmentID)
+                    {
+                        // Fixed connector segments can also start and 
+                        // extend unsatisfied variable ranges.
+                        if (unsatisfiedRanges.empty())
                         {
-                            // This is the left-hand-side of a channel.
-                            COLA_ASSERT(unsatisfiedRanges.size() > 0);
-                            // Expand the existing range to include it.
-                            unsatisfiedRanges.back().second = i;
+                            // There are no existing unsatisfied ranges,
+                            // so start a new unsatisfied range.
+                            unsatisfiedRanges.push_back(
+                                    std::make_pair(i, i));
                         }
-                        else if (vs[i]->id == fixedSegmentID)
+                        else
                         {
-                            // Fixed connector segments can also start and 
-                            // extend unsatisfied variable ranges.
-                            if (unsatisfiedRanges.empty())
-                            {
-                                // There are no existing unsatisfied ranges,
-                                // so start a new unsatisfied range.
-                                unsatisfiedRanges.push_back(
-                                        std::make_pair(i, i));
-                            }
-                            else
-                            {
-                                // Expand the existing range to include index.
-                                unsatisfiedRanges.back().second = i;
-                            }
+                            // Expand the existing range to include index.
+                            unsatisfiedRanges.back().second = i;
                         }
                     }
                 }
             }
+        }
 
 #ifdef NUDGE_DEBUG
-            if (!satisfied)
-            {
-                fprintf(stderr,"unsatisfied\n");
-            }
+        if (!satisfied)
+        {
+            fprintf(stderr,"unsatisfied\n");
+        }
 #endif
 
-            if (justUnifying)
-            {
-                // When we're centring, we'd like to greedily place as many
-                // segments as possible at the same positions, that way they
-                // have more accurate nudging orders determined for them.
-                // 
-                // We do this by taking pairs of adjoining free segments and 
-                // attempting to constrain them to have the same position, 
-                // starting from the closest up to the furthest.
-
-                if (justAddedConstraint)
-                {
-                    COLA_ASSERT(potentialConstraints.size() > 0);
-                    if (!satisfied)
-                    {
-                        // We couldn't satisfy the problem with the added
-                        // potential constraint, so we can't position these
-                        // segments together.  Roll back.
-                        potentialConstraints.pop_front();
-                        delete cs.back();
-                        cs.pop_back();
-                    }
-                    else
-                    {
-                        // We could position these two segments together.
-                        PotentialSegmentConstraint& pc =
-                                potentialConstraints.front();
-
-                        // Rewrite the indexes of these two variables to 
-                        // one, so we need not worry about redundant 
-                        // equality constraints.
-                        for (std::list<PotentialSegmentConstraint>::iterator
-                                it = potentialConstraints.begin();
-                                it != potentialConstraints.end(); ++it)
-                        {
-                            it->rewriteIndex(pc.index1, pc.index2);
-                        }
-                        potentialConstraints.pop_front();
-                    }
-                }
-                potentialConstraints.sort();
-                justAddedConstraint = false;
+        if (justUnifying)
+        {
+            // When we're centring, we'd like to greedily place as many
+            // segments as possible at the same positions, that way they
+            // have more accurate nudging orders determined for them.
+            // 
+            // We do this by taking pairs of adjoining free segments and 
+            // attempting to constrain them to have the same position, 
+            // starting from the closest up to the furthest.
 
-                // Remove now invalid potential segment constraints.
-                // This could have been caused by the variable rewriting.
-                while (!potentialConstraints.empty() && 
-                       !potentialConstraints.front().stillValid())
+            if (justAddedConstraint)
+            {
+                COLA_ASSERT(potentialConstraints.size() > 0);
+                if (!satisfied)
                 {
+                    // We couldn't satisfy the problem with the added
+                    // potential constraint, so we can't position these
+                    // segments together.  Roll back.
                     potentialConstraints.pop_front();
+                    delete cs.back();
+                    cs.pop_back();
                 }
-
-                if (!potentialConstraints.empty())
+                else
                 {
-                    // We still have more possibilities to consider.
-                    // Create a constraint for this, add it, and mark as
-                    // unsatisfied, so the problem gets re-solved.
+                    // We could position these two segments together.
                     PotentialSegmentConstraint& pc =
                             potentialConstraints.front();
-                    COLA_ASSERT(pc.index1 != pc.index2);
-                    cs.push_back(new Constraint(vs[pc.index1], vs[pc.index2],
-                            0, true));
-                    satisfied = false;
-                    justAddedConstraint = true;
+
+                    // Rewrite the indexes of these two variables to 
+                    // one, so we need not worry about redundant 
+                    // equality constraints.
+                    for (std::list<PotentialSegmentConstraint>::iterator
+                            it = potentialConstraints.begin();
+                            it != potentialConstraints.end(); ++it)
+                    {
+                        it->rewriteIndex(pc.index1, pc.index2);
+                    }
+                    potentialConstraints.pop_front();
                 }
             }
-            else
+            potentialConstraints.sort();
+            justAddedConstraint = false;
+
+            // Remove now invalid potential segment constraints.
+            // This could have been caused by the variable rewriting.
+            while (!potentialConstraints.empty() && 
+                   !potentialConstraints.front().stillValid())
             {
-                if (!satisfied)
-                {
-                    COLA_ASSERT(unsatisfiedRanges.size() > 0);
-                    // Reduce the separation distance.
-                    sepDist -= (baseSepDist / reductionSteps);
+                potentialConstraints.pop_front();
+            }
+
+            if (!potentialConstraints.empty())
+            {
+                // We still have more possibilities to consider.
+                // Create a constraint for this, add it, and mark as
+                // unsatisfied, so the problem gets re-solved.
+                PotentialSegmentConstraint& pc =
+                        potentialConstraints.front();
+                COLA_ASSERT(pc.index1 != pc.index2);
+                cs.push_back(new Constraint(vs[pc.index1], vs[pc.index2],
+                        0, true));
+                satisfied = false;
+                justAddedConstraint = true;
+            }
+        }
+        else
+        {
+            if (!satisfied)
+            {
+                COLA_ASSERT(unsatisfiedRanges.size() > 0);
+                // Reduce the separation distance.
+                sepDist -= (baseSepDist / reductionSteps);
 #ifdef NUDGE_DEBUG
-                    for (std::list<UnsatisfiedRange>::iterator it =
-                            unsatisfiedRanges.begin(); 
-                            it != unsatisfiedRanges.end(); ++it)
-                    {
-                        fprintf(stderr, "unsatisfiedVarRange(%ld, %ld)\n", 
-                                it->first, it->second);
-                    }
-                    fprintf(stderr, "unsatisfied, trying %g\n", sepDist);
+                for (std::list<UnsatisfiedRange>::iterator it =
+                        unsatisfiedRanges.begin(); 
+                        it != unsatisfiedRanges.end(); ++it)
+                {
+                    fprintf(stderr, "unsatisfiedVarRange(%ld, %ld)\n", 
+                            it->first, it->second);
+                }
+                fprintf(stderr, "unsatisfied, trying %g\n", sepDist);
 #endif
-                    // And rewrite all the gap constraints to have the new 
-                    // reduced separation distance.
-                    bool withinUnsatisfiedGroup = false;
-                    for (Constraints::iterator cIt = cs.begin(); 
-                            cIt != cs.end(); ++cIt)
-                    {
-                        UnsatisfiedRange& range = unsatisfiedRanges.front();
-                        Constraint *constraint = *cIt;
+                // And rewrite all the gap constraints to have the new 
+                // reduced separation distance.
+                bool withinUnsatisfiedGroup = false;
+                for (Constraints::iterator cIt = cs.begin(); 
+                        cIt != cs.end(); ++cIt)
+                {
+                    UnsatisfiedRange& range = unsatisfiedRanges.front();
+                    Constraint *constraint = *cIt;
 
-                        if (constraint->left == vs[range.first])
-                        {
-                            // Entered an unsatisfied range of variables.
-                            withinUnsatisfiedGroup = true;
-                        }
+                    if (constraint->left == vs[range.first])
+                    {
+                        // Entered an unsatisfied range of variables.
+                        withinUnsatisfiedGroup = true;
+                    }
 
-                        if (withinUnsatisfiedGroup && (constraint->gap > 0))
-                        {
-                            // Rewrite constraints in unsatisfied ranges 
-                            // that have a non-zero gap.
-                            constraint->gap = sepDist;
-                        }
-                        
-                        if (constraint->right == vs[range.second])
+                    if (withinUnsatisfiedGroup && (constraint->gap > 0))
+                    {
+                        // Rewrite constraints in unsatisfied ranges 
+                        // that have a non-zero gap.
+                        constraint->gap = sepDist;
+                    }
+                    
+                    if (constraint->right == vs[range.second])
+                    {
+                        // Left an unsatisfied range of variables.
+                        withinUnsatisfiedGroup = false;
+                        unsatisfiedRanges.pop_front();
+                        if (unsatisfiedRanges.empty())
                         {
-                            // Left an unsatisfied range of variables.
-                            withinUnsatisfiedGroup = false;
-                            unsatisfiedRanges.pop_front();
-                            if (unsatisfiedRanges.empty())
-                            {
-                                // And there are no more unsatisfied variables.
-                                break;
-                            }
+                            // And there are no more unsatisfied variables.
+                            break;
                         }
                     }
                 }
             }
         }
-        while (!satisfied && (sepDist > 0.0001));
+    }
+    while (!satisfied && (sepDist > 0.0001));
 
-        if (satisfied)
-        {
+    if (satisfied)
+    {
 #ifdef NUDGE_DEBUG
-            fprintf(stderr,"satisfied at nudgeDist = %g\n", sepDist);
+        fprintf(stderr,"satisfied at nudgeDist = %g\n", sepDist);
 #endif
-            for (ShiftSegmentList::iterator currSegment = currentRegion.begin();
-                    currSegment != currentRegion.end(); ++currSegment)
-            {
-                NudgingShiftSegment *segment =
-                        dynamic_cast<NudgingShiftSegment *> (*currSegment);
+        for (ShiftSegmentList::iterator currSegment = currentRegion.begin();
+                currSegment != currentRegion.end(); ++currSegment)
+        {
+            NudgingShiftSegment *segment =
+                    dynamic_cast<NudgingShiftSegment *> (*currSegment);
 
-                segment->updatePositionsFromSolver();
-            }
+            segment->updatePositionsFromSolver();
         }
+    }
 #ifdef NUDGE_DEBUG
-        for(unsigned i=0;i<vs.size();i++) {
-            fprintf(stderr, "+vs[%d]=%f\n",i,vs[i]->finalPosition);
-        }
+    for(unsigned i=0;i<vs.size();i++) {
+        fprintf(stderr, "+vs[%d]=%f\n",i,vs[i]->finalPosition);
+    }
 #endif
 #ifdef NUDGE_DEBUG_SVG
-        for (ShiftSegmentList::iterator currSegment = currentRegion.begin();
-                currSegment != currentRegion.end(); ++currSegment)
+    for (ShiftSegmentList::iterator currSegment = currentRegion.begin();
+            currSegment != currentRegion.end(); ++currSegment)
+    {
+        NudgingShiftSegment *segment =
+                dynamic_cast<NudgingShiftSegment *> (*currSegment);
+
+        fprintf(stdout, "<line style=\"stroke: #00F;\" x1=\"%g\" "
+                "y1=\"%g\" x2=\"%g\" y2=\"%g\" />\n",
+                segment->lowPoint()[XDIM], segment->variable->finalPosition,
+                segment->highPoint()[XDIM], segment->variable->finalPosition);
+    }
+#endif
+    for_each(currentRegion.begin(), currentRegion.end(), delete_object());
+    for_each(vs.begin(), vs.end(), delete_object());
+    for_each(cs.begin(), cs.end(), delete_object());
+}
+
+
+static void nudgeOrthogonalRoutes(Router *router, size_t dimension, 
+        PtOrderMap& pointOrders, ShiftSegmentList& segmentList, 
+        bool justUnifying = false)
+{
+    // Split the segments into regions of segments that overlap.
+    std::vector<ShiftSegmentList> regions;
+    ShiftSegmentList currentRegion;
+    while (!segmentList.empty())
+    {
+        // Take a reference segment
+        ShiftSegment *currentSegment = segmentList.front();
+        // Then, find the segments that overlap this one.
+        currentRegion.clear();
+        currentRegion.push_back(currentSegment);
+        segmentList.erase(segmentList.begin());
+        for (ShiftSegmentList::iterator curr = segmentList.begin();
+                curr != segmentList.end(); )
         {
-            NudgingShiftSegment *segment =
-                    dynamic_cast<NudgingShiftSegment *> (*currSegment);
+            bool overlaps = false;
+            for (ShiftSegmentList::iterator curr2 = currentRegion.begin();
+                    curr2 != currentRegion.end(); ++curr2)
+            {
+                if ((*curr)->overlapsWith(*curr2, dimension))
+                {
+                    overlaps = true;
+                    break;
+                }
+            }
+            if (overlaps)
+            {
+                currentRegion.push_back(*curr);
+                segmentList.erase(curr);
+                // Consider segments from the beginning, since we may have
+                // since passed segments that overlap with the new set.
+                curr = segmentList.begin();
+            }
+            else
+            {
+                ++curr;
+            }
+        }
+
+        regions.push_back(ShiftSegmentList());
+        regions.back().swap(currentRegion);
+    }
 
-            fprintf(stdout, "<line style=\"stroke: #00F;\" x1=\"%g\" "
-                    "y1=\"%g\" x2=\"%g\" y2=\"%g\" />\n",
-                    segment->lowPoint()[XDIM], segment->variable->finalPosition,
-                    segment->highPoint()[XDIM], segment->variable->finalPosition);
+    // Segments in different regions cannot be pushed into one another, so 
+    // the regions are nudged independently, in parallel.  The point orders
+    // are sorted beforehand, so that the regions only read them.
+    if (!justUnifying)
+    {
+        for (PtOrderMap::iterator it = pointOrders.begin(); 
+                it != pointOrders.end(); ++it)
+        {
+            it->second.sortIfRequired(dimension);
         }
+    }
+    const int n = regions.size();
+#ifdef _OPENMP
+    const int workers = (router->workerCount() > 0) ? 
+            (int) router->workerCount() : omp_get_num_procs();
+    #pragma omp parallel for schedule(dynamic) num_threads(workers) \
+            if((workers > 1) && (n > 1))
 #endif
-        for_each(currentRegion.begin(), currentRegion.end(), delete_object());
-        for_each(vs.begin(), vs.end(), delete_object());
-        for_each(cs.begin(), cs.end(), delete_object());
+    for (int i = 0; i < n; ++i)
+    {
+        nudgeOrthogonalRegion(router, dimension, pointOrders, regions[i],
+                justUnifying);
     }
 }
 
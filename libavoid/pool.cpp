@@ -0,0 +1,109 @@
+/*
+ * vim: ts=4 sw=4 et tw=0 wm=0
+ *
+ * libavoid - Fast, Incremental, Object-avoiding Line Router
+ *
+ * Copyright (C) 2026  Dunnart contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * See the file LICENSE.LGPL distributed with the library.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ *
+*/
+
+
+#include <algorithm>
+
+#include "libavoid/pool.h"
+#include "libavoid/assertions.h"
+
+namespace Avoid {
+
+
+BlockPool::BlockPool(const size_t objectSize, const size_t slabBlocks)
+    : m_block_size(sizeof(BlockHeader) + 
+              std::max(objectSize, sizeof(FreeBlock))),
+      m_slab_blocks(slabBlocks),
+      m_free_list(NULL),
+      m_object_allocations(0)
+{
+    // Keep the blocks following the first aligned as well.
+    m_block_size = ((m_block_size + sizeof(BlockHeader) - 1) / 
+            sizeof(BlockHeader)) * sizeof(BlockHeader);
+    COLA_ASSERT(m_slab_blocks > 0);
+}
+
+
+BlockPool::~BlockPool()
+{
+    for (size_t i = 0; i < m_slabs.size(); ++i)
+    {
+        delete [] m_slabs[i];
+    }
+}
+
+
+void *BlockPool::allocate(const size_t size)
+{
+    COLA_ASSERT(sizeof(BlockHeader) + size <= m_block_size);
+
+    if (m_free_list == NULL)
+    {
+        // Carve a new slab into free blocks, linked in address order.
+        // new[] returns memory suitably aligned for any object.
+        char *slab = new char[m_block_size * m_slab_blocks];
+        m_slabs.push_back(slab);
+        for (size_t i = m_slab_blocks; i > 0; --i)
+        {
+            char *block = slab + ((i - 1) * m_block_size);
+            FreeBlock *freeBlock = 
+                    (FreeBlock *) (block + sizeof(BlockHeader));
+            freeBlock->next = m_free_list;
+            m_free_list = freeBlock;
+        }
+    }
+
+    FreeBlock *freeBlock = m_free_list;
+    m_free_list = freeBlock->next;
+    BlockHeader *header = ((BlockHeader *) freeBlock) - 1;
+    header->pool = this;
+    ++m_object_allocations;
+    return freeBlock;
+}
+
+
+void BlockPool::deallocate(void *object)
+{
+    if (object == NULL)
+    {
+        return;
+    }
+    BlockHeader *header = ((BlockHeader *) object) - 1;
+    BlockPool *pool = header->pool;
+
+    FreeBlock *freeBlock = (FreeBlock *) object;
+    freeBlock->next = pool->m_free_list;
+    pool->m_free_list = freeBlock;
+}
+
+
+unsigned long BlockPool::objectAllocations(void) const
+{
+    return m_object_allocations;
+}
+
+
+unsigned long BlockPool::slabAllocations(void) const
+{
+    return m_slabs.size();
+}
+
+
+}
+
@@ -0,0 +1,82 @@
+/*
+ * vim: ts=4 sw=4 et tw=0 wm=0
+ *
+ * libavoid - Fast, Incremental, Object-avoiding Line Router
+ *
+ * Copyright (C) 2026  Dunnart contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * See the file LICENSE.LGPL distributed with the library.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ *
+*/
+
+#ifndef AVOID_POOL_H
+#define AVOID_POOL_H
+
+#include <cstddef>
+#include <vector>
+
+namespace Avoid {
+
+// This class is not intended for public use.
+// It hands out fixed-size blocks of memory for objects created and 
+// destroyed in large numbers, such as the vertices and edges of the
+// orthogonal visibility graph, which is rebuilt whenever a shape moves.
+// Blocks are carved from large slabs and freed blocks are kept for reuse,
+// so the system allocator is called once per slab rather than once per 
+// object.  Each block records its pool, so objects can be freed without 
+// knowing where they came from.  The slabs are released when the pool is 
+// destroyed.  A pool is not thread-safe, so objects must only be created
+// and destroyed while the router's graphs are being changed, and never by
+// the parallel path searches.
+class BlockPool
+{
+    public:
+        BlockPool(const size_t objectSize, const size_t slabBlocks = 1024);
+        ~BlockPool();
+
+        // Returns memory for an object of up to the pool's object size.
+        void *allocate(const size_t size);
+        // Frees memory for an object returned by allocate() on any pool.
+        static void deallocate(void *object);
+
+        // The number of objects and of slabs allocated over the life of 
+        // the pool.
+        unsigned long objectAllocations(void) const;
+        unsigned long slabAllocations(void) const;
+
+    private:
+        BlockPool(const BlockPool& other);
+        BlockPool& operator=(const BlockPool& other);
+
+        // A block holds its pool, padded to keep the object aligned, 
+        // then the object.  Free blocks are linked through their objects.
+        union BlockHeader
+        {
+            BlockPool *pool;
+            double alignDouble;
+            void *alignPointer;
+        };
+        struct FreeBlock
+        {
+            FreeBlock *next;
+        };
+
+        size_t m_block_size;
+        size_t m_slab_blocks;
+        std::vector<char *> m_slabs;
+        FreeBlock *m_free_list;
+        unsigned long m_object_allocations;
+};
+
+
+}
+
+#endif
@@ -26,6 +26,9 @@
 #include <algorithm>
 #include <cmath>
 #include <cfloat>
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
 
 #include "libavoid/shape.h"
 #include "libavoid/router.h"
@@ -44,7 +47,9 @@ namespace Avoid {
 
 
 Router::Router(const unsigned int flags)
-    : visOrthogGraph(true),
+    : m_vertex_pool(sizeof(VertInf)),
+      m_edge_pool(sizeof(EdgeInf)),
+      visOrthogGraph(true),
       PartialTime(false),
       SimpleRouting(false),
       ClusteredRouting(true),
@@ -67,7 +72,9 @@ Router::Router(const unsigned int flags)
       m_allows_polyline_routing(false),
       m_allows_orthogonal_routing(false),
       m_static_orthogonal_graph_invalidated(true),
-      m_in_crossing_rerouting_stage(false)
+      m_in_crossing_rerouting_stage(false),
+      m_worker_count(1),
+      m_telemetry_enabled(false)
 {
     // At least one of the Routing modes must be set.
     COLA_ASSERT(flags & (PolyLineRouting | OrthogonalRouting));
@@ -94,6 +101,7 @@ Router::Router(const unsigned int flags)
     m_routing_options[improveHyperedgeRoutesMovingJunctions] = true;
     m_routing_options[penaliseOrthogonalSharedPathsAtConnEnds] = false;
     m_routing_options[nudgeOrthogonalTouchingColinearSegments] = false;
+    m_routing_options[reuseUnaffectedOrthogonalRoutes] = false;
 
     m_hyperedge_rerouter.setRouter(this);
 }
@@ -102,6 +110,7 @@ Router::Router(const unsigned int flags)
 Router::~Router()
 {
     m_currently_calling_destructors = true;
+    visOrthogGraphSnapshot.clear();
 
     // Delete remaining connectors.
     ConnRefList::iterator conn = connRefs.begin();
@@ -147,12 +156,12 @@ void Router::modifyConnector(ConnRef *conn, const unsigned int type,
     ActionInfo modInfo(ConnChange, conn);
     
     ActionInfoList::iterator found = 
-            find(actionList.begin(), actionList.end(), modInfo);
+            findQueuedAction(modInfo.type, modInfo.objPtr);
     if (found == actionList.end())
     {
         // Matching action not found, so add.
         modInfo.conns.push_back(std::make_pair(type, connEnd));
-        actionList.push_back(modInfo);
+        queueAction(modInfo);
     }
     else
     {
@@ -172,10 +181,10 @@ void Router::modifyConnector(ConnRef *conn)
     ActionInfo modInfo(ConnChange, conn);
     
     ActionInfoList::iterator found = 
-            find(actionList.begin(), actionList.end(), modInfo);
+            findQueuedAction(modInfo.type, modInfo.objPtr);
     if (found == actionList.end())
     {
-        actionList.push_back(modInfo);
+        queueAction(modInfo);
     }
 
     if (!m_consolidate_actions)
@@ -190,10 +199,10 @@ void Router::modifyConnectionPin(ShapeConnectionPin *pin)
     ActionInfo modInfo(ConnectionPinChange, pin);
     
     ActionInfoList::iterator found = 
-            find(actionList.begin(), actionList.end(), modInfo);
+            findQueuedAction(modInfo.type, modInfo.objPtr);
     if (found == actionList.end())
     {
-        actionList.push_back(modInfo);
+        queueAction(modInfo);
     }
 
     if (!m_consolidate_actions)
@@ -205,38 +214,66 @@ void Router::modifyConnectionPin(ShapeConnectionPin *pin)
 
 void Router::removeObjectFromQueuedActions(const void *object)
 {
-    for (ActionInfoList::iterator curr = actionList.begin();
-            curr != actionList.end(); )
+    // There can be at most one queued action of each type for the object.
+    for (int type = ShapeMove; type <= ConnectionPinChange; ++type)
     {
-        if (curr->objPtr == object)
+        ActionInfoList::iterator found = 
+                findQueuedAction((ActionType) type, object);
+        if (found != actionList.end())
         {
-            curr = actionList.erase(curr);
-        }
-        else
-        {
-            ++curr;
+            eraseQueuedAction(found);
         }
     }
 }
 
 
+// Returns the queued action of the given type for an object, or the end
+// of the action list if there is none.
+ActionInfoList::iterator Router::findQueuedAction(const ActionType type,
+        const void *object)
+{
+    ActionInfoIndex::iterator found = 
+            actionIndex.find(std::make_pair(type, object));
+    if (found == actionIndex.end())
+    {
+        return actionList.end();
+    }
+    return found->second;
+}
+
+
+void Router::queueAction(const ActionInfo& action)
+{
+    COLA_ASSERT(findQueuedAction(action.type, action.objPtr) == 
+            actionList.end());
+    actionIndex[std::make_pair(action.type, (const void *) action.objPtr)] =
+            actionList.insert(actionList.end(), action);
+}
+
+
+void Router::eraseQueuedAction(ActionInfoList::iterator action)
+{
+    actionIndex.erase(std::make_pair(action->type, 
+            (const void *) action->objPtr));
+    actionList.erase(action);
+}
+
+
 void Router::addShape(ShapeRef *shape)
 {
     // There shouldn't be remove events or move events for the same shape
     // already in the action list.
     // XXX: Possibly we could handle this by ordering them intelligently.
-    COLA_ASSERT(find(actionList.begin(), actionList.end(), 
-                ActionInfo(ShapeRemove, shape)) == actionList.end());
-    COLA_ASSERT(find(actionList.begin(), actionList.end(), 
-                ActionInfo(ShapeMove, shape)) == actionList.end());
+    COLA_ASSERT(findQueuedAction(ShapeRemove, shape) == actionList.end());
+    COLA_ASSERT(findQueuedAction(ShapeMove, shape) == actionList.end());
 
     ActionInfo addInfo(ShapeAdd, shape);
     
     ActionInfoList::iterator found = 
-            find(actionList.begin(), actionList.end(), addInfo);
+            findQueuedAction(addInfo.type, addInfo.objPtr);
     if (found == actionList.end())
     {
-        actionList.push_back(addInfo);
+        queueAction(addInfo);
     }
 
     if (!m_consolidate_actions)
@@ -255,19 +292,18 @@ void Router::deleteShape(ShapeRef *shape)
     //            ActionInfo(ShapeAdd, shape)) == actionList.end());
 
     // Delete any ShapeMove entries for this shape in the action list.
-    ActionInfoList::iterator found = find(actionList.begin(), 
-            actionList.end(), ActionInfo(ShapeMove, shape));
+    ActionInfoList::iterator found = findQueuedAction(ShapeMove, shape);
     if (found != actionList.end())
     {
-        actionList.erase(found);
+        eraseQueuedAction(found);
     }
 
     // Add the ShapeRemove entry.
     ActionInfo remInfo(ShapeRemove, shape);
-    found = find(actionList.begin(), actionList.end(), remInfo);
+    found = findQueuedAction(remInfo.type, remInfo.objPtr);
     if (found == actionList.end())
     {
-        actionList.push_back(remInfo);
+        queueAction(remInfo);
     }
 
     if (!m_consolidate_actions)
@@ -286,9 +322,7 @@ void Router::deleteConnector(ConnRef *connector)
 
 void Router::moveShape(ShapeRef *shape, const double xDiff, const double yDiff)
 {
-    ActionInfo moveInfo(ShapeMove, shape, Polygon(), false);
-    ActionInfoList::iterator found =
-            find(actionList.begin(), actionList.end(), moveInfo);
+    ActionInfoList::iterator found = findQueuedAction(ShapeMove, shape);
 
     Polygon newPoly;
     if (found != actionList.end())
@@ -331,11 +365,9 @@ void Router::moveShape(ShapeRef *shape, const Polygon& newPoly,
     // There shouldn't be remove events or add events for the same shape
     // already in the action list.
     // XXX: Possibly we could handle this by ordering them intelligently.
-    COLA_ASSERT(find(actionList.begin(), actionList.end(), 
-                ActionInfo(ShapeRemove, shape)) == actionList.end());
+    COLA_ASSERT(findQueuedAction(ShapeRemove, shape) == actionList.end());
     
-    ActionInfoList::iterator found = find(actionList.begin(), 
-            actionList.end(), ActionInfo(ShapeAdd, shape));
+    ActionInfoList::iterator found = findQueuedAction(ShapeAdd, shape);
     if (found != actionList.end())
     {
         // The Add is enough, no need for the Move action too.
@@ -348,7 +380,7 @@ void Router::moveShape(ShapeRef *shape, const Polygon& newPoly,
     ActionInfo moveInfo(ShapeMove, shape, newPoly, first_move);
     // Sanely cope with the case where the user requests moving the same
     // shape multiple times before rerouting connectors.
-    found = find(actionList.begin(), actionList.end(), moveInfo);
+    found = findQueuedAction(moveInfo.type, moveInfo.objPtr);
 
     if (found != actionList.end())
     {
@@ -358,7 +390,7 @@ void Router::moveShape(ShapeRef *shape, const Polygon& newPoly,
     }
     else 
     {
-        actionList.push_back(moveInfo);
+        queueAction(moveInfo);
     }
 
     if (!m_consolidate_actions)
@@ -376,13 +408,18 @@ void Router::setStaticGraphInvalidated(const bool invalidated)
 
 void Router::destroyOrthogonalVisGraph(void)
 {
+    visOrthogGraphSnapshot.clear();
+
     // Remove orthogonal visibility graph edges.
     visOrthogGraph.clear();
 
-    // Remove the now orphaned vertices.
-    VertInf *curr = vertices.shapesBegin();
+    // Remove the now orphaned vertices.  Connection points are kept, but
+    // their orthogonal visibility properties are for where they were when
+    // the graph was built, so those are cleared for the new graph.
+    VertInf *curr = vertices.connsBegin();
     while (curr)
     {
+        curr->orthogVisPropFlags = 0;
         if (curr->orphaned() && (curr->id == dummyOrthogID))
         {
             VertInf *following = vertices.removeVertex(curr);
@@ -408,6 +445,7 @@ void Router::regenerateStaticBuiltGraph(void)
             timers.Register(tmOrthogGraph, timerStart);
             // Regenerate a new visibility graph.
             generateStaticOrthogonalVisGraph(this);
+            visOrthogGraphSnapshot.build(this);
             
             timers.Stop();
         }
@@ -416,6 +454,44 @@ void Router::regenerateStaticBuiltGraph(void)
 }
 
 
+void Router::setWorkerCount(const unsigned int workers)
+{
+    m_worker_count = workers;
+}
+
+
+unsigned int Router::workerCount(void) const
+{
+    return m_worker_count;
+}
+
+
+void Router::setTelemetryEnabled(const bool enabled)
+{
+    m_telemetry_enabled = enabled;
+}
+
+
+bool Router::telemetryEnabled(void) const
+{
+    return m_telemetry_enabled;
+}
+
+
+const TransactionTelemetry& Router::lastTransactionTelemetry(void) const
+{
+    return m_telemetry;
+}
+
+
+// Returns the wall-clock time when telemetry is enabled, otherwise zero,
+// so that the differences between readings are zero.
+double Router::telemetryClock(void) const
+{
+    return (m_telemetry_enabled) ? wallClockTime() : 0;
+}
+
+
 bool Router::transactionUse(void) const
 {
     return m_consolidate_actions;
@@ -504,6 +580,7 @@ void Router::processActions(void)
     {
         if (InvisibilityGrph)
         {
+            std::set<int> pids;
             for (curr = actionList.begin(); curr != finish; ++curr)
             {
                 ActionInfo& actInf = *curr;
@@ -515,10 +592,11 @@ void Router::processActions(void)
                     // Not a move or remove action, so don't do anything.
                     continue;
                 }
-
-                // o  Check all edges that were blocked by this shape.
-                checkAllBlockedEdges(actInf.obstacle()->id());
+                pids.insert(actInf.obstacle()->id());
             }
+
+            // o  Check all edges that were blocked by these shapes.
+            checkAllBlockedEdges(pids);
         }
         else
         {
@@ -602,6 +680,7 @@ void Router::processActions(void)
     }
     // Clear the actionList.
     actionList.clear();
+    actionIndex.clear();
 }
 
 bool Router::processTransaction(void)
@@ -613,11 +692,28 @@ bool Router::processTransaction(void)
         return false;
     }
 
+    // Changes to obstacles and pins require the whole static orthogonal 
+    // visibility graph to be rebuilt, however small the area they touch.
+    // Connector changes invalidate it themselves as they are processed, 
+    // only if they alter endpoints that are included in the graph.
+    for (ActionInfoList::const_iterator curr = actionList.begin();
+            curr != actionList.end(); ++curr)
+    {
+        if (curr->type != ConnChange)
+        {
+            m_static_orthogonal_graph_invalidated = true;
+            break;
+        }
+    }
+    m_telemetry = TransactionTelemetry();
+    const double transactionStart = telemetryClock();
+
     processActions();
+    m_telemetry.visibilityGraphTime += telemetryClock() - transactionStart;
 
-    m_static_orthogonal_graph_invalidated = true;
     rerouteAndCallbackConnectors();
 
+    m_telemetry.totalTime = telemetryClock() - transactionStart;
     return true;
 }
 
@@ -627,18 +723,17 @@ void Router::addJunction(JunctionRef *junction)
     // There shouldn't be remove events or move events for the same junction
     // already in the action list.
     // XXX: Possibly we could handle this by ordering them intelligently.
-    COLA_ASSERT(find(actionList.begin(), actionList.end(), 
-                ActionInfo(JunctionRemove, junction)) == actionList.end());
-    COLA_ASSERT(find(actionList.begin(), actionList.end(), 
-                ActionInfo(JunctionMove, junction)) == actionList.end());
+    COLA_ASSERT(findQueuedAction(JunctionRemove, junction) == 
+                actionList.end());
+    COLA_ASSERT(findQueuedAction(JunctionMove, junction) == actionList.end());
 
     ActionInfo addInfo(JunctionAdd, junction);
     
     ActionInfoList::iterator found = 
-            find(actionList.begin(), actionList.end(), addInfo);
+            findQueuedAction(addInfo.type, addInfo.objPtr);
     if (found == actionList.end())
     {
-        actionList.push_back(addInfo);
+        queueAction(addInfo);
     }
 
     if (!m_consolidate_actions)
@@ -653,23 +748,21 @@ void Router::deleteJunction(JunctionRef *junction)
     // There shouldn't be add events events for the same junction already 
     // in the action list.
     // XXX: Possibly we could handle this by ordering them intelligently.
-    COLA_ASSERT(find(actionList.begin(), actionList.end(), 
-                ActionInfo(JunctionAdd, junction)) == actionList.end());
+    COLA_ASSERT(findQueuedAction(JunctionAdd, junction) == actionList.end());
 
     // Delete any ShapeMove entries for this shape in the action list.
-    ActionInfoList::iterator found = find(actionList.begin(), 
-            actionList.end(), ActionInfo(JunctionMove, junction));
+    ActionInfoList::iterator found = findQueuedAction(JunctionMove, junction);
     if (found != actionList.end())
     {
-        actionList.erase(found);
+        eraseQueuedAction(found);
     }
 
     // Add the ShapeRemove entry.
     ActionInfo remInfo(JunctionRemove, junction);
-    found = find(actionList.begin(), actionList.end(), remInfo);
+    found = findQueuedAction(remInfo.type, remInfo.objPtr);
     if (found == actionList.end())
     {
-        actionList.push_back(remInfo);
+        queueAction(remInfo);
     }
 
     if (!m_consolidate_actions)
@@ -682,9 +775,8 @@ void Router::deleteJunction(JunctionRef *junction)
 void Router::moveJunction(JunctionRef *junction, const double xDiff, 
         const double yDiff)
 {
-    ActionInfo moveInfo(JunctionMove, junction, Point());
-    ActionInfoList::iterator found =
-            find(actionList.begin(), actionList.end(), moveInfo);
+    ActionInfoList::iterator found = 
+            findQueuedAction(JunctionMove, junction);
 
     Point newPosition;
     if (found != actionList.end())
@@ -709,11 +801,10 @@ void Router::moveJunction(JunctionRef *junction, const Point& newPosition)
     // There shouldn't be remove events or add events for the same junction
     // already in the action list.
     // XXX: Possibly we could handle this by ordering them intelligently.
-    COLA_ASSERT(find(actionList.begin(), actionList.end(), 
-                ActionInfo(JunctionRemove, junction)) == actionList.end());
+    COLA_ASSERT(findQueuedAction(JunctionRemove, junction) == 
+                actionList.end());
     
-    ActionInfoList::iterator found = find(actionList.begin(), 
-            actionList.end(), ActionInfo(JunctionAdd, junction));
+    ActionInfoList::iterator found = findQueuedAction(JunctionAdd, junction);
     if (found != actionList.end())
     {
         // The Add is enough, no need for the Move action too.
@@ -725,7 +816,7 @@ void Router::moveJunction(JunctionRef *junction, const Point& newPosition)
     ActionInfo moveInfo(JunctionMove, junction, newPosition);
     // Sanely cope with the case where the user requests moving the same
     // shape multiple times before rerouting connectors.
-    found = find(actionList.begin(), actionList.end(), moveInfo);
+    found = findQueuedAction(moveInfo.type, moveInfo.objPtr);
 
     if (found != actionList.end())
     {
@@ -734,7 +825,7 @@ void Router::moveJunction(JunctionRef *junction, const Point& newPosition)
     }
     else 
     {
-        actionList.push_back(moveInfo);
+        queueAction(moveInfo);
     }
 
     if (!m_consolidate_actions)
@@ -895,7 +986,9 @@ void Router::rerouteAndCallbackConnectors(void)
     this->m_conn_reroute_flags.alertConns();
 
     // Updating the orthogonal visibility graph if necessary. 
+    double phaseStart = telemetryClock();
     regenerateStaticBuiltGraph();
+    m_telemetry.visibilityGraphTime += telemetryClock() - phaseStart;
 
     for (ConnRefList::const_iterator i = connRefs.begin(); i != fin; ++i) 
     {
@@ -909,6 +1002,13 @@ void Router::rerouteAndCallbackConnectors(void)
             m_hyperedge_rerouter.calcHyperedgeConnectors();
 
     timers.Register(tmOrthogRoute, timerStart);
+    phaseStart = telemetryClock();
+    // Connectors whose path searches are independent of the other routes
+    // are gathered into batches and searched for together, the batch being
+    // ended by any connector that has to be routed on its own.
+    std::vector<ConnRef *> batch;
+    // Connectors not given a cached route, whose new routes are cached.
+    std::vector<ConnRef *> searchedConns;
     for (ConnRefList::const_iterator i = connRefs.begin(); i != fin; ++i) 
     {
         if (hyperedgeConns.find(*i) != hyperedgeConns.end())
@@ -918,28 +1018,65 @@ void Router::rerouteAndCallbackConnectors(void)
         }
 
         (*i)->m_needs_repaint = false;
-        bool rerouted = (*i)->generatePath();
-        if (rerouted)
+        if (!(*i)->needsPathGeneration())
+        {
+            continue;
+        }
+        reroutedConns.push_back(*i);
+        if (reuseCachedRoute(*i))
+        {
+            continue;
+        }
+        searchedConns.push_back(*i);
+        if ((*i)->hasIndependentPathSearch())
+        {
+            batch.push_back(*i);
+        }
+        else
         {
-            reroutedConns.push_back(*i);
+            generatePaths(batch);
+            batch.clear();
+            (*i)->generatePath();
         }
     }
+    generatePaths(batch);
+    for (size_t i = 0; i < searchedConns.size(); ++i)
+    {
+        cacheRoute(searchedConns[i]);
+    }
     timers.Stop();
-
+    m_telemetry.pathSearchTime += telemetryClock() - phaseStart;
+    m_telemetry.connectorsRerouted = reroutedConns.size();
+    m_telemetry.connectorsSearched = searchedConns.size();
 
     // Perform any complete hyperedge rerouting that has been requested.
+    phaseStart = telemetryClock();
     m_hyperedge_rerouter.performRerouting();
+    m_telemetry.hyperedgeTime += telemetryClock() - phaseStart;
 
     // Find and reroute crossing connectors if crossing penalties are set.
+    phaseStart = telemetryClock();
     improveCrossings();
+    m_telemetry.crossingTime += telemetryClock() - phaseStart;
 
     if (routingOption(improveHyperedgeRoutesMovingJunctions))
     {
+        phaseStart = telemetryClock();
         improveHyperedgeRoutes(this);
+        m_telemetry.hyperedgeTime += telemetryClock() - phaseStart;
+    }
+
+    // Each path search counts the nodes it expands against its connector.
+    for (ConnRefList::const_iterator i = connRefs.begin(); i != fin; ++i) 
+    {
+        m_telemetry.pathSearchExpansions += (*i)->m_search_expansions;
+        (*i)->m_search_expansions = 0;
     }
 
     // Perform centring and nudging for orthogonal routes.
+    phaseStart = telemetryClock();
     improveOrthogonalRoutes(this);
+    m_telemetry.nudgingTime += telemetryClock() - phaseStart;
 
     // Alert connectors that they need redrawing.
     fin = reroutedConns.end();
@@ -950,6 +1087,281 @@ void Router::rerouteAndCallbackConnectors(void)
     }
 }
 
+
+// Generates the paths for the given connectors, as generatePath() would if
+// called on each in turn.  Each path search only reads the visibility graph
+// and its own connector, so the searches are run in parallel.  Everything
+// that changes the graph or other objects, i.e., setting up pin visibility,
+// recording edge users and storing the routes, is done before and after 
+// the searches, in connector order.
+void Router::generatePaths(const std::vector<ConnRef *>& conns)
+{
+    const int n = conns.size();
+    if (n == 0)
+    {
+        return;
+    }
+
+    std::vector<std::pair<bool, bool> > isDummyAtEnd(n);
+    for (int i = 0; i < n; ++i)
+    {
+        isDummyAtEnd[i] = conns[i]->beginPathGeneration();
+    }
+
+    // The graph is unchanged during the searches, so orthogonal routing 
+    // can use the contiguous snapshot of it, once the vertices and edges
+    // added for these connectors are included.
+    if (m_allows_orthogonal_routing)
+    {
+        visOrthogGraphSnapshot.refresh(this);
+    }
+
+    std::vector<std::vector<Point> > paths(n);
+    std::vector<std::vector<VertInf *> > vertices(n);
+#ifdef _OPENMP
+    const int workers = (m_worker_count > 0) ? 
+            (int) m_worker_count : omp_get_num_procs();
+    #pragma omp parallel for schedule(dynamic) num_threads(workers) \
+            if((workers > 1) && (n > 1))
+#endif
+    for (int i = 0; i < n; ++i)
+    {
+        conns[i]->generateStandardPath(paths[i], vertices[i]);
+    }
+
+    for (int i = 0; i < n; ++i)
+    {
+        conns[i]->finishPathGeneration(paths[i], vertices[i], 
+                isDummyAtEnd[i]);
+    }
+}
+
+// Accumulates a 64-bit FNV-1a hash of the values making up a route cache
+// fingerprint.
+class FingerprintHash
+{
+    public:
+        FingerprintHash()
+            : value(14695981039346656037ULL)
+        {
+        }
+        void add(const void *data, const size_t size)
+        {
+            const unsigned char *bytes = (const unsigned char *) data;
+            for (size_t i = 0; i < size; ++i)
+            {
+                value ^= bytes[i];
+                value *= 1099511628211ULL;
+            }
+        }
+        void add(const double number)
+        {
+            add(&number, sizeof(number));
+        }
+        void add(const unsigned int number)
+        {
+            add(&number, sizeof(number));
+        }
+        void add(const Point& point)
+        {
+            add(point.x);
+            add(point.y);
+        }
+
+        unsigned long long value;
+};
+
+
+// Returns whether connector routes may be cached.  Only independently 
+// searched orthogonal routes are, and only while the cost of a route does
+// not depend on the other connectors' routes.
+bool Router::routeCacheApplies(const ConnRef *conn) const
+{
+    if (!m_routing_options[reuseUnaffectedOrthogonalRoutes] ||
+            (conn->routingType() != ConnType_Orthogonal) ||
+            !conn->hasIndependentPathSearch())
+    {
+        return false;
+    }
+    if ((m_routing_parameters[crossingPenalty] > 0) ||
+            (m_routing_parameters[fixedSharedPathPenalty] > 0))
+    {
+        return false;
+    }
+    if (ClusteredRouting && !clusterRefs.empty() && 
+            (m_routing_parameters[clusterCrossingPenalty] > 0))
+    {
+        return false;
+    }
+    return true;
+}
+
+
+// Returns a fingerprint of everything the path search for conn depends 
+// upon within the given corridor.  Orthogonal visibility edges run the 
+// width of the diagram, so this includes every obstacle and connection 
+// point level with the corridor in either dimension, since these can add,
+// block or split edges crossing the corridor.
+unsigned long long Router::routeFingerprint(const ConnRef *conn, 
+        const Box& corridor)
+{
+    FingerprintHash hash;
+
+    hash.add(m_routing_parameters, sizeof(m_routing_parameters));
+    hash.add(m_routing_options, sizeof(m_routing_options));
+
+    hash.add(conn->src()->point);
+    hash.add(conn->src()->visDirections);
+    hash.add(conn->dst()->point);
+    hash.add(conn->dst()->visDirections);
+    std::vector<Point> pinPoints;
+    if (conn->m_src_connend)
+    {
+        pinPoints = conn->m_src_connend->possiblePinPoints();
+    }
+    hash.add((unsigned int) pinPoints.size());
+    for (size_t i = 0; i < pinPoints.size(); ++i)
+    {
+        hash.add(pinPoints[i]);
+    }
+    pinPoints = conn->possibleDstPinPoints();
+    hash.add((unsigned int) pinPoints.size());
+    for (size_t i = 0; i < pinPoints.size(); ++i)
+    {
+        hash.add(pinPoints[i]);
+    }
+
+    for (ObstacleList::const_iterator it = m_obstacles.begin(); 
+            it != m_obstacles.end(); ++it)
+    {
+        Obstacle *obstacle = *it;
+        Box box = obstacle->routingBox();
+        if (((box.max.x < corridor.min.x) || (box.min.x > corridor.max.x)) &&
+            ((box.max.y < corridor.min.y) || (box.min.y > corridor.max.y)))
+        {
+            continue;
+        }
+        hash.add(obstacle->id());
+        hash.add(box.min);
+        hash.add(box.max);
+        JunctionRef *junction = dynamic_cast<JunctionRef *> (obstacle);
+        hash.add((unsigned int) (junction && junction->positionFixed()));
+    }
+
+    // Connector endpoints, checkpoints and connection pins with visibility.
+    for (VertInf *curr = vertices.connsBegin(); 
+            curr && (curr != vertices.shapesBegin()); curr = curr->lstNext)
+    {
+        const Point& point = curr->point;
+        if ((curr->visDirections == ConnDirNone) ||
+            (((point.x < corridor.min.x) || (point.x > corridor.max.x)) &&
+             ((point.y < corridor.min.y) || (point.y > corridor.max.y))))
+        {
+            continue;
+        }
+        hash.add(point);
+        hash.add(curr->visDirections);
+    }
+    return hash.value;
+}
+
+
+// Replaces a path search for conn with its cached route, if the route is
+// unaffected by the changes since it was found.  Returns whether it did.
+bool Router::reuseCachedRoute(ConnRef *conn)
+{
+    if (!routeCacheApplies(conn))
+    {
+        return false;
+    }
+    RouteCache::iterator cached = m_route_cache.find(conn);
+    bool hit = (cached != m_route_cache.end()) && 
+            (routeFingerprint(conn, cached->second.corridor) == 
+             cached->second.fingerprint);
+    timers.CountRouteCacheLookup(hit);
+    if (!hit)
+    {
+        return false;
+    }
+
+    // Leave the connector as finishPathGeneration() would have.
+    conn->m_needs_reroute_flag = false;
+    conn->m_false_path = true;
+    conn->freeRoutes();
+    conn->m_route = cached->second.route;
+    if (cached->second.srcPinVertex)
+    {
+        conn->m_src_connend->usePinVertex(cached->second.srcPinVertex);
+    }
+    if (cached->second.dstPinVertex)
+    {
+        conn->m_dst_connend->usePinVertex(cached->second.dstPinVertex);
+    }
+    return true;
+}
+
+
+// Caches the route just found for conn.  Any route at least as good has 
+// a cost no greater, so no longer a length, and so lies within the 
+// corridor around the ends that is half the spare length wide.
+void Router::cacheRoute(ConnRef *conn)
+{
+    if (!routeCacheApplies(conn) || conn->m_needs_reroute_flag)
+    {
+        // Not cacheable, or there was no valid path.
+        m_route_cache.erase(conn);
+        return;
+    }
+
+    std::vector<Point> srcPoints;
+    if (conn->m_src_connend)
+    {
+        srcPoints = conn->m_src_connend->possiblePinPoints();
+    }
+    srcPoints.push_back(conn->src()->point);
+    std::vector<Point> dstPoints = conn->possibleDstPinPoints();
+    dstPoints.push_back(conn->dst()->point);
+
+    CachedRoute& cached = m_route_cache[conn];
+    cached.corridor.min = cached.corridor.max = srcPoints[0];
+    double endsDist = DBL_MAX;
+    for (size_t i = 0; i < srcPoints.size(); ++i)
+    {
+        for (size_t j = 0; j < dstPoints.size(); ++j)
+        {
+            endsDist = std::min(endsDist, 
+                    manhattanDist(srcPoints[i], dstPoints[j]));
+        }
+    }
+    srcPoints.insert(srcPoints.end(), dstPoints.begin(), dstPoints.end());
+    for (size_t i = 0; i < srcPoints.size(); ++i)
+    {
+        for (size_t dim = 0; dim < 2; ++dim)
+        {
+            cached.corridor.min[dim] = 
+                    std::min(cached.corridor.min[dim], srcPoints[i][dim]);
+            cached.corridor.max[dim] = 
+                    std::max(cached.corridor.max[dim], srcPoints[i][dim]);
+        }
+    }
+    const double spare = std::max(conn->m_search_cost - endsDist, 0.0) / 2;
+    for (size_t dim = 0; dim < 2; ++dim)
+    {
+        cached.corridor.min[dim] -= spare;
+        cached.corridor.max[dim] += spare;
+    }
+
+    cached.route = conn->m_route;
+    cached.fingerprint = routeFingerprint(conn, cached.corridor);
+    cached.srcPinVertex = (conn->m_src_connend && 
+            conn->m_src_connend->m_active_pin) ?
+            conn->m_src_connend->m_active_pin->m_vertex : NULL;
+    cached.dstPinVertex = (conn->m_dst_connend && 
+            conn->m_dst_connend->m_active_pin) ?
+            conn->m_dst_connend->m_active_pin->m_vertex : NULL;
+}
+
+
 // Type holding a cost estimate and ConnRef.
 typedef std::pair<double, ConnRef *> ConnCostRef;
 
@@ -1027,6 +1439,92 @@ static bool connsKnownToCross(ConnCostRefSetList &setList, ConnCostRef conn1,
 }
 
 
+class CmpRouteBoxMinX
+{
+    public:
+        CmpRouteBoxMinX(const std::vector<Box>& boxes)
+            : boxes(boxes)
+        {
+        }
+        bool operator() (const size_t u, const size_t v) const
+        {
+            return (boxes[u].min.x < boxes[v].min.x);
+        }
+        const std::vector<Box>& boxes;
+};
+
+
+// For each route, finds the later routes in the list whose bounding boxes
+// intersect its own, using a sweep along the x-dimension.  Routes with 
+// disjoint bounding boxes cannot cross, touch or share a path, so only 
+// these pairs need be checked in detail.  Each list is in increasing 
+// order, so pairs are visited in the same order as by a nested loop over 
+// every pair of routes.  Empty routes have no candidates.
+static void findIntersectingRoutePairs(const std::vector<Polygon *>& routes,
+        std::vector<std::vector<size_t> >& later)
+{
+    const size_t n = routes.size();
+    std::vector<Box> boxes(n);
+    std::vector<size_t> order;
+    order.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (routes[i]->empty())
+        {
+            continue;
+        }
+        boxes[i] = routes[i]->offsetBoundingBox(0.0);
+        order.push_back(i);
+    }
+    std::sort(order.begin(), order.end(), CmpRouteBoxMinX(boxes));
+
+    later.assign(n, std::vector<size_t>());
+    std::vector<size_t> active;
+    for (size_t k = 0; k < order.size(); ++k)
+    {
+        const size_t curr = order[k];
+        const Box& currBox = boxes[curr];
+        size_t kept = 0;
+        for (size_t a = 0; a < active.size(); ++a)
+        {
+            const size_t other = active[a];
+            const Box& otherBox = boxes[other];
+            if (otherBox.max.x < currBox.min.x)
+            {
+                // This route lies wholly before the sweep position.
+                continue;
+            }
+            active[kept++] = other;
+            if ((otherBox.min.y <= currBox.max.y) && 
+                    (currBox.min.y <= otherBox.max.y))
+            {
+                later[std::min(curr, other)].push_back(std::max(curr, other));
+            }
+        }
+        active.resize(kept);
+        active.push_back(curr);
+    }
+    for (size_t i = 0; i < n; ++i)
+    {
+        std::sort(later[i].begin(), later[i].end());
+    }
+}
+
+
+// As above, for the display routes of the given connectors.
+static void findIntersectingDisplayRoutePairs(
+        const std::vector<ConnRef *>& conns, 
+        std::vector<std::vector<size_t> >& later)
+{
+    std::vector<Polygon *> routes(conns.size());
+    for (size_t i = 0; i < conns.size(); ++i)
+    {
+        routes[i] = &(conns[i]->displayRoute());
+    }
+    findIntersectingRoutePairs(routes, later);
+}
+
+
 static double cheapEstimatedCost(ConnRef *lineRef)
 {
     const PolyLine& route = lineRef->route();
@@ -1113,21 +1611,30 @@ void Router::improveCrossings(void)
     m_in_crossing_rerouting_stage = true;
     ConnCostRefSet crossingConns;
     ConnCostRefSetList fixedSharedPathConns;
-    ConnRefList::iterator fin = connRefs.end();
-    for (ConnRefList::iterator i = connRefs.begin(); i != fin; ++i) 
+    std::vector<ConnRef *> conns(connRefs.begin(), connRefs.end());
+    std::vector<Polygon *> routes(conns.size());
+    for (size_t i = 0; i < conns.size(); ++i)
     {
-        Avoid::Polygon& iRoute = (*i)->routeRef();
-        if (iRoute.size() == 0)
+        routes[i] = &(conns[i]->routeRef());
+    }
+    // Rerouted hyperedges will have an empty route.  We can't reroute 
+    // these, so they have no candidate pairs.
+    std::vector<std::vector<size_t> > candidates;
+    findIntersectingRoutePairs(routes, candidates);
+    for (size_t i = 0; i < conns.size(); ++i) 
+    {
+        if (candidates[i].empty())
         {
-            // Rerouted hyperedges will have an empty route.
-            // We can't reroute these.
             continue;
         }
-        ConnCostRef iCostRef = std::make_pair(cheapEstimatedCost(*i), *i);
-        ConnRefList::iterator j = i;
-        for (++j; j != fin; ++j) 
+        Avoid::Polygon& iRoute = *routes[i];
+        ConnCostRef iCostRef = 
+                std::make_pair(cheapEstimatedCost(conns[i]), conns[i]);
+        for (size_t c = 0; c < candidates[i].size(); ++c) 
         {
-            ConnCostRef jCostRef = std::make_pair(cheapEstimatedCost(*j), *j);
+            const size_t j = candidates[i][c];
+            ConnCostRef jCostRef = 
+                    std::make_pair(cheapEstimatedCost(conns[j]), conns[j]);
             if (connsKnownToCross(fixedSharedPathConns, iCostRef, jCostRef) ||
                     (crossingConns.count(iCostRef) && 
                      crossingConns.count(jCostRef)))
@@ -1136,8 +1643,8 @@ void Router::improveCrossings(void)
                 continue;
             }
             // Determine if this pair cross.
-            Avoid::Polygon& jRoute = (*j)->routeRef();
-            ConnectorCrossings cross(iRoute, true, jRoute, *i, *j);
+            Avoid::Polygon& jRoute = *routes[j];
+            ConnectorCrossings cross(iRoute, true, jRoute, conns[i], conns[j]);
             for (size_t jInd = 1; jInd < jRoute.size(); ++jInd)
             {
                 const bool finalSegment = ((jInd + 1) == jRoute.size());
@@ -1279,12 +1786,19 @@ void Router::improveCrossings(void)
             }
         }
     }
+    // The count of rerouted connectors started from one.
+    m_telemetry.crossingConnectorsRerouted = numOfConnsRerouted - 1;
     m_in_crossing_rerouting_stage = false;
 }
 
 
 void Router::newBlockingShape(const Polygon& poly, int pid)
 {
+    // An edge can only be blocked by the shape, or have an endpoint 
+    // inside it, if the edge's bounding box overlaps the shape's.  This 
+    // cheap test rules out all but the edges passing near the shape.
+    const Box polyBox = poly.offsetBoundingBox(0.0);
+
     // o  Check all visibility edges to see if this one shape
     //    blocks them.
     EdgeInf *finish = visGraph.end();
@@ -1301,6 +1815,14 @@ void Router::newBlockingShape(const Polygon& poly, int pid)
             std::pair<Point, Point> points(tmp->points());
             Point e1 = points.first;
             Point e2 = points.second;
+            if ((std::max(e1.x, e2.x) < polyBox.min.x) ||
+                    (std::min(e1.x, e2.x) > polyBox.max.x) ||
+                    (std::max(e1.y, e2.y) < polyBox.min.y) ||
+                    (std::min(e1.y, e2.y) > polyBox.max.y))
+            {
+                // The edge doesn't pass near the shape.
+                continue;
+            }
             bool blocked = false;
 
             bool countBorder = false;
@@ -1348,10 +1870,17 @@ void Router::newBlockingShape(const Polygon& poly, int pid)
 }
 
 
-void Router::checkAllBlockedEdges(int pid)
+// Rechecks the invisibility edges blocked by any of the given shapes, 
+// which have been moved or removed, in a single pass over the edges.
+void Router::checkAllBlockedEdges(const std::set<int>& pids)
 {
     COLA_ASSERT(InvisibilityGrph);
 
+    if (pids.empty())
+    {
+        return;
+    }
+
     for (EdgeInf *iter = invisGraph.begin(); iter != invisGraph.end() ; )
     {
         EdgeInf *tmp = iter;
@@ -1362,7 +1891,7 @@ void Router::checkAllBlockedEdges(int pid)
             tmp->alertConns();
             tmp->checkVis();
         }
-        else if (tmp->blocker() == pid)
+        else if (pids.find(tmp->blocker()) != pids.end())
         {
             tmp->checkVis();
         }
@@ -1751,6 +2280,13 @@ void Router::setRoutingParameter(const RoutingParameter parameter,
     {
         m_routing_parameters[parameter] = value;
     }
+
+    if (parameter == shapeBufferDistance)
+    {
+        // Obstacles are given this buffer in the orthogonal visibility
+        // graph.
+        m_static_orthogonal_graph_invalidated = true;
+    }
 }
 
 
@@ -1897,16 +2433,23 @@ static void reduceRange(double& val)
 
 bool Router::existsOrthogonalPathOverlap(const bool atEnds)
 {
-    ConnRefList::iterator fin = connRefs.end();
-    for (ConnRefList::iterator i = connRefs.begin(); i != fin; ++i) 
+    std::vector<ConnRef *> conns(connRefs.begin(), connRefs.end());
+    std::vector<std::vector<size_t> > candidates;
+    findIntersectingDisplayRoutePairs(conns, candidates);
+    for (size_t i = 0; i < conns.size(); ++i) 
     {
-        Avoid::Polygon iRoute = (*i)->displayRoute();
-        ConnRefList::iterator j = i;
-        for (++j; j != fin; ++j) 
+        if (candidates[i].empty())
+        {
+            continue;
+        }
+        Avoid::Polygon iRoute = conns[i]->displayRoute();
+        for (size_t c = 0; c < candidates[i].size(); ++c) 
         {
             // Determine if this pair overlap
-            Avoid::Polygon jRoute = (*j)->displayRoute();
-            ConnectorCrossings cross(iRoute, true, jRoute, *i, *j);
+            ConnRef *jConnRef = conns[candidates[i][c]];
+            Avoid::Polygon jRoute = jConnRef->displayRoute();
+            ConnectorCrossings cross(iRoute, true, jRoute, conns[i], 
+                    jConnRef);
             cross.checkForBranchingSegments = true;
             for (size_t jInd = 1; jInd < jRoute.size(); ++jInd)
             {
@@ -1931,16 +2474,23 @@ bool Router::existsOrthogonalPathOverlap(const bool atEnds)
 
 bool Router::existsOrthogonalTouchingPaths(void)
 {
-    ConnRefList::iterator fin = connRefs.end();
-    for (ConnRefList::iterator i = connRefs.begin(); i != fin; ++i) 
+    std::vector<ConnRef *> conns(connRefs.begin(), connRefs.end());
+    std::vector<std::vector<size_t> > candidates;
+    findIntersectingDisplayRoutePairs(conns, candidates);
+    for (size_t i = 0; i < conns.size(); ++i) 
     {
-        Avoid::Polygon iRoute = (*i)->displayRoute();
-        ConnRefList::iterator j = i;
-        for (++j; j != fin; ++j) 
+        if (candidates[i].empty())
+        {
+            continue;
+        }
+        Avoid::Polygon iRoute = conns[i]->displayRoute();
+        for (size_t c = 0; c < candidates[i].size(); ++c) 
         {
             // Determine if this pair overlap
-            Avoid::Polygon jRoute = (*j)->displayRoute();
-            ConnectorCrossings cross(iRoute, true, jRoute, *i, *j);
+            ConnRef *jConnRef = conns[candidates[i][c]];
+            Avoid::Polygon jRoute = jConnRef->displayRoute();
+            ConnectorCrossings cross(iRoute, true, jRoute, conns[i], 
+                    jConnRef);
             cross.checkForBranchingSegments = true;
             for (size_t jInd = 1; jInd < jRoute.size(); ++jInd)
             {
@@ -1968,17 +2518,23 @@ bool Router::existsOrthogonalTouchingPaths(void)
 int Router::existsCrossings(const bool optimisedForConnectorType)
 {
     int count = 0;
-    ConnRefList::iterator fin = connRefs.end();
-    for (ConnRefList::iterator i = connRefs.begin(); i != fin; ++i) 
+    std::vector<ConnRef *> conns(connRefs.begin(), connRefs.end());
+    std::vector<std::vector<size_t> > candidates;
+    findIntersectingDisplayRoutePairs(conns, candidates);
+    for (size_t i = 0; i < conns.size(); ++i) 
     {
-        Avoid::Polygon iRoute = (*i)->displayRoute();
-        ConnRefList::iterator j = i;
-        for (++j; j != fin; ++j) 
+        if (candidates[i].empty())
+        {
+            continue;
+        }
+        Avoid::Polygon iRoute = conns[i]->displayRoute();
+        for (size_t c = 0; c < candidates[i].size(); ++c) 
         {
             // Determine if this pair overlap
-            Avoid::Polygon jRoute = (*j)->displayRoute();
-            ConnRef *iConn = (optimisedForConnectorType) ? *i : NULL;
-            ConnRef *jConn = (optimisedForConnectorType) ? *j : NULL;
+            ConnRef *jConnRef = conns[candidates[i][c]];
+            Avoid::Polygon jRoute = jConnRef->displayRoute();
+            ConnRef *iConn = (optimisedForConnectorType) ? conns[i] : NULL;
+            ConnRef *jConn = (optimisedForConnectorType) ? jConnRef : NULL;
             ConnectorCrossings cross(iRoute, true, jRoute, iConn, jConn);
             cross.checkForBranchingSegments = true;
             for (size_t jInd = 1; jInd < jRoute.size(); ++jInd)
@@ -2025,6 +2581,160 @@ bool Router::existsInvalidOrthogonalPaths(void)
 }
 
 
+// Describes an orthogonal visibility graph edge, as seen from one of its 
+// vertices, by the positions and properties of the vertices, so that the 
+// edges of separately generated graphs can be compared.
+class OrthogEdgeDescription
+{
+    public:
+        OrthogEdgeDescription(const VertInf *vert, const VisNeighbour& edge)
+            : point(vert->point),
+              otherPoint(edge.vert->point),
+              propFlags(vert->orthogVisPropFlags),
+              otherPropFlags(edge.vert->orthogVisPropFlags),
+              dist(edge.dist),
+              disabled(edge.isDisabled)
+        {
+        }
+        bool operator<(const OrthogEdgeDescription& rhs) const
+        {
+            if (point != rhs.point)
+            {
+                return point < rhs.point;
+            }
+            if (otherPoint != rhs.otherPoint)
+            {
+                return otherPoint < rhs.otherPoint;
+            }
+            if (propFlags != rhs.propFlags)
+            {
+                return propFlags < rhs.propFlags;
+            }
+            if (otherPropFlags != rhs.otherPropFlags)
+            {
+                return otherPropFlags < rhs.otherPropFlags;
+            }
+            if (dist != rhs.dist)
+            {
+                return dist < rhs.dist;
+            }
+            return disabled < rhs.disabled;
+        }
+        bool operator==(const OrthogEdgeDescription& rhs) const
+        {
+            return !(*this < rhs) && !(rhs < *this);
+        }
+
+        Point point;
+        Point otherPoint;
+        unsigned int propFlags;
+        unsigned int otherPropFlags;
+        double dist;
+        bool disabled;
+};
+typedef std::vector<OrthogEdgeDescription> OrthogEdgeDescriptionList;
+
+
+// Describes the orthogonal visibility graph, excluding the dummy edges
+// to connection pins, which are added when connectors are routed.
+static void describeOrthogonalVisGraph(Router *router, 
+        OrthogEdgeDescriptionList& edges)
+{
+    edges.clear();
+    for (VertInf *curr = router->vertices.connsBegin(); 
+            curr != router->vertices.end(); curr = curr->lstNext)
+    {
+        for (EdgeInfList::const_iterator edge = curr->orthogVisList.begin();
+                edge != curr->orthogVisList.end(); ++edge)
+        {
+            if ((*edge)->isDummyConnection())
+            {
+                continue;
+            }
+            edges.push_back(
+                    OrthogEdgeDescription(curr, VisNeighbour(*edge, curr)));
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+}
+
+
+// Checks the orthogonal visibility graph, if it is up to date, against a
+// graph generated from scratch, and returns true if they differ.  The
+// graph is generated by a separate router, given copies of the obstacles
+// and connection points, so the graph kept by this router is unchanged.
+bool Router::existsStaleOrthogonalVisGraph(void)
+{
+    if (!m_allows_orthogonal_routing || m_static_orthogonal_graph_invalidated)
+    {
+        // The graph will be regenerated before it is next used.
+        return false;
+    }
+
+    OrthogEdgeDescriptionList current;
+    describeOrthogonalVisGraph(this, current);
+
+    Router scratch(OrthogonalRouting);
+    for (size_t p = 0; p < lastRoutingParameterMarker; ++p)
+    {
+        scratch.m_routing_parameters[p] = m_routing_parameters[p];
+    }
+    for (size_t o = 0; o < lastRoutingOptionMarker; ++o)
+    {
+        scratch.m_routing_options[o] = m_routing_options[o];
+    }
+
+    // Obstacles are added to the front of the list, so they are copied in
+    // reverse to keep the same order.  Fixed junctions are copied as 
+    // shapes with the same polygon, while their connection points are 
+    // copied below along with all the others.
+    for (ObstacleList::reverse_iterator obstacleIt = m_obstacles.rbegin();
+            obstacleIt != m_obstacles.rend(); ++obstacleIt)
+    {
+        Obstacle *obstacle = *obstacleIt;
+        JunctionRef *junction = dynamic_cast<JunctionRef *> (obstacle);
+        if (junction && !junction->positionFixed())
+        {
+            // Junctions that are free to move are not obstacles.
+            continue;
+        }
+        Polygon poly = obstacle->polygon();
+        new ShapeRef(&scratch, poly, obstacle->id());
+    }
+
+    // Connection points are likewise added to the front of the list.
+    std::vector<VertInf *> connPoints;
+    for (VertInf *curr = vertices.connsBegin(); 
+            curr && (curr != vertices.shapesBegin()); curr = curr->lstNext)
+    {
+        connPoints.push_back(curr);
+    }
+    std::vector<VertInf *> copies;
+    for (std::vector<VertInf *>::reverse_iterator curr = connPoints.rbegin();
+            curr != connPoints.rend(); ++curr)
+    {
+        VertInf *copy = new (&scratch) VertInf(&scratch, (*curr)->id, 
+                (*curr)->point);
+        copy->visDirections = (*curr)->visDirections;
+        copies.push_back(copy);
+    }
+
+    scratch.processTransaction();
+    scratch.regenerateStaticBuiltGraph();
+
+    OrthogEdgeDescriptionList regenerated;
+    describeOrthogonalVisGraph(&scratch, regenerated);
+
+    scratch.destroyOrthogonalVisGraph();
+    for (size_t i = 0; i < copies.size(); ++i)
+    {
+        scratch.vertices.removeVertex(copies[i]);
+        delete copies[i];
+    }
+
+    return !(current == regenerated);
+}
+
 void Router::setSlowRoutingCallback(bool (*func)(unsigned int, double))
 {
     m_slow_routing_callback = func;
@@ -2677,6 +3387,29 @@ void Router::outputDiagramSVG(std::string instanceName, LineReps *lineReps)
     fclose(fp);
 }
 
+TransactionTelemetry::TransactionTelemetry()
+    : visibilityGraphTime(0),
+      pathSearchTime(0),
+      crossingTime(0),
+      hyperedgeTime(0),
+      nudgingTime(0),
+      totalTime(0),
+      pathSearchExpansions(0),
+      connectorsRerouted(0),
+      connectorsSearched(0),
+      crossingConnectorsRerouted(0)
+{
+}
+
+
+CachedRoute::CachedRoute()
+    : fingerprint(0),
+      srcPinVertex(NULL),
+      dstPinVertex(NULL)
+{
+}
+
+
 ConnRerouteFlagDelegate::ConnRerouteFlagDelegate()
 {
 }
@@ -31,6 +31,7 @@
 
 #include <ctime>
 #include <list>
+#include <map>
 #include <utility>
 #include <string>
 
@@ -41,6 +42,7 @@
 #include "libavoid/timer.h"
 #include "libavoid/hyperedge.h"
 #include "libavoid/actioninfo.h"
+#include "libavoid/pool.h"
 
 
 namespace Avoid {
@@ -189,6 +191,17 @@ enum RoutingOption
     //! @note   This will allow routes to be nudged up to the bounds of shapes, 
     //!         additional space for this nudging can be specified via the 
     nudgeOrthogonalTouchingColinearSegments,
+    //! @brief  This option causes orthogonal connectors to keep the route
+    //!         from their last path search, rather than searching again, 
+    //!         while no obstacle or connection point that could affect 
+    //!         that search has changed.  A kept route is as good as any 
+    //!         the search would find, but where several routes are equally
+    //!         good it may not be the one the search would choose.  This 
+    //!         has no effect while crossing, shared path or cluster 
+    //!         crossing penalties are set, since routes then depend upon 
+    //!         other connectors.  This option is not set by default.
+    //! @sa     Timer::RouteCacheHits()
+    reuseUnaffectedOrthogonalRoutes,
     
     // Used for determining the size of the routing options array.
     // This should always we the last value in the enum.
@@ -216,6 +229,27 @@ class ConnRerouteFlagDelegate {
         std::list<std::pair<ConnRef *, bool> > m_mapping;
 };
 
+// NOTE: This is an internal helper class that should not be used by the user.
+//
+// The route found for a connector by its last path search, along with a 
+// fingerprint of the obstacles and connection points that could have 
+// affected the search.  While the fingerprint is unchanged, the route is 
+// still a best route and the search need not be repeated.
+class CachedRoute
+{
+    public:
+        CachedRoute();
+
+        PolyLine route;
+        // The region containing every route at least as good as this one.
+        Box corridor;
+        unsigned long long fingerprint;
+        // The vertices of the connection pins used at each end, if any.
+        VertInf *srcPinVertex;
+        VertInf *dstPinVertex;
+};
+typedef std::map<const ConnRef *, CachedRoute> RouteCache;
+
 static const double zeroParamValue = 0;
 static const double chooseSensibleParamValue = -1;
 
@@ -254,6 +288,50 @@ class TopologyAddonInterface
 };
 
 
+//! @brief   A breakdown of the work done by the router to process a
+//!          transaction.
+//!
+//! The router fills in one of these for each call to 
+//! Router::processTransaction() that has changes to process.  The times 
+//! are wall-clock seconds and are only measured while telemetry is enabled
+//! with Router::setTelemetryEnabled(); otherwise they are zero.  The 
+//! counts are always recorded.
+//!
+class AVOID_EXPORT TransactionTelemetry
+{
+    public:
+        TransactionTelemetry();
+
+        //! The time spent updating the visibility graphs for the changed 
+        //! shapes, connectors and pins, including rebuilding the 
+        //! orthogonal visibility graph.
+        double visibilityGraphTime;
+        //! The time spent searching for connector paths.
+        double pathSearchTime;
+        //! The time spent finding crossing connectors and rerouting them.
+        double crossingTime;
+        //! The time spent rerouting and improving hyperedges.
+        double hyperedgeTime;
+        //! The time spent simplifying, centring and nudging orthogonal 
+        //! routes.
+        double nudgingTime;
+        //! The time taken by the whole transaction.
+        double totalTime;
+        //! The number of nodes expanded by the A* path searches, including
+        //! those of connectors rerouted to avoid crossings.
+        unsigned long pathSearchExpansions;
+        //! The number of connectors rerouted, not counting those rerouted
+        //! as part of hyperedges.
+        unsigned int connectorsRerouted;
+        //! The number of those connectors that needed a path search, i.e.,
+        //! that could not reuse a cached route.
+        unsigned int connectorsSearched;
+        //! The number of connectors rerouted again to avoid crossings or 
+        //! shared paths.
+        unsigned int crossingConnectorsRerouted;
+};
+
+
 //! @brief   The Router class represents a libavoid router instance.
 //!
 //! Usually you would keep a separate Router instance for each diagram
@@ -274,12 +352,18 @@ class AVOID_EXPORT Router {
         //!         pointers to them.
         virtual ~Router();
 
+        // Storage for the vertices and edges of the visibility graphs.
+        // These come first so they are destroyed after everything else.
+        BlockPool m_vertex_pool;
+        BlockPool m_edge_pool;
+
         ObstacleList m_obstacles;
         ConnRefList connRefs;
         ClusterRefList clusterRefs;
         EdgeList visGraph;
         EdgeList invisGraph;
         EdgeList visOrthogGraph;
+        OrthogonalVisGraphSnapshot visOrthogGraphSnapshot;
         ContainsMap contains;
         VertInfList vertices;
         ContainsMap enclosingClusters;
@@ -535,6 +619,52 @@ class AVOID_EXPORT Router {
         void setRoutingPenalty(const RoutingParameter penType, 
                 const double penVal = chooseSensibleParamValue);
 
+        //! @brief  Sets the number of threads used to search for connector
+        //!         paths and to nudge orthogonal routes.
+        //!
+        //! Connectors whose paths can be found independently of the others
+        //! are searched for in parallel against the unchanging visibility 
+        //! graph, and their routes are then recorded in the usual order, 
+        //! so the resulting routes do not depend on the number of threads.
+        //! Likewise, groups of orthogonal segments that do not overlap 
+        //! are nudged in parallel.
+        //! This has no effect unless the library is built with OpenMP.
+        //!
+        //! @param[in] workers  The number of threads, or 0 to use one per
+        //!                     processor.  The default is 1.
+        //!
+        void setWorkerCount(const unsigned int workers);
+
+        //! @brief  Returns the number of threads set by setWorkerCount().
+        //!
+        //! @return  The number of threads, or 0 for one per processor.
+        //!
+        unsigned int workerCount(void) const;
+
+        //! @brief  Sets whether the router measures the time spent in each
+        //!         phase of processing a transaction.
+        //!
+        //! The measurements for the last transaction are returned by
+        //! lastTransactionTelemetry().  Telemetry is disabled by default.
+        //!
+        //! @param[in] enabled  Whether to measure transaction times.
+        //!
+        void setTelemetryEnabled(const bool enabled);
+
+        //! @brief  Returns whether transaction telemetry is enabled.
+        //!
+        //! @return  Whether the router measures transaction times.
+        //!
+        bool telemetryEnabled(void) const;
+
+        //! @brief  Returns the telemetry for the last transaction that was
+        //!         processed.
+        //!
+        //! @return  A TransactionTelemetry object describing the work done
+        //!          for the last transaction.
+        //!
+        const TransactionTelemetry& lastTransactionTelemetry(void) const;
+
         //! @brief  Returns a pointer to the hyperedge rerouter for the router.
         //!
         //! @return  A HyperedgeRerouter object that can be used to register
@@ -626,6 +756,7 @@ class AVOID_EXPORT Router {
         bool existsOrthogonalTouchingPaths(void);
         int  existsCrossings(const bool optimisedForConnectorType = false);
         bool existsInvalidOrthogonalPaths(void);
+        bool existsStaleOrthogonalVisGraph(void);
 
         // Outputs the current diagram.  Used for visualising individual
         // steps of various algorithms.  lineReps can be used to draw 
@@ -656,8 +787,12 @@ class AVOID_EXPORT Router {
         void modifyConnectionPin(ShapeConnectionPin *pin);
 
         void removeObjectFromQueuedActions(const void *object);
+        ActionInfoList::iterator findQueuedAction(const ActionType type,
+                const void *object);
+        void queueAction(const ActionInfo& action);
+        void eraseQueuedAction(ActionInfoList::iterator action);
         void newBlockingShape(const Polygon& poly, int pid);
-        void checkAllBlockedEdges(int pid);
+        void checkAllBlockedEdges(const std::set<int>& pids);
         void checkAllMissingEdges(void);
         void adjustContainsWithAdd(const Polygon& poly, const int p_shape);
         void adjustContainsWithDel(const int p_shape);
@@ -665,10 +800,18 @@ class AVOID_EXPORT Router {
                 const int p_cluster);
         void adjustClustersWithDel(const int p_cluster);
         void rerouteAndCallbackConnectors(void);
+        void generatePaths(const std::vector<ConnRef *>& conns);
         void improveCrossings(void);
         void performSlowRoutingCallBack(double completeFraction);
+        bool routeCacheApplies(const ConnRef *conn) const;
+        unsigned long long routeFingerprint(const ConnRef *conn, 
+                const Box& corridor);
+        bool reuseCachedRoute(ConnRef *conn);
+        void cacheRoute(ConnRef *conn);
+        double telemetryClock(void) const;
 
         ActionInfoList actionList;
+        ActionInfoIndex actionIndex;
         unsigned int m_largest_assigned_id;
         bool m_consolidate_actions;
         bool m_currently_calling_destructors;
@@ -676,6 +819,7 @@ class AVOID_EXPORT Router {
         bool m_routing_options[lastRoutingOptionMarker];
         
         ConnRerouteFlagDelegate m_conn_reroute_flags;
+        RouteCache m_route_cache;
         HyperedgeRerouter m_hyperedge_rerouter;
         
         // Slow-routing callback member variables. 
@@ -691,6 +835,11 @@ class AVOID_EXPORT Router {
         
         bool m_static_orthogonal_graph_invalidated;
         bool m_in_crossing_rerouting_stage;
+
+        unsigned int m_worker_count;
+
+        bool m_telemetry_enabled;
+        TransactionTelemetry m_telemetry;
 };
 
 
@@ -0,0 +1,165 @@
+/*
+ * vim: ts=4 sw=4 et tw=0 wm=0
+ *
+ * libavoid - Fast, Incremental, Object-avoiding Line Router
+ *
+ * Copyright (C) 2026  Dunnart contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * See the file LICENSE.LGPL distributed with the library.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ *
+*/
+
+// Counts the heap allocations made, and times, generating the orthogonal
+// visibility graph for a grid of shapes, regenerating it after shapes
+// move, and deleting the router.  Allocations are counted by replacing
+// the global operator new, so they include those made by the standard
+// containers.
+//
+// Usage: allocation_benchmark [grid size] [moves]
+// The grid has size x size shapes, with a connector between each pair of
+// horizontally adjacent shapes.  Each move shifts one shape and
+// processes the transaction, which regenerates the graph.
+
+#include <vector>
+#include <new>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+#include "libavoid/libavoid.h"
+using namespace Avoid;
+
+#if defined(__GNUC__) && (__GNUC__ >= 11)
+// GCC pairs the standard operator new with operator delete, and does not
+// see that both are replaced by the malloc() and free() calls below.
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+static unsigned long allocations = 0;
+
+void *operator new(size_t size)
+{
+    ++allocations;
+    void *ptr = malloc((size > 0) ? size : 1);
+    if (ptr == NULL)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void *ptr) throw()
+{
+    free(ptr);
+}
+
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete[](void *ptr) throw()
+{
+    free(ptr);
+}
+
+#ifdef __cpp_sized_deallocation
+void operator delete(void *ptr, size_t) throw()
+{
+    free(ptr);
+}
+
+void operator delete[](void *ptr, size_t) throw()
+{
+    free(ptr);
+}
+#endif
+
+static double seconds(const clock_t start)
+{
+    return (double) (clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char **argv)
+{
+    const int size = (argc > 1) ? atoi(argv[1]) : 45;
+    const int moves = (argc > 2) ? atoi(argv[2]) : 3;
+
+    Router *router = new Router(OrthogonalRouting);
+    router->setRoutingParameter(shapeBufferDistance, 4.0);
+    router->setRoutingParameter(segmentPenalty, 50);
+
+    std::vector<ShapeRef *> shapes;
+    srand(7);
+    for (int i = 0; i < size; ++i)
+    {
+        for (int j = 0; j < size; ++j)
+        {
+            double x = i * 100 + (rand() % 20);
+            double y = j * 100 + (rand() % 20);
+            Rectangle rect(Point(x, y),
+                    Point(x + 40 + (rand() % 20), y + 30 + (rand() % 20)));
+            ShapeRef *shape = new ShapeRef(router, rect);
+            ShapeConnectionPin *pin = new ShapeConnectionPin(shape,
+                    CONNECTIONPIN_CENTRE, ATTACH_POS_CENTRE,
+                    ATTACH_POS_CENTRE, 0, ConnDirNone);
+            pin->setExclusive(false);
+            shapes.push_back(shape);
+        }
+    }
+    for (int i = 0; i < size; ++i)
+    {
+        for (int j = 0; j + 1 < size; ++j)
+        {
+            ShapeRef *src = shapes[(i * size) + j];
+            ShapeRef *dst = shapes[(i * size) + j + 1];
+            ConnRef *conn = new ConnRef(router,
+                    ConnEnd(src, CONNECTIONPIN_CENTRE),
+                    ConnEnd(dst, CONNECTIONPIN_CENTRE));
+            conn->setRoutingType(ConnType_Orthogonal);
+        }
+    }
+
+    unsigned long before = allocations;
+    clock_t start = clock();
+    router->processTransaction();
+    const double firstTime = seconds(start);
+    const unsigned long firstAllocations = allocations - before;
+
+    before = allocations;
+    start = clock();
+    for (int m = 0; m < moves; ++m)
+    {
+        router->moveShape(shapes[(m * 37) % shapes.size()], 3, 2);
+        router->processTransaction();
+    }
+    const double moveTime = seconds(start);
+    const unsigned long moveAllocations = allocations - before;
+
+    before = allocations;
+    start = clock();
+    delete router;
+    const double deleteTime = seconds(start);
+    const unsigned long deleteAllocations = allocations - before;
+
+    printf("%d shapes, %d connectors, %d moves\n", size * size,
+            size * (size - 1), moves);
+    printf("  first transaction: %8.3fs %10lu allocations\n", firstTime,
+            firstAllocations);
+    if (moves > 0)
+    {
+        printf("  each move:         %8.3fs %10lu allocations\n",
+                moveTime / moves, moveAllocations / moves);
+    }
+    printf("  delete router:     %8.3fs %10lu allocations\n", deleteTime,
+            deleteAllocations);
+    return 0;
+}
@@ -0,0 +1,4 @@
+TARGET = allocation_benchmark
+include(tests.pri)
+
+SOURCES += allocation_benchmark.cpp
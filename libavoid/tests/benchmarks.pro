@@ -0,0 +1,8 @@
+# Benchmarks for libavoid.  Build with "qmake -config benchmarks".
+
+TEMPLATE = subdirs
+
+SUBDIRS = \
+    allocation_benchmark.pro \
+    queued_moves_benchmark.pro \
+    routing_benchmark.pro
@@ -0,0 +1,199 @@
+/*
+ * vim: ts=4 sw=4 et tw=0 wm=0
+ *
+ * libavoid - Fast, Incremental, Object-avoiding Line Router
+ *
+ * Copyright (C) 2026  Dunnart contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * See the file LICENSE.LGPL distributed with the library.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+*/
+
+// Makes the same changes to two routers over a series of transactions.
+// The first keeps its orthogonal visibility graph whenever the changes
+// allow it, while the second is made to rebuild its graph from scratch
+// for every transaction.  After each transaction the routes of the two
+// must be the same, and the graph kept by the first must match one
+// generated from scratch.
+
+#include <string>
+#include <vector>
+#include <cstdio>
+
+#include "libavoid/libavoid.h"
+using namespace Avoid;
+
+static int failures = 0;
+
+static std::string describeRoute(const PolyLine& route)
+{
+    std::string result;
+    char buffer[64];
+    for (size_t i = 0; i < route.size(); ++i)
+    {
+        sprintf(buffer, (i == 0) ? "%g,%g" : " %g,%g",
+                route.ps[i].x, route.ps[i].y);
+        result += buffer;
+    }
+    return result;
+}
+
+class Diagram
+{
+    public:
+        Diagram(const int size)
+            : router(new Router(OrthogonalRouting))
+        {
+            router->setRoutingParameter(shapeBufferDistance, 4.0);
+            router->setRoutingParameter(segmentPenalty, 50);
+            for (int i = 0; i < size; ++i)
+            {
+                for (int j = 0; j < size; ++j)
+                {
+                    double x = i * 100 + (i * 37 + j * 11) % 20;
+                    double y = j * 100 + (i * 7 + j * 29) % 20;
+                    Rectangle rect(Point(x, y),
+                            Point(x + 40 + (i * 13 + j * 7) % 20,
+                                y + 30 + (i * 5 + j * 17) % 20));
+                    ShapeRef *shape = new ShapeRef(router, rect);
+                    new ShapeConnectionPin(shape, 1, ATTACH_POS_CENTRE,
+                            ATTACH_POS_TOP, 0, ConnDirUp);
+                    new ShapeConnectionPin(shape, 1, ATTACH_POS_CENTRE,
+                            ATTACH_POS_BOTTOM, 0, ConnDirDown);
+                    new ShapeConnectionPin(shape, 1, ATTACH_POS_LEFT,
+                            ATTACH_POS_CENTRE, 0, ConnDirLeft);
+                    new ShapeConnectionPin(shape, 1, ATTACH_POS_RIGHT,
+                            ATTACH_POS_CENTRE, 0, ConnDirRight);
+                    shapes.push_back(shape);
+                }
+            }
+            const int count = size * size;
+            for (int k = 0; k < 2 * count; ++k)
+            {
+                int a = (k * 7 + 1) % count;
+                int b = (k * 5 + 4 + k / count) % count;
+                if (a != b)
+                {
+                    addConnector(ConnEnd(shapes[a], 1), ConnEnd(shapes[b], 1));
+                }
+            }
+        }
+        ~Diagram()
+        {
+            delete router;
+        }
+        void addConnector(const ConnEnd& src, const ConnEnd& dst)
+        {
+            ConnRef *conn = new ConnRef(router, src, dst);
+            conn->setRoutingType(ConnType_Orthogonal);
+            connectors.push_back(conn);
+        }
+        void deleteConnector(const size_t index)
+        {
+            router->deleteConnector(connectors[index]);
+            connectors.erase(connectors.begin() + index);
+        }
+
+        Router *router;
+        std::vector<ShapeRef *> shapes;
+        std::vector<ConnRef *> connectors;
+};
+
+static void checkTransaction(const char *name, Diagram& kept,
+        Diagram& rebuilt)
+{
+    kept.router->processTransaction();
+    // Setting the buffer distance, even to the same value, makes the
+    // router regenerate its orthogonal visibility graph.
+    rebuilt.router->setRoutingParameter(shapeBufferDistance, 4.0);
+    rebuilt.router->processTransaction();
+
+    if (kept.router->existsStaleOrthogonalVisGraph())
+    {
+        printf("FAILED: %s: the kept orthogonal visibility graph is stale\n",
+                name);
+        ++failures;
+    }
+    for (size_t i = 0; i < kept.connectors.size(); ++i)
+    {
+        std::string keptRoute =
+                describeRoute(kept.connectors[i]->displayRoute());
+        std::string rebuiltRoute =
+                describeRoute(rebuilt.connectors[i]->displayRoute());
+        if (keptRoute != rebuiltRoute)
+        {
+            printf("FAILED: %s: connector %d routed as\n    %s\n"
+                    "  rather than\n    %s\n", name, (int) i,
+                    keptRoute.c_str(), rebuiltRoute.c_str());
+            ++failures;
+        }
+    }
+    printf("%s: %d routes checked\n", name, (int) kept.connectors.size());
+}
+
+int main(void)
+{
+    const int size = 4;
+    Diagram kept(size), rebuilt(size);
+    Diagram *diagrams[] = { &kept, &rebuilt };
+    checkTransaction("initial routing", kept, rebuilt);
+
+    // Connectors between pins are not in the graph, so it is kept.
+    for (int d = 0; d < 2; ++d)
+    {
+        diagrams[d]->addConnector(ConnEnd(diagrams[d]->shapes[0], 1),
+                ConnEnd(diagrams[d]->shapes[size * size - 1], 1));
+    }
+    checkTransaction("pin connector added", kept, rebuilt);
+    for (int d = 0; d < 2; ++d)
+    {
+        diagrams[d]->deleteConnector(3);
+    }
+    checkTransaction("pin connector removed", kept, rebuilt);
+
+    // Free endpoints are in the graph, so it has to be rebuilt.
+    for (int d = 0; d < 2; ++d)
+    {
+        diagrams[d]->addConnector(ConnEnd(Point(75, -20)),
+                ConnEnd(Point(size * 100 - 25, size * 100 - 10)));
+    }
+    checkTransaction("free connector added", kept, rebuilt);
+
+    // A transaction that only moves shapes.
+    for (int d = 0; d < 2; ++d)
+    {
+        for (size_t i = 0; i < diagrams[d]->shapes.size(); i += 3)
+        {
+            diagrams[d]->router->moveShape(diagrams[d]->shapes[i], 27, 19);
+        }
+    }
+    checkTransaction("shapes moved", kept, rebuilt);
+
+    for (int d = 0; d < 2; ++d)
+    {
+        diagrams[d]->connectors.back()->setDestEndpoint(
+                ConnEnd(Point(size * 100 - 25, 30)));
+    }
+    checkTransaction("free endpoint moved", kept, rebuilt);
+    for (int d = 0; d < 2; ++d)
+    {
+        diagrams[d]->connectors[5]->setDestEndpoint(
+                ConnEnd(diagrams[d]->shapes[4], 1));
+    }
+    checkTransaction("pin endpoint changed", kept, rebuilt);
+
+    if (failures > 0)
+    {
+        printf("%d checks failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,5 @@
+TARGET = orthogonal_graph_updates
+include(tests.pri)
+CONFIG += testcase
+
+SOURCES += orthogonal_graph_updates.cpp
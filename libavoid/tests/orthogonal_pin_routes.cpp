@@ -0,0 +1,222 @@
+/*
+ * vim: ts=4 sw=4 et tw=0 wm=0
+ *
+ * libavoid - Fast, Incremental, Object-avoiding Line Router
+ *
+ * Copyright (C) 2026  Dunnart contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * See the file LICENSE.LGPL distributed with the library.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+*/
+
+// Routes connectors between connection pins orthogonally, and checks the
+// routes against those given by libavoid before the path search was
+// changed to return the path as a list of vertices.  In the first
+// diagram, the search for the connector to the free endpoint above the
+// shapes reaches one vertex twice, and the loop between the two visits
+// has to be cut from its path.
+
+#include <string>
+#include <vector>
+#include <cstdio>
+
+#include "libavoid/libavoid.h"
+using namespace Avoid;
+
+static int failures = 0;
+
+static std::string describeRoute(const PolyLine& route)
+{
+    std::string result;
+    char buffer[64];
+    for (size_t i = 0; i < route.size(); ++i)
+    {
+        sprintf(buffer, (i == 0) ? "%g,%g" : " %g,%g",
+                route.ps[i].x, route.ps[i].y);
+        result += buffer;
+    }
+    return result;
+}
+
+static void checkRoutes(const char *name,
+        const std::vector<ConnRef *>& connectors, const char **expected,
+        const size_t expectedCount)
+{
+    if (connectors.size() != expectedCount)
+    {
+        printf("FAILED: %s: %d connectors, expected %d\n", name,
+                (int) connectors.size(), (int) expectedCount);
+        ++failures;
+        return;
+    }
+    for (size_t i = 0; i < connectors.size(); ++i)
+    {
+        std::string route = describeRoute(connectors[i]->displayRoute());
+        if (route != expected[i])
+        {
+            printf("FAILED: %s: connector %d routed as\n    %s\n"
+                    "  expected\n    %s\n", name, (int) i, route.c_str(),
+                    expected[i]);
+            ++failures;
+        }
+    }
+    printf("%s: %d routes checked\n", name, (int) connectors.size());
+}
+
+static ShapeRef *addShape(Router *router, const double x1, const double y1,
+        const double x2, const double y2)
+{
+    Rectangle rect(Point(x1, y1), Point(x2, y2));
+    return new ShapeRef(router, rect);
+}
+
+static ConnRef *addConnector(Router *router, const ConnEnd& src,
+        const ConnEnd& dst)
+{
+    ConnRef *conn = new ConnRef(router, src, dst);
+    conn->setRoutingType(ConnType_Orthogonal);
+    return conn;
+}
+
+// Pins with a mix of visibility directions, some of them inside their
+// shapes, and connectors that end at free points.
+static void checkRevisitedVertex(void)
+{
+    Router *router = new Router(OrthogonalRouting);
+    router->setRoutingParameter(shapeBufferDistance, 4.0);
+    router->setRoutingParameter(segmentPenalty, 50);
+    router->setRoutingOption(nudgeOrthogonalSegmentsConnectedToShapes, true);
+
+    ShapeRef *shape0 = addShape(router, 78, 113, 101, 169);
+    new ShapeConnectionPin(shape0, 1, 1, 0.5, 0,
+            ConnDirUp | ConnDirLeft | ConnDirRight);
+    new ShapeConnectionPin(shape0, 1, 0.5, 1, 0,
+            ConnDirUp | ConnDirLeft | ConnDirRight);
+    new ShapeConnectionPin(shape0, 1, 0, 1, 0, ConnDirUp);
+    new ShapeConnectionPin(shape0, 1, 0.5, 0.5, 0,
+            ConnDirDown | ConnDirLeft);
+    ShapeRef *shape1 = addShape(router, 331, 12, 342, 70);
+    new ShapeConnectionPin(shape1, 1, 0.5, 0, 0,
+            ConnDirUp | ConnDirDown | ConnDirRight);
+    new ShapeConnectionPin(shape1, 1, 0.5, 0.5, 0,
+            ConnDirUp | ConnDirDown | ConnDirLeft);
+    ShapeRef *shape2 = addShape(router, 145, 171, 197, 206);
+    new ShapeConnectionPin(shape2, 1, 1, 1, 0, ConnDirLeft | ConnDirRight);
+    new ShapeConnectionPin(shape2, 1, 1, 0.5, 0, ConnDirUp);
+    ShapeRef *shape3 = addShape(router, 397, 50, 462, 88);
+    new ShapeConnectionPin(shape3, 1, 0, 0.5, 0, ConnDirUp | ConnDirLeft);
+    new ShapeConnectionPin(shape3, 1, 1, 0.5, 0, ConnDirUp);
+    new ShapeConnectionPin(shape3, 1, 1, 0, 0,
+            ConnDirDown | ConnDirLeft | ConnDirRight);
+    ShapeRef *shape4 = addShape(router, 349, 99, 376, 150);
+    new ShapeConnectionPin(shape4, 1, 0, 0, 0, ConnDirRight);
+    new ShapeConnectionPin(shape4, 1, 0.5, 0.5, 0, ConnDirUp | ConnDirRight);
+    ShapeRef *shape5 = addShape(router, 347, 55, 407, 95);
+    new ShapeConnectionPin(shape5, 1, 0.5, 0.5, 0, ConnDirNone);
+    new ShapeConnectionPin(shape5, 1, 0.5, 0, 0, ConnDirDown | ConnDirLeft);
+
+    std::vector<ConnRef *> connectors;
+    connectors.push_back(addConnector(router, ConnEnd(shape0, 1),
+            ConnEnd(Point(28, 21), ConnDirUp)));
+    connectors.push_back(addConnector(router,
+            ConnEnd(Point(27, 236), ConnDirUp | ConnDirDown | ConnDirLeft),
+            ConnEnd(shape0, 1)));
+    connectors.push_back(addConnector(router,
+            ConnEnd(Point(195, 100), ConnDirUp | ConnDirDown | ConnDirLeft),
+            ConnEnd(shape0, 1)));
+    connectors.push_back(addConnector(router, ConnEnd(shape0, 1),
+            ConnEnd(shape2, 1)));
+    router->processTransaction();
+
+    const char *expected[] = {
+        "78,169 78,8 28,8 28,21",
+        "27,236 27,141 89.5,141",
+        "195,100 123,100 123,169 89.5,169",
+        "101,141 201,141 201,206 197,206"
+    };
+    checkRoutes("revisited vertex", connectors, expected,
+            sizeof(expected) / sizeof(expected[0]));
+    delete router;
+}
+
+// A grid of shapes with a pin in the middle of each side, like the one
+// used by routing_benchmark, but laid out without random numbers.
+static void checkSidePinGrid(void)
+{
+    Router *router = new Router(OrthogonalRouting);
+    router->setRoutingParameter(shapeBufferDistance, 4.0);
+    router->setRoutingParameter(segmentPenalty, 50);
+
+    const int size = 3;
+    std::vector<ShapeRef *> shapes;
+    for (int i = 0; i < size; ++i)
+    {
+        for (int j = 0; j < size; ++j)
+        {
+            double x = i * 100 + (i * 37 + j * 11) % 20;
+            double y = j * 100 + (i * 7 + j * 29) % 20;
+            ShapeRef *shape = addShape(router, x, y,
+                    x + 40 + (i * 13 + j * 7) % 20,
+                    y + 30 + (i * 5 + j * 17) % 20);
+            new ShapeConnectionPin(shape, 1, ATTACH_POS_CENTRE,
+                    ATTACH_POS_TOP, 0, ConnDirUp);
+            new ShapeConnectionPin(shape, 1, ATTACH_POS_CENTRE,
+                    ATTACH_POS_BOTTOM, 0, ConnDirDown);
+            new ShapeConnectionPin(shape, 1, ATTACH_POS_LEFT,
+                    ATTACH_POS_CENTRE, 0, ConnDirLeft);
+            new ShapeConnectionPin(shape, 1, ATTACH_POS_RIGHT,
+                    ATTACH_POS_CENTRE, 0, ConnDirRight);
+            shapes.push_back(shape);
+        }
+    }
+    const int count = size * size;
+    std::vector<ConnRef *> connectors;
+    for (int k = 0; k < 12; ++k)
+    {
+        int a = (k * 7 + 1) % count, b = (k * 5 + 4 + k / count) % count;
+        if (a == b)
+        {
+            continue;
+        }
+        connectors.push_back(addConnector(router, ConnEnd(shapes[a], 1),
+                ConnEnd(shapes[b], 1)));
+    }
+    router->processTransaction();
+
+    const char *expected[] = {
+        "11,132.5 7,132.5 7,101 128,101 128,116",
+        "236,246 236,262 84,262 84,15 40,15",
+        "214,34 185,34 185,258 142.5,258 142.5,254",
+        "108,132 80,132 80,105 34.5,105 34.5,109",
+        "56,240 88,240 88,76.75 237,76.75 237,54",
+        "20,30 20,69.5 3,69.5 3,187 29,187 29,218",
+        "166,229.5 174,229.5 174,24.5 170,24.5",
+        "143.5,42 143.5,80.75 189,80.75 189,176 236,176 236,212",
+        "34.5,156 34.5,180.5 142.5,180.5 142.5,205",
+        "216,229 181,229 181,176.5 80,176.5 80,132.5 58,132.5"
+    };
+    checkRoutes("side pin grid", connectors, expected,
+            sizeof(expected) / sizeof(expected[0]));
+    delete router;
+}
+
+int main(void)
+{
+    checkRevisitedVertex();
+    checkSidePinGrid();
+
+    if (failures > 0)
+    {
+        printf("%d checks failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,5 @@
+TARGET = orthogonal_pin_routes
+include(tests.pri)
+CONFIG += testcase
+
+SOURCES += orthogonal_pin_routes.cpp
@@ -0,0 +1,101 @@
+/*
+ * vim: ts=4 sw=4 et tw=0 wm=0
+ *
+ * libavoid - Fast, Incremental, Object-avoiding Line Router
+ *
+ * Copyright (C) 2026  Dunnart contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * See the file LICENSE.LGPL distributed with the library.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ *
+*/
+
+// Times queueing many shape moves in one transaction, including repeated
+// moves of the same shapes, which the router merges, and then processing
+// them.
+//
+// Usage: queued_moves_benchmark [shapes] [moves per shape]
+
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+#include "libavoid/libavoid.h"
+using namespace Avoid;
+
+static double seconds(const clock_t start)
+{
+    return (double) (clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char **argv)
+{
+    const int n = (argc > 1) ? atoi(argv[1]) : 3000;
+    const int moves = (argc > 2) ? atoi(argv[2]) : 3;
+
+    Router *router = new Router(OrthogonalRouting);
+    router->setTransactionUse(true);
+
+    std::vector<ShapeRef *> shapes;
+    clock_t start = clock();
+    for (int i = 0; i < n; ++i)
+    {
+        double x = (i % 100) * 60, y = (i / 100) * 60;
+        Rectangle rect(Point(x, y), Point(x + 30, y + 30));
+        shapes.push_back(new ShapeRef(router, rect));
+    }
+    const double addQueue = seconds(start);
+    start = clock();
+    router->processTransaction();
+    const double addProcess = seconds(start);
+
+    std::vector<Point> corners;
+    for (int i = 0; i < n; ++i)
+    {
+        corners.push_back(shapes[i]->polygon().ps[0]);
+    }
+    start = clock();
+    for (int m = 0; m < moves; ++m)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            router->moveShape(shapes[i], 1, 1);
+        }
+    }
+    const double moveQueue = seconds(start);
+    start = clock();
+    router->processTransaction();
+    const double moveProcess = seconds(start);
+
+    // The merged moves must add up.
+    int wrong = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        if (!(shapes[i]->polygon().ps[0] == 
+                    Point(corners[i].x + moves, corners[i].y + moves)))
+        {
+            ++wrong;
+        }
+    }
+
+    printf("%d shapes, %d queued moves each\n", n, moves);
+    printf("  queue additions:  %8.3fs\n", addQueue);
+    printf("  process them:     %8.3fs\n", addProcess);
+    printf("  queue moves:      %8.3fs\n", moveQueue);
+    printf("  process them:     %8.3fs\n", moveProcess);
+    delete router;
+    if (wrong > 0)
+    {
+        printf("  %d shapes are not where they were moved to\n", wrong);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,4 @@
+TARGET = queued_moves_benchmark
+include(tests.pri)
+
+SOURCES += queued_moves_benchmark.cpp
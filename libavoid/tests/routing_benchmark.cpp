@@ -0,0 +1,147 @@
+/*
+ * vim: ts=4 sw=4 et tw=0 wm=0
+ *
+ * libavoid - Fast, Incremental, Object-avoiding Line Router
+ *
+ * Copyright (C) 2026  Dunnart contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * See the file LICENSE.LGPL distributed with the library.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ *
+*/
+
+// Times routing the connectors of a jittered grid of shapes, and then 
+// rerouting them after a third of the shapes have moved.  The shapes and
+// connectors are the same for every run with the same arguments, and a
+// checksum of the routes is printed so that runs can be compared.
+//
+// Usage: routing_benchmark [grid size] [orthogonal] [pins] [penalties]
+//                          [workers]
+// The grid has size x size shapes and about 2 x size x size connectors.
+// Orthogonal routing is used unless orthogonal is 0.  If pins is 1, 
+// connectors attach to pins on the shape sides rather than to the shape
+// centres.  If penalties is 1, crossing and shared path penalties are 
+// set.
+
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+#include "libavoid/libavoid.h"
+using namespace Avoid;
+
+static double seconds(const clock_t start)
+{
+    return (double) (clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char **argv)
+{
+    const int size = (argc > 1) ? atoi(argv[1]) : 12;
+    const bool orthogonal = (argc > 2) ? atoi(argv[2]) : true;
+    const bool pins = (argc > 3) ? atoi(argv[3]) : false;
+    const bool penalties = (argc > 4) ? atoi(argv[4]) : false;
+    const int workers = (argc > 5) ? atoi(argv[5]) : 1;
+
+    Router *router = new Router(
+            orthogonal ? OrthogonalRouting : PolyLineRouting);
+    router->setRoutingParameter(shapeBufferDistance, 4.0);
+    router->setRoutingParameter(segmentPenalty, 50);
+    if (penalties)
+    {
+        router->setRoutingParameter(crossingPenalty, 200);
+        router->setRoutingParameter(fixedSharedPathPenalty, 110);
+    }
+    router->setWorkerCount(workers);
+
+    srand(7);
+    std::vector<ShapeRef *> shapes;
+    std::vector<Point> centres;
+    for (int i = 0; i < size; ++i)
+    {
+        for (int j = 0; j < size; ++j)
+        {
+            double x = i * 100 + (rand() % 20), y = j * 100 + (rand() % 20);
+            Rectangle rect(Point(x, y), 
+                    Point(x + 40 + rand() % 20, y + 30 + rand() % 20));
+            ShapeRef *shape = new ShapeRef(router, rect);
+            if (pins)
+            {
+                new ShapeConnectionPin(shape, 1, ATTACH_POS_CENTRE, 
+                        ATTACH_POS_TOP, 0, ConnDirUp);
+                new ShapeConnectionPin(shape, 1, ATTACH_POS_CENTRE, 
+                        ATTACH_POS_BOTTOM, 0, ConnDirDown);
+                new ShapeConnectionPin(shape, 1, ATTACH_POS_LEFT, 
+                        ATTACH_POS_CENTRE, 0, ConnDirLeft);
+                new ShapeConnectionPin(shape, 1, ATTACH_POS_RIGHT, 
+                        ATTACH_POS_CENTRE, 0, ConnDirRight);
+            }
+            shapes.push_back(shape);
+            centres.push_back(Point(x + 20, y + 15));
+        }
+    }
+    std::vector<ConnRef *> connectors;
+    for (int k = 0; k < size * size * 2; ++k)
+    {
+        int a = rand() % shapes.size(), b = rand() % shapes.size();
+        if (a == b)
+        {
+            continue;
+        }
+        ConnRef *conn;
+        if (pins)
+        {
+            conn = new ConnRef(router, ConnEnd(shapes[a], 1), 
+                    ConnEnd(shapes[b], 1));
+        }
+        else
+        {
+            conn = new ConnRef(router, ConnEnd(centres[a]), 
+                    ConnEnd(centres[b]));
+        }
+        conn->setRoutingType(
+                orthogonal ? ConnType_Orthogonal : ConnType_PolyLine);
+        connectors.push_back(conn);
+    }
+
+    clock_t start = clock();
+    router->processTransaction();
+    const double route = seconds(start);
+
+    for (size_t i = 0; i < shapes.size(); i += 3)
+    {
+        router->moveShape(shapes[i], 7, 5);
+    }
+    start = clock();
+    router->processTransaction();
+    const double reroute = seconds(start);
+
+    double checksum = 0;
+    long points = 0;
+    for (size_t k = 0; k < connectors.size(); ++k)
+    {
+        const PolyLine& r = connectors[k]->displayRoute();
+        for (size_t i = 0; i < r.size(); ++i)
+        {
+            checksum += r.ps[i].x * (i + 1) + r.ps[i].y * (k + 1);
+            ++points;
+        }
+    }
+
+    printf("%d shapes, %d connectors, %s routing%s%s\n", size * size,
+            (int) connectors.size(), orthogonal ? "orthogonal" : "polyline",
+            pins ? ", pins" : "", penalties ? ", penalties" : "");
+    printf("  route:   %8.3fs\n", route);
+    printf("  reroute: %8.3fs\n", reroute);
+    printf("  %ld route points, checksum %.6f\n", points, checksum);
+    delete router;
+    return 0;
+}
@@ -0,0 +1,4 @@
+TARGET = routing_benchmark
+include(tests.pri)
+
+SOURCES += routing_benchmark.cpp
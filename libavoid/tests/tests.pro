@@ -0,0 +1,8 @@
+# Tests for libavoid.  Build with "qmake -config tests" and run with 
+# "make check".
+
+TEMPLATE = subdirs
+
+SUBDIRS = \
+    orthogonal_graph_updates.pro \
+    orthogonal_pin_routes.pro
@@ -27,6 +27,12 @@
 #include <cstdlib>
 #include <climits>
 
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__)
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
 #include "libavoid/timer.h"
 #include "libavoid/debug.h"
 #include "libavoid/assertions.h"
@@ -49,6 +55,7 @@ void Timer::Reset(void)
         cTally[i] = cPathTally[i] = 0;
         cMax[i] = cPathMax[i] = 0;
     }
+    routeCacheHits = routeCacheMisses = 0;
     running = false;
     count  = 0;
     type = lasttype = tmNon;
@@ -135,6 +142,46 @@ void Timer::PrintAll(FILE *fp)
     }
 }
 
+void Timer::CountRouteCacheLookup(const bool hit)
+{
+    if (hit)
+    {
+        routeCacheHits++;
+    }
+    else
+    {
+        routeCacheMisses++;
+    }
+}
+
+
+unsigned long Timer::RouteCacheHits(void) const
+{
+    return routeCacheHits;
+}
+
+
+unsigned long Timer::RouteCacheMisses(void) const
+{
+    return routeCacheMisses;
+}
+
+
+double wallClockTime(void)
+{
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__)
+    LARGE_INTEGER frequency, count;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&count);
+    return count.QuadPart / (double) frequency.QuadPart;
+#else
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + (tv.tv_usec / 1000000.0);
+#endif
+}
+
+
 #define toMsec(tot) ((bigclock_t) ((tot) / (((double) CLOCKS_PER_SEC) / 1000)))
 #define toAvg(tot, cnt) ((((cnt) > 0) ? ((long double) (tot)) / (cnt) : 0))
 
@@ -73,6 +73,11 @@ enum TimerIndex
 static const bool timerStart = true;
 static const bool timerDelay = false;
 
+// Returns the wall-clock time in seconds from some fixed point.  Unlike the
+// CPU time measured by Timer, this includes time spent waiting on other
+// threads, and so is used for the router's transaction telemetry.
+extern double wallClockTime(void);
+
 
 class Timer
 {
@@ -85,6 +90,10 @@ class Timer
         void Print(TimerIndex, FILE *fp);
         void PrintAll(FILE *fp);
         void PrintHyperedgePaper(FILE *fp);
+        // Counts lookups in the router's route cache.
+        void CountRouteCacheLookup(const bool hit);
+        unsigned long RouteCacheHits(void) const;
+        unsigned long RouteCacheMisses(void) const;
 
     private:
         clock_t cStart[tmCount];
@@ -95,6 +104,9 @@ class Timer
         clock_t cMax[tmCount];
         clock_t cPathMax[tmCount];
 
+        unsigned long routeCacheHits;
+        unsigned long routeCacheMisses;
+
         bool running;
         long count;
         TimerIndex type, lasttype;
@@ -169,7 +169,8 @@ VertInf::VertInf(Router *router, const VertID& vid, const Point& vpoint,
       m_orthogonalPartner(NULL),
       m_treeRoot(NULL),
       visDirections(ConnDirNone),
-      orthogVisPropFlags(0)
+      orthogVisPropFlags(0),
+      orthogVisSnapshotIndex(OrthogonalVisGraphSnapshot::NOT_CONTAINED)
 {
     point.id = vid.objID;
     point.vn = vid.vn;
@@ -181,6 +182,26 @@ VertInf::VertInf(Router *router, const VertID& vid, const Point& vpoint,
 }
 
 
+void *VertInf::operator new(size_t size, Router *router)
+{
+    return router->m_vertex_pool.allocate(size);
+}
+
+
+void VertInf::operator delete(void *object, Router *router)
+{
+    // Only called if the constructor throws.
+    (void)(router);  // Avoid unused parameter warning.
+    BlockPool::deallocate(object);
+}
+
+
+void VertInf::operator delete(void *object)
+{
+    BlockPool::deallocate(object);
+}
+
+
 VertInf::~VertInf()
 {
     COLA_ASSERT(orphaned());
@@ -203,6 +224,7 @@ EdgeInf *VertInf::hasNeighbour(VertInf *target, bool orthogonal) const
 
 void VertInf::Reset(const VertID& vid, const Point& vpoint)
 {
+    invalidateOrthogonalNeighbours();
     id = vid;
     point = vpoint;
     point.id = id.objID;
@@ -212,12 +234,28 @@ void VertInf::Reset(const VertID& vid, const Point& vpoint)
 
 void VertInf::Reset(const Point& vpoint)
 {
+    invalidateOrthogonalNeighbours();
     point = vpoint;
     point.id = id.objID;
     point.vn = id.vn;
 }
 
 
+// The orthogonal visibility graph snapshot holds this vertex's position 
+// and ID with each of its neighbours, so they and it must be added again 
+// when these change.
+void VertInf::invalidateOrthogonalNeighbours(void)
+{
+    OrthogonalVisGraphSnapshot& snapshot = _router->visOrthogGraphSnapshot;
+    snapshot.invalidate(this);
+    for (EdgeInfList::const_iterator edge = orthogVisList.begin();
+            edge != orthogVisList.end(); ++edge)
+    {
+        snapshot.invalidate((*edge)->otherVert(this));
+    }
+}
+
+
 // Returns true if this vertex is not involved in any (in)visibility graphs.
 bool VertInf::orphaned(void)
 {
@@ -490,6 +528,7 @@ void VertInfList::addVertex(VertInf *vert)
     checkVertInfListConditions();
     COLA_ASSERT(vert->lstPrev == NULL);
     COLA_ASSERT(vert->lstNext == NULL);
+    vert->_router->visOrthogGraphSnapshot.invalidate(vert);
 
     if (vert->id.isConnPt())
     {
@@ -556,6 +595,7 @@ VertInf *VertInfList::removeVertex(VertInf *vert)
     }
     // Conditions for correct data structure
     checkVertInfListConditions();
+    vert->_router->visOrthogGraphSnapshot.remove(vert);
     
     VertInf *following = vert->lstNext;
 
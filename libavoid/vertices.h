@@ -117,8 +117,14 @@ class VertInf
         VertInf(Router *router, const VertID& vid, const Point& vpoint,
                 const bool addToRouter = true);
         ~VertInf();
+        // Vertices are allocated from the router's vertex pool, and so 
+        // are created with "new (router) VertInf(router, ...)".
+        static void *operator new(size_t size, Router *router);
+        static void operator delete(void *object, Router *router);
+        static void operator delete(void *object);
         void Reset(const VertID& vid, const Point& vpoint);
         void Reset(const Point& vpoint);
+        void invalidateOrthogonalNeighbours(void);
         void removeFromGraph(const bool isConnVert = true);
         bool orphaned(void);
 
@@ -163,10 +169,12 @@ class VertInf
         double sptfDist;
 
         ConnDirFlags visDirections;
-        std::list<unsigned int> aStarDoneIndexes;
         // Flags for orthogonal visibility properties, i.e., whether the 
         // line points to a shape edge, connection point or an obstacle.
         unsigned int orthogVisPropFlags;
+        // The index of this vertex in the router's orthogonal visibility
+        // graph snapshot, or NOT_CONTAINED.
+        unsigned int orthogVisSnapshotIndex;
 };
 
 
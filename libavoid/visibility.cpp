@@ -33,6 +33,7 @@
 
 #include <algorithm>
 #include <cfloat>
+#include <map>
 
 #include "libavoid/shape.h"
 #include "libavoid/debug.h"
@@ -207,7 +208,32 @@ class PointPair
         Point      centerPoint;
 };
 
-typedef std::set<PointPair > VertSet;
+// The vertices visited by a sweep, sorted by angle.  This is a sorted
+// vector rather than a set, since it is built once and then only 
+// iterated over.
+typedef std::vector<PointPair> SweepVertexList;
+
+// Two PointPairs are equivalent when neither orders before the other.
+static bool equivalentPointPairs(const PointPair& lhs, const PointPair& rhs)
+{
+    return !(lhs < rhs) && !(rhs < lhs);
+}
+
+// The edges incident to a vertex, indexed by their other vertex.
+typedef std::map<VertInf *, EdgeInf *> EdgesByVertex;
+
+static void addEdgesByOtherVertex(EdgesByVertex& edges, VertInf *vert, 
+        const EdgeInfList& edgeList)
+{
+    EdgeInfList::const_iterator finish = edgeList.end();
+    for (EdgeInfList::const_iterator edge = edgeList.begin(); 
+            edge != finish; ++edge)
+    {
+        // An earlier edge to the same vertex takes precedence, as it 
+        // would for EdgeInf::existingEdge().
+        edges.insert(std::make_pair((*edge)->otherVert(vert), *edge));
+    }
+}
 
 
 class EdgePair
@@ -445,7 +471,8 @@ static void vertexSweep(VertInf *vert)
 
     // List of shape (and maybe endpt) vertices, except p
     // Sort list, around
-    VertSet v;
+    SweepVertexList v;
+    v.reserve(router->vertices.connsSize() + router->vertices.shapesSize());
 
     // Initialise the vertex list
     ShapeSet& ss = router->contains[centerID];
@@ -480,40 +507,44 @@ static void vertexSweep(VertInf *vert)
             {
                 if (inf->id.isConnectionPin())
                 {
-                    v.insert(PointPair(centerPoint, inf));
+                    v.push_back(PointPair(centerPoint, inf));
                 }
                 else if (centerID.isConnectionPin())
                 {
                     // Connection pins have visibility to everything.
-                    v.insert(PointPair(centerPoint, inf));
+                    v.push_back(PointPair(centerPoint, inf));
                 }
                 else if (inf->id.objID == centerID.objID)
                 {
                     // Center is an endpoint, so only include the other
                     // endpoints or checkpoints from the matching connector.
-                    v.insert(PointPair(centerPoint, inf));
+                    v.push_back(PointPair(centerPoint, inf));
                 }
             }
             else
             {
                 // Center is a shape vertex, so add all endpoint vertices.
-                v.insert(PointPair(centerPoint, inf));
+                v.push_back(PointPair(centerPoint, inf));
             }
         }
         else
         {
             // Add shape vertex.
-            v.insert(PointPair(centerPoint, inf));
+            v.push_back(PointPair(centerPoint, inf));
         }
     }
+    // Sort the vertices around the center.  As for a set, only the first
+    // of any equivalent vertices is kept.
+    std::stable_sort(v.begin(), v.end());
+    v.erase(std::unique(v.begin(), v.end(), equivalentPointPairs), v.end());
     std::set<unsigned int> onBorderIDs;
 
     // Add edges to T that intersect the initial ray.
     SweepEdgeList e;
-    VertSet::const_iterator vbegin = v.begin();
-    VertSet::const_iterator vend = v.end();
+    SweepVertexList::const_iterator vbegin = v.begin();
+    SweepVertexList::const_iterator vend = v.end();
     const Point xaxis(DBL_MAX, centerInf->point.y);
-    for (VertSet::const_iterator t = vbegin; t != vend; ++t)
+    for (SweepVertexList::const_iterator t = vbegin; t != vend; ++t)
     {
         VertInf *k = t->vInf;
 
@@ -563,8 +594,17 @@ static void vertexSweep(VertInf *vert)
     // Start the actual sweep.
     db_printf("SWEEP: "); centerID.db_print(); db_printf("\n");
 
+    // The sweep visits each vertex once, so the center's existing edges 
+    // can be looked up in an index built beforehand.  Searching the edge 
+    // lists instead, with existingEdge(), is slow since the center's lists
+    // grow as the sweep adds edges, as do those of every other vertex.
+    EdgesByVertex existingEdges;
+    addEdgesByOtherVertex(existingEdges, centerInf, centerInf->visList);
+    addEdgesByOtherVertex(existingEdges, centerInf, centerInf->orthogVisList);
+    addEdgesByOtherVertex(existingEdges, centerInf, centerInf->invisList);
+
     isBoundingShape isBounding(ss);
-    for (VertSet::const_iterator t = vbegin; t != vend; ++t)
+    for (SweepVertexList::const_iterator t = vbegin; t != vend; ++t)
     {
         VertInf *currInf = (*t).vInf;
         VertID& currID = currInf->id;
@@ -572,10 +612,12 @@ static void vertexSweep(VertInf *vert)
 
         const double& currDist = (*t).distance;
 
-        EdgeInf *edge = EdgeInf::existingEdge(centerInf, currInf);
+        EdgesByVertex::const_iterator existing = existingEdges.find(currInf);
+        EdgeInf *edge = (existing != existingEdges.end()) ? 
+                existing->second : NULL;
         if (edge == NULL)
         {
-            edge = new EdgeInf(centerInf, currInf);
+            edge = new (router) EdgeInf(centerInf, currInf);
         }
 
         for (SweepEdgeList::iterator c = e.begin(); c != e.end(); ++c)
@@ -25,6 +25,8 @@
  *
 */
 
+#include <algorithm>
+
 #include "libcola/cola.h"
 #include "libcola/compound_constraints.h"
 #include "libcola/cc_nonoverlapconstraints.h"
@@ -82,9 +84,7 @@ class ShapePairInfo
 {
     public:
         ShapePairInfo(unsigned ind1, unsigned ind2, unsigned ord = 1) 
-            : order(ord),
-              satisfied(false),
-              processed(false)
+            : order(ord)
         {
             COLA_ASSERT(ind1 != ind2);
             // Assign the lesser value to varIndex1.
@@ -94,13 +94,6 @@ class ShapePairInfo
         }
         bool operator<(const ShapePairInfo& rhs) const
         {
-            // Make sure the processed ones are at the end after sorting.
-            int processedInt = processed ? 1 : 0;
-            int rhsProcessedInt = rhs.processed ? 1 : 0;
-            if (processedInt != rhsProcessedInt)
-            {
-                return processedInt < rhsProcessedInt;
-            }
             // Use cluster ordering for primary sorting.
             if (order != rhs.order)
             {
@@ -111,8 +104,6 @@ class ShapePairInfo
         unsigned order;
         unsigned varIndex1;
         unsigned varIndex2;
-        bool satisfied;
-        bool processed;
         double costL;
         double costR;
         double costB;
@@ -122,10 +113,118 @@ class ShapePairInfo
 };
 
 
+// The extent of a shape in each dimension, used to find the pairs of 
+// shapes that overlap.
+class ShapeBounds
+{
+    public:
+        ShapeBounds(unsigned id, unsigned int group)
+            : id(id),
+              group(group)
+        {
+        }
+        unsigned id;
+        unsigned int group;
+        double min[2];
+        double max[2];
+};
+
+
+class CmpShapeBoundsMin
+{
+    public:
+        CmpShapeBoundsMin(const size_t dim)
+            : dim(dim)
+        {
+        }
+        bool operator()(const ShapeBounds& lhs, const ShapeBounds& rhs) const
+        {
+            if (lhs.min[dim] != rhs.min[dim])
+            {
+                return lhs.min[dim] < rhs.min[dim];
+            }
+            return lhs.id < rhs.id;
+        }
+        const size_t dim;
+};
+
+typedef std::pair<unsigned, unsigned> ShapePair;
+
+// Finds each pair of shapes in the same group whose bounds overlap in 
+// dimension dim, and also in the other dimension if both is true.  The 
+// shapes are swept in order of their lower edge in dim, keeping a list of
+// those whose extent has not yet ended.  Each pair is given as (lower id,
+// higher id) and pairs are returned in ascending order.
+static void findOverlappingPairs(std::vector<ShapeBounds>& bounds,
+        const size_t dim, const bool both, std::vector<ShapePair>& pairs)
+{
+    const size_t otherDim = (dim == 0) ? 1 : 0;
+    std::sort(bounds.begin(), bounds.end(), CmpShapeBoundsMin(dim));
+
+    std::vector<const ShapeBounds *> active;
+    for (size_t i = 0; i < bounds.size(); ++i)
+    {
+        const ShapeBounds& curr = bounds[i];
+        size_t stillActive = 0;
+        for (size_t j = 0; j < active.size(); ++j)
+        {
+            const ShapeBounds& other = *active[j];
+            if (other.max[dim] <= curr.min[dim])
+            {
+                // This ends before the current and all later shapes begin.
+                continue;
+            }
+            active[stillActive++] = active[j];
+
+            if (other.group != curr.group)
+            {
+                // Apply non-overlap only to objects in the same group.
+                continue;
+            }
+            if (both && ((other.max[otherDim] <= curr.min[otherDim]) ||
+                         (curr.max[otherDim] <= other.min[otherDim])))
+            {
+                continue;
+            }
+            pairs.push_back(ShapePair(std::min(curr.id, other.id),
+                    std::max(curr.id, other.id)));
+        }
+        active.resize(stillActive);
+        active.push_back(&curr);
+    }
+    std::sort(pairs.begin(), pairs.end());
+}
+
+
+// Computes the bounds of a shape from the current positions of its
+// variables.
+static void computeShapeBounds(const OverlapShapeOffsets& shape, 
+        const unsigned index, vpsc::Variables vs[], double min[2], 
+        double max[2])
+{
+    for (size_t dim = 0; dim < 2; ++dim)
+    {
+        double pos = vs[dim][index]->finalPosition;
+        min[dim] = pos - shape.halfDim[dim];
+        max[dim] = pos + shape.halfDim[dim];
+
+        if (shape.cluster)
+        {
+            COLA_ASSERT(shape.halfDim[dim] == 0);
+            COLA_ASSERT(index + 1 < vs[dim].size());
+            max[dim] = vs[dim][index + 1]->finalPosition;
+            min[dim] -= shape.rectPadding;
+            max[dim] += shape.rectPadding;
+        }
+    }
+}
+
+
 NonOverlapConstraints::NonOverlapConstraints(unsigned int priority)
     : CompoundConstraint(vpsc::HORIZONTAL, priority),
       pairInfoListSorted(false),
-      initialSortCompleted(false)
+      initialSortCompleted(false),
+      overlapsRemaining(true)
 {
     // All work is done by repeated addShape() calls.
 }
@@ -133,18 +232,7 @@ NonOverlapConstraints::NonOverlapConstraints(unsigned int priority)
 void NonOverlapConstraints::addShape(unsigned id, double halfW, double halfH,
         unsigned int group)
 {
-    // Setup pairInfos for all other shapes. 
-    for (std::map<unsigned, OverlapShapeOffsets>::iterator curr =
-            shapeOffsets.begin(); curr != shapeOffsets.end(); ++curr)
-    {
-        unsigned otherId = curr->first;
-        if ((shapeOffsets[otherId].group == group) && (id != otherId))
-        {
-            // Apply non-overlap only to objects in the same group (cluster).
-            pairInfoList.push_back(ShapePairInfo(otherId, id));
-        }
-    }
-
+    // Pairs are found from the shapes' positions as required.
     shapeOffsets[id] = OverlapShapeOffsets(id, halfW, halfH, group);
 }
 
@@ -152,18 +240,6 @@ void NonOverlapConstraints::addShape(unsigned id, double halfW, double halfH,
 void NonOverlapConstraints::addCluster(Cluster *cluster, unsigned int group)
 {
     unsigned id = cluster->clusterVarId;
-    // Setup pairInfos for all other shapes. 
-    for (std::map<unsigned, OverlapShapeOffsets>::iterator curr =
-            shapeOffsets.begin(); curr != shapeOffsets.end(); ++curr)
-    {
-        unsigned otherId = curr->first;
-        if (shapeOffsets[otherId].group == group)
-        {
-            // Apply non-overlap only to objects in the same group (cluster).
-            pairInfoList.push_back(ShapePairInfo(otherId, id));
-        }
-    }
-    
     shapeOffsets[id] = OverlapShapeOffsets(id, cluster, group);
 }
 
@@ -181,48 +257,19 @@ void NonOverlapConstraints::computeOverlapForShapePairInfo(ShapePairInfo& info,
     OverlapShapeOffsets& shape1 = shapeOffsets[info.varIndex1];
     OverlapShapeOffsets& shape2 = shapeOffsets[info.varIndex2];
 
-    double xPos1 = vs[0][info.varIndex1]->finalPosition;
-    double xPos2 = vs[0][info.varIndex2]->finalPosition;
-    double yPos1 = vs[1][info.varIndex1]->finalPosition;
-    double yPos2 = vs[1][info.varIndex2]->finalPosition;
+    double min1[2], max1[2], min2[2], max2[2];
+    computeShapeBounds(shape1, info.varIndex1, vs, min1, max1);
+    computeShapeBounds(shape2, info.varIndex2, vs, min2, max2);
 
-    double left1   = xPos1 - shape1.halfDim[0];
-    double right1  = xPos1 + shape1.halfDim[0];
-    double bottom1 = yPos1 - shape1.halfDim[1];
-    double top1    = yPos1 + shape1.halfDim[1];
+    double left1   = min1[0];
+    double right1  = max1[0];
+    double bottom1 = min1[1];
+    double top1    = max1[1];
 
-    if (shape1.cluster)
-    {
-        COLA_ASSERT(shape1.halfDim[0] == 0);
-        COLA_ASSERT(shape1.halfDim[1] == 0);
-        COLA_ASSERT(info.varIndex1 + 1 < vs[0].size());
-        right1 = vs[0][info.varIndex1 + 1]->finalPosition;
-        COLA_ASSERT(info.varIndex1 + 1 < vs[1].size());
-        top1    = vs[1][info.varIndex1 + 1]->finalPosition;
-        left1 -= shape1.rectPadding;
-        bottom1 -= shape1.rectPadding;
-        right1 += shape1.rectPadding;
-        top1 += shape1.rectPadding;
-    }
-
-    double left2   = xPos2 - shape2.halfDim[0];
-    double right2  = xPos2 + shape2.halfDim[0];
-    double bottom2 = yPos2 - shape2.halfDim[1];
-    double top2    = yPos2 + shape2.halfDim[1];
-
-    if (shape2.cluster)
-    {
-        COLA_ASSERT(shape2.halfDim[0] == 0);
-        COLA_ASSERT(shape2.halfDim[1] == 0);
-        COLA_ASSERT(info.varIndex2 + 1 < vs[0].size());
-        right2 = vs[0][info.varIndex2 + 1]->finalPosition;
-        COLA_ASSERT(info.varIndex2 + 1 < vs[1].size());
-        top2   = vs[1][info.varIndex2 + 1]->finalPosition;
-        left2 -= shape2.rectPadding;
-        bottom2 -= shape2.rectPadding;
-        right2 += shape2.rectPadding;
-        top2 += shape2.rectPadding;
-    }
+    double left2   = min2[0];
+    double right2  = max2[0];
+    double bottom2 = min2[1];
+    double top2    = max2[1];
 
     // If lr < 0, then left edge of shape1 is on the left 
     // of right edge of shape2.
@@ -301,34 +348,48 @@ void NonOverlapConstraints::computeOverlapForShapePairInfo(ShapePairInfo& info,
 
 void NonOverlapConstraints::computeAndSortOverlap(vpsc::Variables vs[])
 {
-    for (std::list<ShapePairInfo>::iterator curr = pairInfoList.begin();
-            curr != pairInfoList.end(); ++curr)
+    std::vector<ShapeBounds> bounds;
+    bounds.reserve(shapeOffsets.size());
+    for (std::map<unsigned, OverlapShapeOffsets>::iterator curr =
+            shapeOffsets.begin(); curr != shapeOffsets.end(); ++curr)
     {
-        ShapePairInfo& info = static_cast<ShapePairInfo&> (*curr);
-        
-        if (info.processed)
+        ShapeBounds shapeBounds(curr->first, curr->second.group);
+        computeShapeBounds(curr->second, curr->first, vs, 
+                shapeBounds.min, shapeBounds.max);
+        bounds.push_back(shapeBounds);
+    }
+    std::vector<ShapePair> pairs;
+    findOverlappingPairs(bounds, 0, true, pairs);
+
+    pairInfoList.clear();
+    _currSubConstraintIndex = 0;
+    for (std::vector<ShapePair>::iterator curr = pairs.begin();
+            curr != pairs.end(); ++curr)
+    {
+        if (processedPairs.find(*curr) != processedPairs.end())
         {
-            // Once we reach the processed nodes, which will always be at 
-            // the back, we can some computing overlap since this no longer
-            // matters.
-            break;
+            // Already has a separation constraint.
+            continue;
         }
+        ShapePairInfo info(curr->first, curr->second);
         computeOverlapForShapePairInfo(info, vs);
+        if (info.overlapMax > 0)
+        {
+            pairInfoList.push_back(info);
+        }
     }
-    pairInfoList.sort();
+    std::stable_sort(pairInfoList.begin(), pairInfoList.end());
 }
 
 
 void NonOverlapConstraints::markCurrSubConstraintAsActive(const bool satisfiable)
 {
-    ShapePairInfo info = pairInfoList.front();
-    pairInfoList.pop_front();
+    COLA_UNUSED(satisfiable);
+    COLA_ASSERT(_currSubConstraintIndex < pairInfoList.size());
+    ShapePairInfo& info = pairInfoList[_currSubConstraintIndex];
+    processedPairs.insert(ShapePair(info.varIndex1, info.varIndex2));
 
-    info.processed = true;
-    info.satisfied = satisfiable;
-    info.overlapMax = 0;
-    
-    pairInfoList.push_back(info);
+    ++_currSubConstraintIndex;
     pairInfoListSorted = false;
 }
 
@@ -346,8 +407,23 @@ NonOverlapConstraints::getCurrSubConstraintAlternatives(vpsc::Variables vs[])
         initialSortCompleted = true;
     }
 
-    // Take the first in the list.
-    ShapePairInfo& info = pairInfoList.front();
+    if (_currSubConstraintIndex == pairInfoList.size())
+    {
+        // All the pairs found to be overlapping have been processed.
+        if (pairInfoListSorted)
+        {
+            overlapsRemaining = false;
+            return alternatives;
+        }
+        // Constraints chosen since may have caused new overlap, so look 
+        // again.
+        computeAndSortOverlap(vs);
+        pairInfoListSorted = true;
+        return alternatives;
+    }
+
+    // Take the next in the list.
+    ShapePairInfo& info = pairInfoList[_currSubConstraintIndex];
     if (pairInfoListSorted == false)
     {
         // Only need to compute if not sorted.
@@ -360,7 +436,7 @@ NonOverlapConstraints::getCurrSubConstraintAlternatives(vpsc::Variables vs[])
         {
             // Seeing no overlap in the sorted list means we have solved
             // all non-overlap.  Nothing more to do.
-            _currSubConstraintIndex = pairInfoList.size();
+            overlapsRemaining = false;
             return alternatives;
         }
         computeAndSortOverlap(vs);
@@ -468,21 +544,17 @@ NonOverlapConstraints::getCurrSubConstraintAlternatives(vpsc::Variables vs[])
 bool NonOverlapConstraints::subConstraintsRemaining(void) const
 {
     //printf(". %3d of %4d\n", _currSubConstraintIndex, pairInfoList.size());
-    return _currSubConstraintIndex < pairInfoList.size();
+    return overlapsRemaining;
 }
 
 
 void NonOverlapConstraints::markAllSubConstraintsAsInactive(void)
 {
-    for (std::list<ShapePairInfo>::iterator curr = pairInfoList.begin();
-            curr != pairInfoList.end(); ++curr)
-    {
-        ShapePairInfo& info = (*curr);
-        info.satisfied = false;
-        info.processed = false;
-    }
+    pairInfoList.clear();
+    processedPairs.clear();
     _currSubConstraintIndex = 0;
     initialSortCompleted = false;
+    overlapsRemaining = true;
 }
 
 
@@ -490,19 +562,41 @@ void NonOverlapConstraints::generateSeparationConstraints(
         const vpsc::Dim dim, vpsc::Variables& vs, vpsc::Constraints& cs,
         std::vector<vpsc::Rectangle*>& boundingBoxes) 
 {
-    for (std::list<ShapePairInfo>::iterator info = pairInfoList.begin();
-            info != pairInfoList.end(); ++info)
+    // Only pairs overlapping in the other dimension need a constraint.
+    const size_t otherDim = (dim == vpsc::HORIZONTAL) ? 1 : 0;
+    std::vector<ShapeBounds> bounds;
+    bounds.reserve(shapeOffsets.size());
+    for (std::map<unsigned, OverlapShapeOffsets>::iterator curr =
+            shapeOffsets.begin(); curr != shapeOffsets.end(); ++curr)
+    {
+        OverlapShapeOffsets& shape = curr->second;
+        vpsc::Rectangle& rect = (shape.cluster) ?
+                shape.cluster->bounds : *boundingBoxes[curr->first];
+        ShapeBounds shapeBounds(curr->first, shape.group);
+        for (size_t d = 0; d < 2; ++d)
+        {
+            shapeBounds.min[d] = rect.getMinD(d);
+            shapeBounds.max[d] = rect.getMaxD(d);
+        }
+        bounds.push_back(shapeBounds);
+    }
+    std::vector<ShapePair> pairs;
+    findOverlappingPairs(bounds, otherDim, false, pairs);
+
+    for (std::vector<ShapePair>::iterator pair = pairs.begin();
+            pair != pairs.end(); ++pair)
     {
-        assertValidVariableIndex(vs, info->varIndex1);
-        assertValidVariableIndex(vs, info->varIndex2);
+        ShapePairInfo info(pair->first, pair->second);
+        assertValidVariableIndex(vs, info.varIndex1);
+        assertValidVariableIndex(vs, info.varIndex2);
         
-        OverlapShapeOffsets& shape1 = shapeOffsets[info->varIndex1];
-        OverlapShapeOffsets& shape2 = shapeOffsets[info->varIndex2];
+        OverlapShapeOffsets& shape1 = shapeOffsets[info.varIndex1];
+        OverlapShapeOffsets& shape2 = shapeOffsets[info.varIndex2];
         
         vpsc::Rectangle& rect1 = (shape1.cluster) ?
-                shape1.cluster->bounds : *boundingBoxes[info->varIndex1];
+                shape1.cluster->bounds : *boundingBoxes[info.varIndex1];
         vpsc::Rectangle& rect2 = (shape2.cluster) ?
-                shape2.cluster->bounds : *boundingBoxes[info->varIndex2];
+                shape2.cluster->bounds : *boundingBoxes[info.varIndex2];
 
         double pos1 = rect1.getCentreD(dim);
         double pos2 = rect2.getCentreD(dim);
@@ -524,7 +618,7 @@ void NonOverlapConstraints::generateSeparationConstraints(
         else
         {
             // Must constrain to rectangle centre postion variable.
-            varLeft1 = varRight1 = vs[info->varIndex1];
+            varLeft1 = varRight1 = vs[info.varIndex1];
         }
 
         if (shape2.cluster)
@@ -537,7 +631,7 @@ void NonOverlapConstraints::generateSeparationConstraints(
         else
         {
             // Must constrain to rectangle centre postion variable.
-            varLeft2 = varRight2 = vs[info->varIndex2];
+            varLeft2 = varRight2 = vs[info.varIndex2];
         }
 
         if (rect1.overlapD(!dim, &rect2) > 0.0005)
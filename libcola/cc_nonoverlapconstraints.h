@@ -26,6 +26,8 @@
 */
 
 #include <vector>
+#include <set>
+#include <utility>
 #include "libcola/compound_constraints.h"
 
 namespace vpsc {
@@ -40,6 +42,11 @@ class Cluster;
 
 
 // Non-overlap constraints prevent a set of given shapes from overlapping.
+//
+// Rather than tracking every pair of shapes, only pairs whose bounds 
+// currently overlap are considered.  These are found with a sweep over 
+// the shapes sorted by position, so the work is proportional to the 
+// number of shapes and nearby pairs rather than all O(n^2) pairs.
 class NonOverlapConstraints : public CompoundConstraint {
     public:
         NonOverlapConstraints(unsigned int priority = PRIORITY_NONOVERLAP);
@@ -67,10 +74,15 @@ class NonOverlapConstraints : public CompoundConstraint {
         void computeOverlapForShapePairInfo(ShapePairInfo& info,
                 vpsc::Variables vs[]);
         
-        std::list<ShapePairInfo> pairInfoList;
+        // Overlapping pairs, sorted most important first when 
+        // pairInfoListSorted.  _currSubConstraintIndex is the current one.
+        std::vector<ShapePairInfo> pairInfoList;
+        // Pairs that have already had a separation constraint chosen.
+        std::set<std::pair<unsigned, unsigned> > processedPairs;
         std::map<unsigned, OverlapShapeOffsets> shapeOffsets;
         bool pairInfoListSorted;
         bool initialSortCompleted;
+        bool overlapsRemaining;
 
         // Cluster variables
         size_t clusterVarStartIndex;
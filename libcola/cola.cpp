@@ -71,6 +71,7 @@ ConstrainedMajorizationLayout
       xSkipping(true),
       scaling(true),
       externalSolver(false),
+      persistentSolver(false),
       majorization(true)
 {
     boundingBoxes.resize(rs.size());
@@ -305,6 +306,8 @@ void ConstrainedMajorizationLayout::run(bool x, bool y) {
         gpY=new GradientProjection(
             VERTICAL,&lap2,tol,100,ccs,unsatisfiableY,
             avoidOverlaps,clusterHierarchy,pbb,scaling,mosek);
+        gpX->setPersistentSolver(persistentSolver);
+        gpY->setPersistentSolver(persistentSolver);
     }
     if(n>0) do {
         // to enforce clusters with non-intersecting, convex boundaries we
@@ -383,6 +386,8 @@ void ConstrainedMajorizationLayout::runOnce(bool x, bool y) {
         gpY=new GradientProjection(
             VERTICAL,&lap2,tol,100,ccs,unsatisfiableY,
             avoidOverlaps,clusterHierarchy,pbb,scaling,mosek);
+        gpX->setPersistentSolver(persistentSolver);
+        gpY->setPersistentSolver(persistentSolver);
     }
     if(n>0) {
         // to enforce clusters with non-intersecting, convex boundaries we
@@ -52,6 +52,9 @@ namespace topology {
 namespace cola {
 
 class NonOverlapConstraints;
+class PathLengths;
+class PathLengthsCache;
+class QuadTree;
 
 //! Edges are simply a pair of indices to entries in the Node vector
 typedef std::pair<unsigned, unsigned> Edge;
@@ -262,6 +265,16 @@ public:
     void setExternalSolver(bool externalSolver) {
         this->externalSolver=externalSolver;
     }
+    /**
+     * Keeps the VPSC solver and its active set between iterations of 
+     * layout, only updating the non-overlap constraints that change, 
+     * rather than solving each projection from scratch.  It is off by
+     * default.  ConstrainedFDLayout, which Dunnart's interactive layout
+     * uses, does not project with GradientProjection and is unaffected.
+     */
+    void setPersistentSolver(bool persistentSolver) {
+        this->persistentSolver=persistentSolver;
+    }
     /**
      * At each iteration of layout, generate constraints to avoid overlaps.
      * If bool horizontal is true, all overlaps will be resolved horizontally, otherwise
@@ -394,6 +407,10 @@ private:
     /** if the Mosek quadratic programming environment is available it may be used
        to solve each iteration of stress majorization... slow but useful for testing */
     bool externalSolver;
+    /** Whether the GradientProjection instances keep their solvers 
+     * between iterations.  False by default.
+     */
+    bool persistentSolver;
     bool majorization;
 };
 
@@ -432,9 +449,9 @@ class TopologyAddonInterface
             COLA_UNUSED(boundingBoxes);
             COLA_UNUSED(clusterHierarchy);
         }
-        virtual void computePathLengths(unsigned short** G)
+        virtual void computePathLengths(PathLengths& pathLengths)
         {
-            COLA_UNUSED(G);
+            COLA_UNUSED(pathLengths);
         }
         virtual double computeStress(void) const
         {
@@ -501,6 +518,10 @@ public:
      * @param done a test of convergence operation called at the end of each 
      *        iteration
      * @param preIteration an operation called before each iteration
+     * @param pathLengthsCache if not NULL, the path lengths are taken 
+     *        from this cache, which updates those of the graph it was 
+     *        last used for rather than recomputing them if only a few 
+     *        edges or nodes have changed.  It must outlive the layout.
      */
     ConstrainedFDLayout(
         const vpsc::Rectangles& rs,
@@ -509,7 +530,8 @@ public:
         const bool preventOverlaps,
         const double* eLengths=NULL,
         TestConvergence& done=defaultTest,
-        PreIteration* preIteration=NULL);
+        PreIteration* preIteration=NULL,
+        PathLengthsCache* pathLengthsCache=NULL);
     ~ConstrainedFDLayout();
     
     void run(bool x=true, bool y=true);
@@ -552,6 +574,40 @@ public:
         unsatisfiable[1]=unsatisfiableY;
     }
 
+    /**
+     * @brief  Approximate the stress and forces between distant nodes.
+     *
+     * When enabled, computeStress() and the force computation group 
+     * far-away nodes into quadtree cells (in the style of Barnes-Hut) and 
+     * treat each such cell as a single body, giving O(n log n) work per 
+     * iteration rather than O(n^2).  Pairs of nodes joined by an edge, 
+     * and pairs closer than exactRadius, always use the exact terms.
+     *
+     * @param approximate  whether to use the approximation.
+     * @param theta        accuracy parameter: a cell of width w at distance
+     *                     r from a node is approximated if w/r < theta.
+     *                     Smaller values are more accurate but slower, 
+     *                     0 is equivalent to the exact computation.
+     * @param exactRadius  distance within which all pairs are computed 
+     *                     exactly.  If zero, the ideal edge length is used.
+     */
+    void setApproximateForces(const bool approximate, 
+            const double theta = 0.7, const double exactRadius = 0);
+
+    /**
+     * @brief  Set the number of threads used to compute the stress and 
+     *         forces on each iteration.
+     *
+     * The nodes are divided into blocks that are computed in parallel and
+     * then combined in a fixed order, so the layout does not depend on 
+     * the number of workers.  This has no effect unless the library is 
+     * built with OpenMP.
+     *
+     * @param workers  number of threads, or 0 to use one per processor.
+     *                 The default is 1.
+     */
+    void setWorkerCount(const unsigned workers);
+
     void makeFeasible(void);
     double computeStress() const;
 
@@ -593,6 +649,18 @@ private:
     bool noForces(double, double, unsigned) const;
     void computeForces(const vpsc::Dim dim, SparseMap &H, 
             std::valarray<double> &g);
+    void computeForces(const vpsc::Dim dim, SparseMatrix &H, 
+            std::valarray<double> &g);
+    double computeTerms(const vpsc::Dim dim, SparseMatrix *H, 
+            std::valarray<double> *g, 
+            std::vector<SparseMatrix> *blocks) const;
+    void computeExactRows(const vpsc::Dim dim, const unsigned begin,
+            const unsigned end, SparseMatrix *H, std::valarray<double> *g,
+            std::vector<double>& rowStress) const;
+    void computeApproximateRows(const vpsc::Dim dim, const QuadTree& tree,
+            const unsigned begin, const unsigned end, SparseMatrix *H, 
+            std::valarray<double> *g, 
+            std::vector<double>& rowStress) const;
     void recGenerateClusterVariablesAndConstraints(
             vpsc::Variables (&vars)[2], unsigned int& priority, 
             cola::NonOverlapConstraints *noc, Cluster *cluster, 
@@ -603,8 +671,8 @@ private:
     TestConvergence& done;
     PreIteration* preIteration;
     cola::CompoundConstraints ccs;
-    double** D;
-    unsigned short** G;
+    PathLengths *pathLengths;
+    PathLengthsCache *pathLengthsCache;
 
     TopologyAddonInterface *topologyAddon;
     std::vector<UnsatisfiableConstraintInfos*> unsatisfiable;
@@ -616,6 +684,13 @@ private:
     double rectClusterBuffer;
     double m_idealEdgeLength;
     bool m_generateNonOverlapConstraints;
+    bool m_approximateForces;
+    double m_approximationTheta;
+    double m_exactRadius;
+    unsigned m_workerCount;
+    // Reused between iterations to avoid reallocating their storage.
+    SparseMatrix hessian;
+    std::vector<SparseMatrix> hessianBlocks;
 
     friend class topology::ColaTopologyAddon;
 };
@@ -29,6 +29,10 @@
 #include <vector>
 #include <cmath>
 #include <limits>
+#include <algorithm>
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
 
 #include "libvpsc/solve_VPSC.h"
 #include "libvpsc/variable.h"
@@ -41,6 +45,9 @@
 #include "libcola/straightener.h"
 #include "libcola/cc_clustercontainmentconstraints.h"
 #include "libcola/cc_nonoverlapconstraints.h"
+#include "libcola/quadtree.h"
+#include "libcola/path_lengths.h"
+#include "libcola/stress_kernel.h"
 
 #ifdef MAKEFEASIBLE_DEBUG
   #include "libcola/output_svg.h"
@@ -88,19 +95,27 @@ void dumpSquareMatrix(unsigned n, T** L) {
 ConstrainedFDLayout::ConstrainedFDLayout(const vpsc::Rectangles& rs,
         const std::vector< Edge >& es, const double idealLength,
         const bool preventOverlaps, const double* eLengths, 
-        TestConvergence& done, PreIteration* preIteration) 
+        TestConvergence& done, PreIteration* preIteration,
+        PathLengthsCache* pathLengthsCache) 
     : n(rs.size()),
       X(valarray<double>(n)),
       Y(valarray<double>(n)),
       done(done),
       preIteration(preIteration),
+      pathLengths(NULL),
+      pathLengthsCache(pathLengthsCache),
       topologyAddon(new TopologyAddonInterface()),
       rungekutta(true),
       desiredPositions(NULL),
       clusterHierarchy(NULL),
       rectClusterBuffer(0),
       m_idealEdgeLength(idealLength),
-      m_generateNonOverlapConstraints(preventOverlaps)
+      m_generateNonOverlapConstraints(preventOverlaps),
+      m_approximateForces(false),
+      m_approximationTheta(0.7),
+      m_exactRadius(0),
+      m_workerCount(1),
+      hessian(n)
 {
     //FILELog::ReportingLevel() = logDEBUG1;
     FILELog::ReportingLevel() = logERROR;
@@ -112,13 +127,6 @@ ConstrainedFDLayout::ConstrainedFDLayout(const vpsc::Rectangles& rs,
         Y[i]=(*ri)->getCentreY();
         FILE_LOG(logDEBUG) << *ri;
     }
-    D=new double*[n];
-    G=new unsigned short*[n];
-    for(unsigned i=0;i<n;i++) {
-        D[i]=new double[n];
-        G[i]=new unsigned short[n];
-    }
-
     if(eLengths == NULL) {
         computePathLengths(es,NULL);
     } else {
@@ -135,11 +143,11 @@ void dijkstra(const unsigned s, const unsigned n, double* d,
 }
 
 /**
- * Sets up the D and G matrices.  D is the required euclidean distances
- * between pairs of nodes based on the shortest paths between them (using
- * m_idealEdgeLength*eLengths[edge] as the edge length, if eLengths array 
- * is provided otherwise just m_idealEdgeLength).  G is a matrix of 
- * unsigned ints such that G[u][v]=
+ * Sets up the ideal distances D and pair types G.  D is the required 
+ * euclidean distances between pairs of nodes based on the shortest paths 
+ * between them (using m_idealEdgeLength*eLengths[edge] as the edge length,
+ * if eLengths array is provided otherwise just m_idealEdgeLength).  G is a 
+ * matrix of unsigned ints such that G[u][v]=
  *   0 if there are no forces required between u and v 
  *     (for example, if u and v are in unconnected components)
  *   1 if attractive forces are required between u and v
@@ -148,33 +156,56 @@ void dijkstra(const unsigned s, const unsigned n, double* d,
  *      is computed elsewhere))
  *   2 if no attractive force is required between u and v but there is
  *     a connected path between them.
+ * Both are held in a PathLengths store.  Graphs of up to 
+ * DENSE_PATH_LENGTHS_MAX_NODES nodes store them as full n*n matrices, 
+ * larger graphs use the memory-bounded LandmarkPathLengths.  If the 
+ * layout was given a PathLengthsCache the store comes from that instead.
  */
 void ConstrainedFDLayout::computePathLengths(
         const vector<Edge>& es,
         const std::valarray<double>* eLengths) 
 {
-    shortest_paths::johnsons(n,D,es,eLengths);
-    //dumpSquareMatrix<double>(n,D);
-    for(unsigned i=0;i<n;i++) {
-        for(unsigned j=0;j<n;j++) {
-            if(i==j) continue;
-            double& d=D[i][j];
-            unsigned short& p=G[i][j];
-            p=2;
-            if(d==DBL_MAX) {
-                // i and j are in disconnected subgraphs
-                p=0;
-            } else if(!eLengths) {
-                D[i][j]*=m_idealEdgeLength;
-            }
+    if(pathLengthsCache) {
+        pathLengths=pathLengthsCache->pathLengths(n,es,eLengths,
+                m_idealEdgeLength);
+    } else {
+        delete pathLengths;
+        if(n<=DENSE_PATH_LENGTHS_MAX_NODES) {
+            pathLengths=new DensePathLengths(n,es,eLengths,m_idealEdgeLength);
+        } else {
+            pathLengths=new LandmarkPathLengths(n,es,eLengths,
+                    m_idealEdgeLength);
         }
     }
+    neighbours.assign(n,vector<unsigned>());
     for(vector<Edge>::const_iterator e=es.begin();e!=es.end();++e) {
         unsigned u=e->first, v=e->second; 
-        G[u][v]=G[v][u]=1;
+        if(u!=v) {
+            neighbours[u].push_back(v);
+            neighbours[v].push_back(u);
+        }
+    }
+    for(unsigned i=0;i<n;i++) {
+        vector<unsigned>& ns=neighbours[i];
+        std::sort(ns.begin(),ns.end());
+        ns.erase(std::unique(ns.begin(),ns.end()),ns.end());
     }
-    topologyAddon->computePathLengths(G);
-    //dumpSquareMatrix<short>(n,G);
+    topologyAddon->computePathLengths(*pathLengths);
+}
+
+void ConstrainedFDLayout::setApproximateForces(const bool approximate,
+        const double theta, const double exactRadius)
+{
+    COLA_ASSERT(theta>=0);
+    COLA_ASSERT(exactRadius>=0);
+    m_approximateForces=approximate;
+    m_approximationTheta=theta;
+    m_exactRadius=exactRadius;
+}
+
+void ConstrainedFDLayout::setWorkerCount(const unsigned workers)
+{
+    m_workerCount=workers;
 }
 
 typedef valarray<double> Position;
@@ -701,13 +732,9 @@ void ConstrainedFDLayout::makeFeasible(void)
 
 ConstrainedFDLayout::~ConstrainedFDLayout()
 {
-    for (unsigned i = 0; i < n; ++i)
-    {
-        delete [] G[i];
-        delete [] D[i];
+    if(!pathLengthsCache) {
+        delete pathLengths;
     }
-    delete [] G;
-    delete [] D;
     delete topologyAddon;
 }
 
@@ -924,9 +951,8 @@ double ConstrainedFDLayout::applyForcesAndConstraints(const vpsc::Dim dim, const
         // Add non-overlap constraints, but not variables again.
         setupExtraConstraints(extraConstraints, dim, vs, cs, boundingBoxes);
         // Projection.
-        SparseMap HMap(n);
-        computeForces(dim,HMap,g);
-        SparseMatrix H(HMap);
+        computeForces(dim,hessian,g);
+        const SparseMatrix& H=hessian;
         valarray<double> oldCoords=coords;
         applyDescentVector(g,oldCoords,coords,oldStress,computeStepSize(H,g,g));
         setVariableDesiredPositions(vs,cs,des,coords);
@@ -983,43 +1009,37 @@ double ConstrainedFDLayout::applyDescentVector(
     return computeStress();
 }
         
+// The contents of a valarray, for the stress kernel.  (In C++98 the
+// const operator[] returns by value.)
+static inline const double* data(const valarray<double>& a) {
+    return &const_cast<valarray<double>&>(a)[0];
+}
+/**
+ * As below, but adding the Hessian entries to the map H.  This allows 
+ * further terms, such as those for topology preserving layout, to be 
+ * accumulated into it before the step size is computed.
+ */
+void ConstrainedFDLayout::computeForces(
+        const vpsc::Dim dim,
+        SparseMap &H,
+        valarray<double> &g) {
+    computeForces(dim,hessian,g);
+    hessian.addTo(H);
+}
 /**
  * Computes:
  *  - the matrix of second derivatives (the Hessian) H, used in 
  *    calculating stepsize; and
  *  - the vector g, the negative gradient (steepest-descent) direction.
+ * H is assembled directly in compressed row form, reusing its storage.
  */
 void ConstrainedFDLayout::computeForces(
         const vpsc::Dim dim,
-        SparseMap &H,
+        SparseMatrix &H,
         valarray<double> &g) {
     if(n==1) return;
     g=0;
-    // for each node:
-    for(unsigned u=0;u<n;u++) {
-        // Stress model
-        double Huu=0;
-        for(unsigned v=0;v<n;v++) {
-            if(u==v) continue;
-            unsigned short p = G[u][v];
-            // no forces between disconnected parts of the graph
-            if(p==0) continue;
-            double rx=X[u]-X[v], ry=Y[u]-Y[v];
-            double l=sqrt(rx*rx+ry*ry);
-            double d=D[u][v];
-            if(l>d && p>1) continue; // attractive forces not required
-            double d2=d*d;
-            /* force apart zero distances */
-            if (l < 1e-30) {
-                l=0.1;
-            }
-            double dx=dim==vpsc::HORIZONTAL?rx:ry;
-            double dy=dim==vpsc::HORIZONTAL?ry:rx;
-            g[u]+=dx*(l-d)/(d2*l);
-            Huu-=H(u,v)=(d*dy*dy/(l*l*l)-1)/d2;
-        }
-        H(u,u)=Huu;
-    }
+    computeTerms(dim,&H,&g,&hessianBlocks);
     if(desiredPositions) {
         for(DesiredPositions::const_iterator p=desiredPositions->begin();
             p!=desiredPositions->end();++p) {
@@ -1028,7 +1048,7 @@ void ConstrainedFDLayout::computeForces(
                 ?p->x-X[i]:p->y-Y[i];
             d*=p->weight;
             g[i]-=d;
-            H(i,i)+=p->weight;
+            H.diagonal(i)+=p->weight;
         }
     }
 }
@@ -1060,23 +1080,7 @@ double ConstrainedFDLayout::computeStepSize(
  */
 double ConstrainedFDLayout::computeStress() const {
     FILE_LOG(logDEBUG)<<"ConstrainedFDLayout::computeStress()";
-    double stress=0;
-    for(unsigned u=0;(u + 1)<n;u++) {
-        for(unsigned v=u+1;v<n;v++) {
-            unsigned short p=G[u][v];
-            // no forces between disconnected parts of the graph
-            if(p==0) continue;
-            double rx=X[u]-X[v], ry=Y[u]-Y[v];
-            double l=sqrt(rx*rx+ry*ry);
-            double d=D[u][v];
-            if(l>d && p>1) continue; // no attractive forces required
-            double d2=d*d;
-            double rl=d-l;
-            double s=rl*rl/d2;
-            stress+=s;
-            FILE_LOG(logDEBUG2)<<"s("<<u<<","<<v<<")="<<s;
-        }
-    }
+    double stress=computeTerms(vpsc::HORIZONTAL,NULL,NULL,NULL);
     if(preIteration) {
         if ((*preIteration)()) {
             for(vector<Lock>::iterator l=preIteration->locks.begin();
@@ -1098,6 +1102,256 @@ double ConstrainedFDLayout::computeStress() const {
     }
     return stress;
 }
+/**
+ * The p-stress terms for a node u against a node at offset (rx,ry) from it
+ * with ideal distance d: the stress s, the negative gradient gu in 
+ * dimension dim and the off-diagonal Hessian entry h.  Returns false if 
+ * the pair is classified p>1 and already far enough apart.
+ */
+static inline bool pairTerm(const vpsc::Dim dim, const double rx,
+        const double ry, const double d, const unsigned short p,
+        double& s, double& gu, double& h)
+{
+    double l=sqrt(rx*rx+ry*ry);
+    if(l>d && p>1) return false; // attractive forces not required
+    double d2=d*d;
+    double rl=d-l;
+    s=rl*rl/d2;
+    /* force apart zero distances */
+    if (l < 1e-30) {
+        l=0.1;
+    }
+    double dx=dim==vpsc::HORIZONTAL?rx:ry;
+    double dy=dim==vpsc::HORIZONTAL?ry:rx;
+    gu=dx*(l-d)/(d2*l);
+    h=(d*dy*dy/(l*l*l)-1)/d2;
+    return true;
+}
+// First row of block b when n rows are divided into count blocks.
+static inline unsigned blockBegin(const unsigned n, const unsigned count,
+        const unsigned b) {
+    return (n/count)*b+std::min(b,n%count);
+}
+/**
+ * Computes the stress and, if H is not NULL, the Hessian H and negative
+ * gradient g, either exactly or by approximation.  With more than one 
+ * worker the rows are divided into blocks computed in parallel, each
+ * assembled into its own matrix from blocks, and the blocks are then 
+ * copied into H in order.  Every row is computed the same way however the
+ * rows are divided and the row stresses are summed in order, so the 
+ * result does not depend on the number of workers.
+ * @return the stress
+ */
+double ConstrainedFDLayout::computeTerms(const vpsc::Dim dim,
+        SparseMatrix *H, valarray<double> *g, 
+        vector<SparseMatrix> *blocks) const {
+    COLA_ASSERT((H==NULL)==(g==NULL));
+    COLA_ASSERT(H==NULL || blocks!=NULL);
+    if(n<2) return 0;
+    int workers=1;
+#ifdef _OPENMP
+    workers=m_workerCount>0?m_workerCount:omp_get_num_procs();
+#endif
+    // Several blocks per worker even out the uneven cost of rows.
+    const unsigned blockCount=std::min(n,4*(unsigned)workers);
+    const bool split=workers>1;
+    if(H && split) {
+        blocks->resize(blockCount,SparseMatrix(n));
+    }
+    const QuadTree* tree=m_approximateForces?new QuadTree(X,Y):NULL;
+    vector<double> rowStress(n,0);
+    const int count=split?blockCount:1;
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic) num_threads(workers) if(split)
+#endif
+    for(int b=0;b<count;b++) {
+        const unsigned begin=blockBegin(n,count,b);
+        const unsigned end=blockBegin(n,count,b+1);
+        SparseMatrix* M=(H && split)?&(*blocks)[b]:H;
+        if(M) {
+            M->beginAssembly();
+        }
+        if(tree) {
+            computeApproximateRows(dim,*tree,begin,end,M,g,rowStress);
+        } else {
+            computeExactRows(dim,begin,end,M,g,rowStress);
+        }
+        if(M) {
+            M->endAssembly();
+        }
+    }
+    if(H && split) {
+        H->beginAssembly();
+        for(int b=0;b<count;b++) {
+            H->addRows((*blocks)[b],blockBegin(n,count,b),
+                    blockBegin(n,count,b+1));
+        }
+        H->endAssembly();
+    }
+    double stress=0;
+    for(unsigned u=0;u<n;u++) {
+        stress+=rowStress[u];
+    }
+    if(tree) {
+        delete tree;
+        // Each pair was counted from both ends.
+        stress/=2;
+    }
+    return stress;
+}
+/**
+ * The exact terms for rows [begin,end).  If H is NULL only the stress is
+ * required, and each pair is counted once, from its lower numbered node.
+ */
+void ConstrainedFDLayout::computeExactRows(const vpsc::Dim dim,
+        const unsigned begin, const unsigned end, SparseMatrix *H,
+        valarray<double> *g, vector<double>& rowStress) const {
+    const StressKernel kernel=stressKernel();
+    const double* P=data(dim==vpsc::HORIZONTAL?X:Y);
+    const double* S=data(dim==vpsc::HORIZONTAL?Y:X);
+    vector<double> dBuffer(n), hBuffer(n);
+    vector<unsigned short> gBuffer(n);
+    double* h=H?&hBuffer[0]:NULL;
+    for(unsigned u=begin;u<end;u++) {
+        const double* Du=pathLengths->distances(u,&dBuffer[0]);
+        const unsigned short* Gu=pathLengths->pairTypes(u,&gBuffer[0]);
+        // Stress model
+        StressTerms terms;
+        if(H) {
+            kernel(P,S,Du,Gu,u,0,u,h,terms);
+        }
+        kernel(P,S,Du,Gu,u,u+1,n,h,terms);
+        rowStress[u]=terms.stress;
+        FILE_LOG(logDEBUG2)<<"s("<<u<<",*)="<<terms.stress;
+        if(H) {
+            H->beginRow(u);
+            hBuffer[u]=0;
+            for(unsigned v=0;v<n;v++) {
+                // pairs without forces have zero entries
+                if(hBuffer[v]!=0) {
+                    H->add(v)=hBuffer[v];
+                }
+            }
+            (*g)[u]+=terms.gradient;
+            H->add(u)=terms.hessianDiagonal;
+            H->endRow();
+        }
+    }
+}
+/**
+ * Barnes-Hut style approximation of the terms for rows [begin,end), 
+ * counting every pair from both ends.  For each node u, cells of the 
+ * quadtree over the current positions that are far away relative to their
+ * size (size/distance < m_approximationTheta) and lying wholly outside the
+ * exact radius are treated as a single body at their centre of mass.  The
+ * ideal distance of u to such a body is taken as its graph distance to the
+ * node nearest the centre of mass, or the ideal edge length if there is no
+ * path to that node.  Terms between u and its graph neighbours are always
+ * exact.  Far-away bodies only contribute to the diagonal of H.
+ */
+void ConstrainedFDLayout::computeApproximateRows(const vpsc::Dim dim,
+        const QuadTree& tree, const unsigned begin, const unsigned end,
+        SparseMatrix *H, valarray<double> *g, 
+        vector<double>& rowStress) const {
+    const double exactRadius=(m_exactRadius>0)?m_exactRadius:m_idealEdgeLength;
+    const double theta2=m_approximationTheta*m_approximationTheta;
+    // neighbourOf[v]==u+1 marks v as a graph neighbour of the current u.
+    vector<unsigned> neighbourOf(n,0);
+    vector<unsigned> stack;
+    for(unsigned u=begin;u<end;u++) {
+        const double xu=X[u], yu=Y[u];
+        double stress=0, Huu=0;
+        if(H) {
+            H->beginRow(u);
+        }
+        for(vector<unsigned>::const_iterator v=neighbours[u].begin();
+                v!=neighbours[u].end();++v) {
+            neighbourOf[*v]=u+1;
+        }
+        for(vector<unsigned>::const_iterator v=neighbours[u].begin();
+                v!=neighbours[u].end();++v) {
+            unsigned short p=pathLengths->pairType(u,*v);
+            if(p==0) continue;
+            double s,gu,h;
+            if(!pairTerm(dim,xu-X[*v],yu-Y[*v],
+                        pathLengths->distance(u,*v),p,s,gu,h)) {
+                continue;
+            }
+            stress+=s;
+            if(g) {
+                (*g)[u]+=gu;
+                Huu-=H->add(*v)=h;
+            }
+        }
+        stack.clear();
+        stack.push_back(0);
+        while(!stack.empty()) {
+            const QuadTree::Cell& c=tree.cell(stack.back());
+            stack.pop_back();
+            const double rx=xu-c.cx, ry=yu-c.cy;
+            const double r2=rx*rx+ry*ry;
+            const double size=c.size();
+            // Distance from u to the nearest point of the cell's bounds,
+            // which no node of the cell is closer than.
+            const double bx=std::max(0.0,std::max(c.minX-xu,xu-c.maxX));
+            const double by=std::max(0.0,std::max(c.minY-yu,yu-c.maxY));
+            if(!tree.inCell(u,c) && bx*bx+by*by>exactRadius*exactRadius 
+                    && size*size<theta2*r2) {
+                // Far enough away: treat the cell as a single body, 
+                // leaving out neighbours of u since those were exact.
+                unsigned m=c.count();
+                for(vector<unsigned>::const_iterator v=neighbours[u].begin();
+                        v!=neighbours[u].end();++v) {
+                    if(tree.inCell(*v,c)) --m;
+                }
+                if(m==0) continue;
+                // If the representative is not connected to u there is no
+                // graph distance to use, so fall back to the ideal edge 
+                // length rather than leaving out the whole cell.
+                const unsigned w=c.representative;
+                const double d=pathLengths->pairType(u,w)!=0
+                        ?pathLengths->distance(u,w):m_idealEdgeLength;
+                double s,gu,h;
+                if(!pairTerm(dim,rx,ry,d,2,s,gu,h)) {
+                    continue;
+                }
+                stress+=m*s;
+                if(g) {
+                    (*g)[u]+=m*gu;
+                    Huu-=m*h;
+                }
+            } else if(c.isLeaf()) {
+                for(unsigned i=c.begin;i<c.end;++i) {
+                    const unsigned v=tree.node(i);
+                    if(v==u || neighbourOf[v]==u+1) continue;
+                    unsigned short p=pathLengths->pairType(u,v);
+                    if(p==0) continue;
+                    double s,gu,h;
+                    if(!pairTerm(dim,xu-X[v],yu-Y[v],
+                                pathLengths->distance(u,v),p,s,gu,h)) {
+                        continue;
+                    }
+                    stress+=s;
+                    if(g) {
+                        (*g)[u]+=gu;
+                        Huu-=H->add(v)=h;
+                    }
+                }
+            } else {
+                for(unsigned q=0;q<4;++q) {
+                    if(c.children[q]!=QuadTree::NO_CHILD) {
+                        stack.push_back(c.children[q]);
+                    }
+                }
+            }
+        }
+        rowStress[u]=stress;
+        if(H) {
+            H->add(u)=Huu;
+            H->endRow();
+        }
+    }
+}
 void ConstrainedFDLayout::moveBoundingBoxes() {
     for(unsigned i=0;i<n;i++) {
         boundingBoxes[i]->moveCentre(X[i],Y[i]);
@@ -1199,9 +1453,10 @@ void ConstrainedFDLayout::outputInstanceToSVG(std::string instanceName)
     
     for (size_t i = 0; i < n; ++i)
     {
-        for (size_t j =  i + 1; j < n; ++j)
+        for (size_t k = 0; k < neighbours[i].size(); ++k)
         {
-            if (G[i][j] == 1)
+            size_t j = neighbours[i][k];
+            if (j > i && pathLengths->pairType(i, j) == 1)
             {
                 fprintf(fp, "    es.push_back(std::make_pair(%lu, %lu));\n", i, j);
             }
@@ -1249,9 +1504,10 @@ void ConstrainedFDLayout::outputInstanceToSVG(std::string instanceName)
             "inkscape:label=\"Edges\">\n");
     for (size_t i = 0; i < n; ++i)
     {
-        for (size_t j =  i + 1; j < n; ++j)
+        for (size_t k = 0; k < neighbours[i].size(); ++k)
         {
-            if (G[i][j] == 1)
+            size_t j = neighbours[i][k];
+            if (j > i && pathLengths->pairType(i, j) == 1)
             {
                 fprintf(fp, "<path d=\"M %g %g L %g %g\" "
                         "style=\"stroke-width: 1px; stroke: black;\" />\n",
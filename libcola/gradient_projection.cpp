@@ -33,6 +33,7 @@
 #include <iostream>
 #include <cmath>
 #include <ctime>
+#include <map>
 
 #include <libvpsc/solve_VPSC.h>
 #include <libvpsc/variable.h>
@@ -73,6 +74,8 @@ GradientProjection::GradientProjection(
           tolerance(tol), 
           max_iterations(max_iterations),
           sparseQ(NULL),
+          solver(NULL),
+          persistentSolver(false),
           solveWithMosek(solveWithMosek),
           scaling(scaling)
 {
@@ -254,7 +257,12 @@ unsigned GradientProjection::solve(
 
     bool converged=false;
 
-    solver = setupVPSC();
+    if(solver && canKeepSolver()) {
+        updateVPSC();
+    } else {
+        releaseSolver();
+        solver = setupVPSC();
+    }
 #ifdef MOSEK_AVAILABLE
     if(solveWithMosek==Outer) {
         float* ba=new float[vars.size()];
@@ -380,28 +388,7 @@ unsigned GradientProjection::solve(
 // global constraint list (including alignment constraints,
 // dir-edge constraints, containment constraints, etc).
 IncSolver* GradientProjection::setupVPSC() {
-    if(nonOverlapConstraints!=None) {
-        if(clusterHierarchy) {
-            //printf("Setup up cluster constraints, dim=%d--------------\n",k);
-            //clusterHierarchy->generateNonOverlapConstraints(k,nonOverlapConstraints,*rs,vars,lcs);
-        } else {
-            for(vector<OrthogonalEdgeConstraint*>::iterator i=orthogonalEdges.begin();i!=orthogonalEdges.end();i++) {
-                OrthogonalEdgeConstraint* e=*i;
-                e->generateTopologyConstraints(k,*rs,vars,lcs);
-            }
-            if(k==HORIZONTAL) {
-                // Make rectangles a little bit wider when processing horizontally so that any overlap
-                // resolved horizontally is strictly non-overlapping when processing vertically
-                Rectangle::setXBorder(0.0001);
-                // use rs->size() rather than n because some of the variables may
-                // be dummy vars with no corresponding rectangle
-                generateXConstraints(*rs,vars,lcs,nonOverlapConstraints==Both?true:false); 
-                Rectangle::setXBorder(0);
-            } else {
-                generateYConstraints(*rs,vars,lcs); 
-            }
-        }
-    }
+    generateLocalConstraints(lcs);
     cs=gcs;
     cs.insert(cs.end(),lcs.begin(),lcs.end());
     switch(solveWithMosek) {
@@ -430,7 +417,114 @@ IncSolver* GradientProjection::setupVPSC() {
     }
     return new IncSolver(vars,cs);
 }
+// Generate the transient local constraints for one iteration into local.
+void GradientProjection::generateLocalConstraints(Constraints &local) {
+    if(nonOverlapConstraints!=None) {
+        if(clusterHierarchy) {
+            //printf("Setup up cluster constraints, dim=%d--------------\n",k);
+            //clusterHierarchy->generateNonOverlapConstraints(k,nonOverlapConstraints,*rs,vars,local);
+        } else {
+            for(vector<OrthogonalEdgeConstraint*>::iterator i=orthogonalEdges.begin();i!=orthogonalEdges.end();i++) {
+                OrthogonalEdgeConstraint* e=*i;
+                e->generateTopologyConstraints(k,*rs,vars,local);
+            }
+            if(k==HORIZONTAL) {
+                // Make rectangles a little bit wider when processing horizontally so that any overlap
+                // resolved horizontally is strictly non-overlapping when processing vertically
+                Rectangle::setXBorder(0.0001);
+                // use rs->size() rather than n because some of the variables may
+                // be dummy vars with no corresponding rectangle
+                constraintGenerator.generateXConstraints(*rs,vars,local,nonOverlapConstraints==Both?true:false); 
+                Rectangle::setXBorder(0);
+            } else {
+                constraintGenerator.generateYConstraints(*rs,vars,local); 
+            }
+        }
+    }
+}
+// Bring the kept solver up to date for this iteration.  The local 
+// constraints are regenerated and matched, by the variables they separate,
+// against those of the previous iteration.  Matching constraints are kept,
+// so that active ones stay merged into their blocks, and only the 
+// constraints that appeared, disappeared or changed gap are passed to the
+// solver.
+void GradientProjection::updateVPSC() {
+    typedef std::multimap<std::pair<Variable*,Variable*>,Constraint*> 
+            ConstraintMap;
+    Constraints generated;
+    generateLocalConstraints(generated);
+
+    ConstraintMap previous;
+    for(Constraints::iterator i=lcs.begin();i!=lcs.end();++i) {
+        Constraint* c=*i;
+        previous.insert(std::make_pair(std::make_pair(c->left,c->right),c));
+    }
+    Constraints kept, added, changed;
+    for(Constraints::iterator i=generated.begin();i!=generated.end();++i) {
+        Constraint* c=*i;
+        std::pair<ConstraintMap::iterator,ConstraintMap::iterator> range=
+            previous.equal_range(std::make_pair(c->left,c->right));
+        ConstraintMap::iterator match=range.first;
+        while(match!=range.second && match->second->equality!=c->equality) {
+            ++match;
+        }
+        if(match==range.second) {
+            added.push_back(c);
+            continue;
+        }
+        Constraint* old=match->second;
+        previous.erase(match);
+        if(old->gap!=c->gap || old->unsatisfiable) {
+            // Re-added so that an active constraint is split out of its 
+            // block and merged again at its new gap.
+            old->gap=c->gap;
+            changed.push_back(old);
+        }
+        kept.push_back(old);
+        delete c;
+    }
+
+    Constraints removed;
+    for(ConstraintMap::iterator i=previous.begin();i!=previous.end();++i) {
+        removed.push_back(i->second);
+    }
+    Constraints doomed(removed);
+    doomed.insert(doomed.end(),changed.begin(),changed.end());
+    solver->removeConstraints(doomed);
+    for(Constraints::iterator i=removed.begin();i!=removed.end();++i) {
+        delete *i;
+    }
+    for(Constraints::iterator i=changed.begin();i!=changed.end();++i) {
+        (*i)->unsatisfiable=false;
+        solver->addConstraint(*i);
+    }
+    for(Constraints::iterator i=added.begin();i!=added.end();++i) {
+        solver->addConstraint(*i);
+    }
+
+    lcs=kept;
+    lcs.insert(lcs.end(),added.begin(),added.end());
+    cs=gcs;
+    cs.insert(cs.end(),lcs.begin(),lcs.end());
+}
+// The solver can only be kept while its variables stay the same and it is
+// the one used to solve.
+bool GradientProjection::canKeepSolver() const {
+    return persistentSolver && solveWithMosek==Off && sparseQ==NULL;
+}
+// Free the solver and the local constraints it was set up with.
+void GradientProjection::releaseSolver() {
+    for(vector<Constraint*>::iterator i=lcs.begin();i!=lcs.end();i++) {
+        delete *i;
+    }
+    lcs.clear();
+    delete solver;
+    solver=NULL;
+}
 void GradientProjection::destroyVPSC(IncSolver *vpsc) {
+    COLA_ASSERT(vpsc==solver);
+    // Checked before sparseQ is cleared below.
+    const bool keepSolver=canKeepSolver();
     if(ccs) {
         for(CompoundConstraints::const_iterator c=ccs->begin(); 
                 c!=ccs->end();++c) {
@@ -458,11 +552,9 @@ void GradientProjection::destroyVPSC(IncSolver *vpsc) {
         vars.resize(numStaticVars);
         sparseQ=NULL;
     }
-    for(vector<Constraint*>::iterator i=lcs.begin();i!=lcs.end();i++) {
-        delete *i;
+    if(!keepSolver) {
+        releaseSolver();
     }
-    lcs.clear();
-    delete vpsc;
 #ifdef MOSEK_AVAILABLE
     if(solveWithMosek!=Off) mosek_delete(menv);
 #endif
@@ -474,6 +566,8 @@ void GradientProjection::straighten(
 {
     COLA_ASSERT(Q->rowSize()==snodes.size());
     COLA_ASSERT(vars.size()==numStaticVars);
+    // The kept solver was set up without the dummy variables.
+    releaseSolver();
     sparseQ = Q;
     for(unsigned i=numStaticVars;i<snodes.size();i++) {
         Variable* v=new vpsc::Variable(i,snodes[i]->pos[k],1);
@@ -92,7 +92,7 @@ public:
         return numStaticVars;
     }
     ~GradientProjection() {
-        //destroyVPSC(solver);
+        releaseSolver();
         for(vpsc::Constraints::iterator i(gcs.begin()); i!=gcs.end(); i++) {
             delete *i;
         }
@@ -123,8 +123,27 @@ public:
     std::valarray<double> const & getFullResult() const {
         return result;
     }
+    /**
+     * In persistent-solver mode the VPSC solver, its block structure and
+     * the non-overlap constraints are kept between calls to solve().  The
+     * constraints are regenerated each call, but only those that differ
+     * from the previous call's are added to or removed from the solver, 
+     * which then resumes from the previous active set.  This makes
+     * successive solves of a slowly changing layout much cheaper.  It is
+     * off by default.
+     */
+    void setPersistentSolver(const bool persistent) {
+        persistentSolver=persistent;
+        if(!persistent) {
+            releaseSolver();
+        }
+    }
 private:
     vpsc::IncSolver* setupVPSC();
+    void generateLocalConstraints(vpsc::Constraints &local);
+    void updateVPSC();
+    bool canKeepSolver() const;
+    void releaseSolver();
     double computeCost(std::valarray<double> const &b,
         std::valarray<double> const &x) const;
     double computeSteepestDescentVector(
@@ -144,6 +163,8 @@ private:
     std::valarray<double> *denseQ; // dense square graph laplacian matrix
     std::valarray<double> scaledDenseQ; // scaled dense square graph laplacian matrix
     std::vector<vpsc::Rectangle*>* rs;
+    vpsc::ConstraintGenerator constraintGenerator; // keeps the non-overlap
+                                     // sweep order between iterations
     CompoundConstraints const *ccs;
     UnsatisfiableConstraintInfos *unsatisfiableConstraints;
     NonOverlapConstraintsMode nonOverlapConstraints;
@@ -162,6 +183,7 @@ private:
     MosekEnv* menv;
 #endif
     vpsc::IncSolver* solver;
+    bool persistentSolver;
     SolveWithMosek solveWithMosek;
     const bool scaling;
     std::vector<OrthogonalEdgeConstraint*> orthogonalEdges;
@@ -25,7 +25,10 @@ SOURCES += cola.cpp \
     max_acyclic_subgraph.cpp \
     output_svg.cpp \
     cc_clustercontainmentconstraints.cpp \
-    cc_nonoverlapconstraints.cpp
+    cc_nonoverlapconstraints.cpp \
+    quadtree.cpp \
+    path_lengths.cpp \
+    stress_kernel.cpp
 HEADERS += cola.h \
     cluster.h \
     commondefs.h \
@@ -38,4 +41,7 @@ HEADERS += cola.h \
     cc_clustercontainmentconstraints.h \
     cc_nonoverlapconstraints.h \
     unused.h \
-    config.h
+    config.h \
+    quadtree.h \
+    path_lengths.h \
+    stress_kernel.h
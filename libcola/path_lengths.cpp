@@ -0,0 +1,721 @@
+/*
+ * vim: ts=4 sw=4 et tw=0 wm=0
+ *
+ * libcola - A library providing force-directed network layout using the
+ *           stress-majorization method subject to separation constraints.
+ *
+ * Copyright (C) 2026  Dunnart contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library in the file LICENSE; if not,
+ * write to the Free Software Foundation, Inc., 59 Temple Place,
+ * Suite 330, Boston, MA  02111-1307  USA
+ *
+*/
+
+#include <cfloat>
+#include <cmath>
+#include <queue>
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+
+#include "libvpsc/assertions.h"
+#include "libcola/commondefs.h"
+#include "libcola/shortest_paths.h"
+#include "libcola/path_lengths.h"
+
+using std::vector;
+using std::valarray;
+
+namespace cola {
+
+// The key for the pair (u,v) in the maps of DensePathLengths.
+static inline Edge pairKey(const unsigned u, const unsigned v)
+{
+    return (u<v)?Edge(u,v):Edge(v,u);
+}
+
+DensePathLengths::DensePathLengths(const unsigned n, const vector<Edge>& es,
+        const valarray<double> *eLengths, const double scale)
+    : PathLengths(n),
+      scale(scale)
+{
+    D=new double*[n];
+    G=new unsigned short*[n];
+    for(unsigned i=0;i<n;i++) {
+        D[i]=new double[n];
+        G[i]=new unsigned short[n];
+    }
+    shortest_paths::johnsons(n,D,es,eLengths);
+    for(unsigned i=0;i<n;i++) {
+        G[i][i]=0;
+        for(unsigned j=0;j<n;j++) {
+            if(i==j) continue;
+            double& d=D[i][j];
+            unsigned short& p=G[i][j];
+            p=2;
+            if(d==DBL_MAX) {
+                // i and j are in disconnected subgraphs
+                p=0;
+            } else if(!eLengths) {
+                d*=scale;
+            }
+        }
+    }
+    for(vector<Edge>::const_iterator e=es.begin();e!=es.end();++e) {
+        unsigned u=e->first, v=e->second;
+        G[u][v]=G[v][u]=1;
+        m_edgeCount[pairKey(u,v)]++;
+    }
+}
+
+DensePathLengths::~DensePathLengths()
+{
+    for (unsigned i = 0; i < n; ++i)
+    {
+        delete [] G[i];
+        delete [] D[i];
+    }
+    delete [] G;
+    delete [] D;
+}
+
+void DensePathLengths::setPairType(const unsigned u, const unsigned v,
+        const unsigned short p)
+{
+    COLA_ASSERT(u<n && v<n);
+    G[u][v]=G[v][u]=p;
+    m_overriddenTypes[pairKey(u,v)]=p;
+}
+
+// The pair type of u and v as given by the graph alone.
+unsigned short DensePathLengths::graphPairType(const unsigned u,
+        const unsigned v) const
+{
+    if(u==v || D[u][v]==DBL_MAX) {
+        return 0;
+    }
+    std::map<Edge,unsigned>::const_iterator c=m_edgeCount.find(pairKey(u,v));
+    return (c!=m_edgeCount.end())?1:2;
+}
+
+// Reapplies the pair types set with setPairType() after an update, to the
+// pairs that are still connected.
+void DensePathLengths::applyPairTypeOverrides()
+{
+    for(std::map<Edge,unsigned short>::const_iterator o=
+            m_overriddenTypes.begin();o!=m_overriddenTypes.end();++o) {
+        const unsigned u=o->first.first, v=o->first.second;
+        if(D[u][v]!=DBL_MAX) {
+            G[u][v]=G[v][u]=o->second;
+        }
+    }
+}
+
+void DensePathLengths::clearPairTypeOverrides()
+{
+    for(std::map<Edge,unsigned short>::const_iterator o=
+            m_overriddenTypes.begin();o!=m_overriddenTypes.end();++o) {
+        const unsigned u=o->first.first, v=o->first.second;
+        G[u][v]=G[v][u]=graphPairType(u,v);
+    }
+    m_overriddenTypes.clear();
+}
+
+void DensePathLengths::addNode()
+{
+    double **newD=new double*[n+1];
+    unsigned short **newG=new unsigned short*[n+1];
+    for(unsigned i=0;i<=n;i++) {
+        newD[i]=new double[n+1];
+        newG[i]=new unsigned short[n+1];
+        if(i<n) {
+            std::copy(D[i],D[i]+n,newD[i]);
+            std::copy(G[i],G[i]+n,newG[i]);
+            delete [] D[i];
+            delete [] G[i];
+        }
+        newG[i][n]=0;
+    }
+    std::fill(newG[n],newG[n]+n+1,0);
+    delete [] D;
+    delete [] G;
+    D=newD;
+    G=newG;
+    ++n;
+    shortest_paths::add_node(n,D);
+}
+
+void DensePathLengths::addEdge(const unsigned u, const unsigned v,
+        const double length)
+{
+    COLA_ASSERT(u<n && v<n);
+    // If the edge joins two components, every pair between them becomes
+    // connected.
+    vector<unsigned> first, second;
+    if(D[u][v]==DBL_MAX) {
+        for(unsigned i=0;i<n;i++) {
+            if(D[i][u]!=DBL_MAX) {
+                first.push_back(i);
+            }
+            if(D[i][v]!=DBL_MAX) {
+                second.push_back(i);
+            }
+        }
+    }
+    shortest_paths::add_edge(n,D,u,v,length);
+    for(vector<unsigned>::iterator i=first.begin();i!=first.end();++i) {
+        for(vector<unsigned>::iterator j=second.begin();j!=second.end();++j) {
+            G[*i][*j]=G[*j][*i]=2;
+        }
+    }
+    m_edgeCount[pairKey(u,v)]++;
+    if(u!=v) {
+        G[u][v]=G[v][u]=1;
+    }
+    applyPairTypeOverrides();
+}
+
+void DensePathLengths::removeEdge(const unsigned u, const unsigned v,
+        const double length, const vector<Edge>& es,
+        const valarray<double> *eLengths)
+{
+    COLA_ASSERT(u<n && v<n);
+    if(eLengths) {
+        shortest_paths::remove_edge(n,D,es,eLengths,u,v,length);
+    } else {
+        const valarray<double> lengths(scale,es.size());
+        shortest_paths::remove_edge(n,D,es,&lengths,u,v,length);
+    }
+    for(unsigned i=0;i<n;i++) {
+        for(unsigned j=0;j<n;j++) {
+            if(D[i][j]==DBL_MAX) {
+                G[i][j]=0;
+            }
+        }
+    }
+    std::map<Edge,unsigned>::iterator c=m_edgeCount.find(pairKey(u,v));
+    COLA_ASSERT(c!=m_edgeCount.end());
+    if(--c->second==0) {
+        m_edgeCount.erase(c);
+    }
+    if(u!=v) {
+        // There may be another edge between them.
+        G[u][v]=G[v][u]=graphPairType(u,v);
+    }
+    applyPairTypeOverrides();
+}
+
+PathLengthsCache::PathLengthsCache()
+    : m_pathLengths(NULL)
+{
+}
+
+PathLengthsCache::~PathLengthsCache()
+{
+    delete m_pathLengths;
+}
+
+PathLengths *PathLengthsCache::pathLengths(const unsigned n,
+        const vector<Edge>& es, const valarray<double> *eLengths,
+        const double scale)
+{
+    COLA_ASSERT(!eLengths || eLengths->size()==es.size());
+    vector<double> lengths(es.size(),scale);
+    if(eLengths) {
+        for(unsigned i=0;i<es.size();i++) {
+            lengths[i]=(*eLengths)[i];
+        }
+    }
+    if(n<=DENSE_PATH_LENGTHS_MAX_NODES && update(n,es,lengths)) {
+        return m_pathLengths;
+    }
+    delete m_pathLengths;
+    m_edges.clear();
+    m_lengths.clear();
+    if(n<=DENSE_PATH_LENGTHS_MAX_NODES) {
+        m_pathLengths=new DensePathLengths(n,es,eLengths,scale);
+        m_edges=es;
+        m_lengths=lengths;
+    } else {
+        m_pathLengths=new LandmarkPathLengths(n,es,eLengths,scale);
+    }
+    return m_pathLengths;
+}
+
+/**
+ * Brings the kept DensePathLengths up to date with the graph, if the 
+ * differences are few enough.  Edges are matched by their ends and 
+ * length, so an edge whose length has changed counts as removed and 
+ * added.  Removals are applied first, each against the edges remaining 
+ * after it.
+ * @return whether the path lengths were updated
+ */
+bool PathLengthsCache::update(const unsigned n, const vector<Edge>& es,
+        const vector<double>& lengths)
+{
+    DensePathLengths *dense=dynamic_cast<DensePathLengths*>(m_pathLengths);
+    if(!dense || n<dense->size()) {
+        return false;
+    }
+    typedef std::pair<Edge,double> Key;
+    std::map<Key,int> difference;
+    for(unsigned i=0;i<m_edges.size();i++) {
+        difference[Key(pairKey(m_edges[i].first,m_edges[i].second),
+                m_lengths[i])]--;
+    }
+    for(unsigned i=0;i<es.size();i++) {
+        difference[Key(pairKey(es[i].first,es[i].second),lengths[i])]++;
+    }
+    unsigned changes=n-dense->size();
+    for(std::map<Key,int>::const_iterator d=difference.begin();
+            d!=difference.end();++d) {
+        changes+=abs(d->second);
+    }
+    if(changes>MAX_INCREMENTAL_CHANGES) {
+        return false;
+    }
+    dense->clearPairTypeOverrides();
+    for(std::map<Key,int>::const_iterator d=difference.begin();
+            d!=difference.end();++d) {
+        for(int k=0;k<-d->second;k++) {
+            // Remove one matching edge from the kept graph.
+            unsigned i=0;
+            while(pairKey(m_edges[i].first,m_edges[i].second)!=d->first.first
+                    || m_lengths[i]!=d->first.second) {
+                ++i;
+            }
+            m_edges.erase(m_edges.begin()+i);
+            m_lengths.erase(m_lengths.begin()+i);
+            const valarray<double> remaining(m_lengths.empty()?NULL:
+                    &m_lengths[0],m_lengths.size());
+            dense->removeEdge(d->first.first.first,d->first.first.second,
+                    d->first.second,m_edges,&remaining);
+        }
+    }
+    while(dense->size()<n) {
+        dense->addNode();
+    }
+    for(std::map<Key,int>::const_iterator d=difference.begin();
+            d!=difference.end();++d) {
+        for(int k=0;k<d->second;k++) {
+            dense->addEdge(d->first.first.first,d->first.first.second,
+                    d->first.second);
+        }
+    }
+    m_edges=es;
+    m_lengths=lengths;
+    return true;
+}
+
+namespace {
+    // Compressed adjacency lists with edge weights.
+    struct Adjacency {
+        Adjacency(const unsigned n, const vector<Edge>& es,
+                const valarray<double> *eLengths, const double scale)
+            : start(n+1,0), node(2*es.size()), weight(2*es.size())
+        {
+            COLA_ASSERT(!eLengths || eLengths->size()==es.size());
+            for(unsigned i=0;i<es.size();i++) {
+                COLA_ASSERT(es[i].first<n && es[i].second<n);
+                start[es[i].first+1]++;
+                start[es[i].second+1]++;
+            }
+            for(unsigned i=0;i<n;i++) {
+                start[i+1]+=start[i];
+            }
+            vector<unsigned> next(start.begin(),start.end()-1);
+            for(unsigned i=0;i<es.size();i++) {
+                const unsigned u=es[i].first, v=es[i].second;
+                const double w=eLengths?(*eLengths)[i]:scale;
+                node[next[u]]=v;
+                weight[next[u]++]=w;
+                node[next[v]]=u;
+                weight[next[v]++]=w;
+            }
+        }
+        unsigned degree(const unsigned u) const {
+            return start[u+1]-start[u];
+        }
+        vector<unsigned> start;
+        vector<unsigned> node;
+        vector<double> weight;
+    };
+
+    typedef std::pair<double,unsigned> QueueEntry;
+    typedef std::priority_queue<QueueEntry, vector<QueueEntry>,
+            std::greater<QueueEntry> > Queue;
+
+    // Full single source shortest paths, with lazy deletion from the
+    // queue rather than decrease-key.
+    void dijkstra(const Adjacency& adj, const unsigned s, double *d)
+    {
+        const unsigned n=adj.start.size()-1;
+        std::fill(d,d+n,DBL_MAX);
+        d[s]=0;
+        Queue q;
+        q.push(QueueEntry(0,s));
+        while(!q.empty()) {
+            const QueueEntry top=q.top();
+            q.pop();
+            const unsigned u=top.second;
+            if(top.first>d[u]) continue;
+            for(unsigned i=adj.start[u];i<adj.start[u+1];i++) {
+                const unsigned v=adj.node[i];
+                const double dv=d[u]+adj.weight[i];
+                if(dv<d[v]) {
+                    d[v]=dv;
+                    q.push(QueueEntry(dv,v));
+                }
+            }
+        }
+    }
+}
+
+LandmarkPathLengths::LandmarkPathLengths(const unsigned n,
+        const vector<Edge>& es, const valarray<double> *eLengths,
+        const double scale, const unsigned hops, const unsigned localSize,
+        const unsigned landmarks, const unsigned cacheFactor)
+    : PathLengths(n),
+      m_component(n),
+      m_localStart(n+1,0),
+      m_radius(n,0)
+{
+    COLA_ASSERT(hops>0);
+    const Adjacency adj(n,es,eLengths,scale);
+
+    // Label connected components.
+    const unsigned unlabelled=n;
+    std::fill(m_component.begin(),m_component.end(),unlabelled);
+    vector<unsigned> stack;
+    for(unsigned s=0;s<n;s++) {
+        if(m_component[s]!=unlabelled) continue;
+        m_component[s]=s;
+        stack.push_back(s);
+        while(!stack.empty()) {
+            const unsigned u=stack.back();
+            stack.pop_back();
+            for(unsigned i=adj.start[u];i<adj.start[u+1];i++) {
+                const unsigned v=adj.node[i];
+                if(m_component[v]==unlabelled) {
+                    m_component[v]=s;
+                    stack.push_back(v);
+                }
+            }
+        }
+    }
+
+    // Bounded Dijkstra from each node: settle the closest localSize nodes
+    // reachable within the hop limit, then add any neighbours not yet
+    // settled at their edge length.  Scratch arrays are reset only where
+    // they were touched so each search costs time proportional to its size.
+    // Every pair found is recorded from both ends, so that the rows are
+    // symmetric and a pair has the same distance whichever end it is 
+    // looked up from.
+    vector<double> dist(n,DBL_MAX);
+    vector<unsigned> hopCount(n,0);
+    vector<bool> settled(n,false);
+    vector<unsigned> touched;
+    vector<std::pair<Edge,double> > found;
+    for(unsigned s=0;s<n;s++) {
+        touched.clear();
+        Queue q;
+        dist[s]=0;
+        touched.push_back(s);
+        q.push(QueueEntry(0,s));
+        unsigned settledCount=0;
+        while(!q.empty() && settledCount<=localSize) {
+            const QueueEntry top=q.top();
+            q.pop();
+            const unsigned u=top.second;
+            if(settled[u] || top.first>dist[u]) continue;
+            settled[u]=true;
+            if(u!=s) {
+                found.push_back(std::make_pair(Edge(s,u),dist[u]));
+                found.push_back(std::make_pair(Edge(u,s),dist[u]));
+            }
+            ++settledCount;
+            if(hopCount[u]>=hops) continue;
+            for(unsigned i=adj.start[u];i<adj.start[u+1];i++) {
+                const unsigned v=adj.node[i];
+                const double dv=dist[u]+adj.weight[i];
+                if(dist[v]==DBL_MAX) {
+                    touched.push_back(v);
+                }
+                if(dv<dist[v]) {
+                    dist[v]=dv;
+                    hopCount[v]=hopCount[u]+1;
+                    q.push(QueueEntry(dv,v));
+                }
+            }
+        }
+        for(unsigned i=adj.start[s];i<adj.start[s+1];i++) {
+            const unsigned v=adj.node[i];
+            if(v!=s && !settled[v]) {
+                settled[v]=true;
+                found.push_back(std::make_pair(Edge(s,v),dist[v]));
+                found.push_back(std::make_pair(Edge(v,s),dist[v]));
+            }
+        }
+        for(vector<unsigned>::iterator i=touched.begin();
+                i!=touched.end();++i) {
+            dist[*i]=DBL_MAX;
+            hopCount[*i]=0;
+            settled[*i]=false;
+        }
+    }
+    // Sorting brings the entries for each pair together, shortest first,
+    // and orders them by row.  Only the shortest distance is kept.
+    std::sort(found.begin(),found.end());
+    for(unsigned i=0;i<found.size();i++) {
+        if(i>0 && found[i].first==found[i-1].first) continue;
+        const unsigned u=found[i].first.first;
+        m_localNode.push_back(found[i].first.second);
+        m_localDist.push_back(found[i].second);
+        m_localStart[u+1]++;
+        m_radius[u]=std::max(m_radius[u],found[i].second);
+    }
+    for(unsigned i=0;i<n;i++) {
+        m_localStart[i+1]+=m_localStart[i];
+    }
+    m_localType.assign(m_localNode.size(),2);
+    for(vector<Edge>::const_iterator e=es.begin();e!=es.end();++e) {
+        if(e->first==e->second) continue;
+        m_localType[findLocal(e->first,e->second)]=1;
+        m_localType[findLocal(e->second,e->first)]=1;
+    }
+
+    // Choose landmarks by max-min selection, starting from the node of
+    // highest degree.  Unreachable nodes are infinitely far from the
+    // chosen landmarks, so each component with edges gets a landmark
+    // before any component gets a second one.  Isolated nodes need none.
+    vector<double> nearest(n,DBL_MAX);
+    vector<vector<double> > landmarkRows;
+    unsigned next=n;
+    for(unsigned v=0;v<n;v++) {
+        if(adj.degree(v)>0 && (next==n || adj.degree(v)>adj.degree(next))) {
+            next=v;
+        }
+    }
+    while(next!=n && m_landmarks.size()<landmarks) {
+        m_landmarks.push_back(next);
+        landmarkRows.push_back(vector<double>(n));
+        vector<double>& d=landmarkRows.back();
+        dijkstra(adj,next,&d[0]);
+        next=n;
+        double farthest=0;
+        for(unsigned v=0;v<n;v++) {
+            nearest[v]=std::min(nearest[v],d[v]);
+            if(adj.degree(v)>0 && nearest[v]>farthest) {
+                farthest=nearest[v];
+                next=v;
+            }
+        }
+    }
+    // Store landmark-major so that rows of estimates can be computed a
+    // landmark at a time over contiguous nodes.
+    const unsigned k=m_landmarks.size();
+    m_landmarkDist.resize(k*n);
+    for(unsigned l=0;l<k;l++) {
+        std::copy(landmarkRows[l].begin(),landmarkRows[l].end(),
+                m_landmarkDist.begin()+l*n);
+    }
+
+    // Estimates are recomputed every time they are asked for unless 
+    // keeping them all takes at most cacheFactor times the memory of the
+    // landmark distances, so that the store stays O(nk).
+    if((double)n*sizeof(float)<=(double)cacheFactor*k*sizeof(double)) {
+        m_estimates.resize((size_t)n*n);
+        vector<double> row(n);
+        for(unsigned u=0;u<n;u++) {
+            estimateRow(u,&row[0]);
+            std::copy(row.begin(),row.end(),m_estimates.begin()+(size_t)u*n);
+        }
+    }
+}
+
+int LandmarkPathLengths::findLocal(const unsigned u, const unsigned v) const
+{
+    vector<unsigned>::const_iterator first=m_localNode.begin()+m_localStart[u];
+    vector<unsigned>::const_iterator last=m_localNode.begin()+m_localStart[u+1];
+    vector<unsigned>::const_iterator i=std::lower_bound(first,last,v);
+    if(i!=last && *i==v) {
+        return i-m_localNode.begin();
+    }
+    return -1;
+}
+
+/**
+ * Estimates the distance between two nodes in the same component from
+ * their distances to the landmarks.  By the triangle inequality the true
+ * distance lies between max|d(l,u)-d(l,v)| and min(d(l,u)+d(l,v)), and the
+ * midpoint of these bounds is used.  If no landmark reaches them, the pair
+ * is at least as far apart as the larger radius of their local 
+ * neighbourhoods, and the sum of the radii is used.  The estimate is the
+ * same both ways round.
+ */
+double LandmarkPathLengths::estimate(const unsigned u, const unsigned v) const
+{
+    const unsigned k=m_landmarks.size();
+    double upper=DBL_MAX, lower=0;
+    for(unsigned l=0;l<k;l++) {
+        const double du=m_landmarkDist[l*n+u];
+        if(du==DBL_MAX) continue;
+        const double dv=m_landmarkDist[l*n+v];
+        upper=std::min(upper,du+dv);
+        lower=std::max(lower,fabs(du-dv));
+    }
+    if(upper==DBL_MAX) {
+        return m_radius[u]+m_radius[v];
+    }
+    return (lower+upper)/2;
+}
+
+/**
+ * Fills row with estimate(u,v) for the nodes v in the same component as 
+ * u, and DBL_MAX for the others.  The bounds are accumulated a landmark at
+ * a time over blocks of nodes, giving the same values as estimate() 
+ * without its per-pair overheads.
+ */
+void LandmarkPathLengths::estimateRow(const unsigned u, double *row) const
+{
+    static const unsigned BLOCK=256;
+    const unsigned k=m_landmarks.size();
+    double lower[BLOCK], upper[BLOCK];
+    for(unsigned b=0;b<n;b+=BLOCK) {
+        const unsigned m=std::min(BLOCK,n-b);
+        std::fill(lower,lower+m,0.0);
+        std::fill(upper,upper+m,DBL_MAX);
+        for(unsigned l=0;l<k;l++) {
+            // A landmark reaches either all or none of a component.
+            const double du=m_landmarkDist[l*n+u];
+            if(du==DBL_MAX) continue;
+            const double *dv=&m_landmarkDist[l*n+b];
+            for(unsigned i=0;i<m;i++) {
+                upper[i]=std::min(upper[i],du+dv[i]);
+                lower[i]=std::max(lower[i],fabs(du-dv[i]));
+            }
+        }
+        for(unsigned i=0;i<m;i++) {
+            const unsigned v=b+i;
+            if(m_component[v]!=m_component[u]) {
+                row[v]=DBL_MAX;
+            } else if(upper[i]==DBL_MAX) {
+                row[v]=m_radius[u]+m_radius[v];
+            } else {
+                row[v]=(lower[i]+upper[i])/2;
+            }
+        }
+    }
+}
+
+double LandmarkPathLengths::distance(const unsigned u, const unsigned v) const
+{
+    COLA_ASSERT(u<n && v<n);
+    if(u==v) {
+        return 0;
+    }
+    if(m_component[u]!=m_component[v]) {
+        return DBL_MAX;
+    }
+    const int i=findLocal(u,v);
+    if(i>=0) {
+        return m_localDist[i];
+    }
+    if(!m_estimates.empty()) {
+        return m_estimates[(size_t)u*n+v];
+    }
+    return estimate(u,v);
+}
+
+unsigned short LandmarkPathLengths::pairType(const unsigned u,
+        const unsigned v) const
+{
+    COLA_ASSERT(u<n && v<n);
+    if(u==v || m_component[u]!=m_component[v]) {
+        return 0;
+    }
+    const int i=findLocal(u,v);
+    if(i>=0) {
+        return m_localType[i];
+    }
+    if(!m_overriddenTypes.empty()) {
+        std::map<Edge,unsigned short>::const_iterator o=
+                m_overriddenTypes.find(std::make_pair(u,v));
+        if(o!=m_overriddenTypes.end()) {
+            return o->second;
+        }
+    }
+    return 2;
+}
+
+void LandmarkPathLengths::setPairType(const unsigned u, const unsigned v,
+        const unsigned short p)
+{
+    COLA_ASSERT(u<n && v<n);
+    const int i=findLocal(u,v), j=findLocal(v,u);
+    if(i>=0) {
+        m_localType[i]=p;
+    } else {
+        m_overriddenTypes[std::make_pair(u,v)]=p;
+    }
+    if(j>=0) {
+        m_localType[j]=p;
+    } else {
+        m_overriddenTypes[std::make_pair(v,u)]=p;
+    }
+}
+
+const double *LandmarkPathLengths::distances(const unsigned u,
+        double *buffer) const
+{
+    COLA_ASSERT(u<n);
+    if(!m_estimates.empty()) {
+        const float *row=&m_estimates[(size_t)u*n];
+        const unsigned c=m_component[u];
+        for(unsigned v=0;v<n;v++) {
+            buffer[v]=(m_component[v]==c)?row[v]:DBL_MAX;
+        }
+    } else {
+        estimateRow(u,buffer);
+    }
+    for(unsigned i=m_localStart[u];i<m_localStart[u+1];i++) {
+        buffer[m_localNode[i]]=m_localDist[i];
+    }
+    buffer[u]=0;
+    return buffer;
+}
+
+const unsigned short *LandmarkPathLengths::pairTypes(const unsigned u,
+        unsigned short *buffer) const
+{
+    COLA_ASSERT(u<n);
+    for(unsigned v=0;v<n;v++) {
+        buffer[v]=(m_component[v]==m_component[u])?2:0;
+    }
+    for(std::map<Edge,unsigned short>::const_iterator o=
+            m_overriddenTypes.lower_bound(std::make_pair(u,0u));
+            o!=m_overriddenTypes.end() && o->first.first==u;++o) {
+        buffer[o->first.second]=o->second;
+    }
+    for(unsigned i=m_localStart[u];i<m_localStart[u+1];i++) {
+        buffer[m_localNode[i]]=m_localType[i];
+    }
+    buffer[u]=0;
+    return buffer;
+}
+
+} // namespace cola
+
+// vim: filetype=cpp:cindent:expandtab:shiftwidth=4:tabstop=4:softtabstop=4 :
@@ -0,0 +1,290 @@
+/*
+ * vim: ts=4 sw=4 et tw=0 wm=0
+ *
+ * libcola - A library providing force-directed network layout using the
+ *           stress-majorization method subject to separation constraints.
+ *
+ * Copyright (C) 2026  Dunnart contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library in the file LICENSE; if not,
+ * write to the Free Software Foundation, Inc., 59 Temple Place,
+ * Suite 330, Boston, MA  02111-1307  USA
+ *
+*/
+
+/**
+ * Storage for the ideal pairwise distances used by ConstrainedFDLayout.
+ *
+ * For every pair of nodes (u,v) the layout needs the ideal distance
+ * D(u,v), derived from the shortest path between them, and the pair type
+ * G(u,v):
+ *   0 if there are no forces required between u and v
+ *     (for example, if u and v are in unconnected components)
+ *   1 if attractive forces are required between u and v
+ *     (i.e. if u and v are immediately connected by an edge)
+ *   2 if no attractive force is required between u and v but there is
+ *     a connected path between them.
+ *
+ * DensePathLengths stores both as full n*n matrices.  This is exact but
+ * needs O(n^2) memory, so for large graphs LandmarkPathLengths keeps
+ * exact distances only between nodes that are a few hops apart and
+ * estimates the remainder from the distances to a small set of landmarks.
+ */
+#ifndef COLA_PATH_LENGTHS_H
+#define COLA_PATH_LENGTHS_H
+
+#include <vector>
+#include <valarray>
+#include <map>
+#include <utility>
+
+namespace cola {
+
+typedef std::pair<unsigned, unsigned> Edge;
+
+//! Graphs with more nodes than this use LandmarkPathLengths by default.
+static const unsigned DENSE_PATH_LENGTHS_MAX_NODES = 5000;
+
+class PathLengths {
+public:
+    virtual ~PathLengths() {}
+
+    //! Ideal distance between u and v, DBL_MAX if they are disconnected.
+    virtual double distance(const unsigned u, const unsigned v) const = 0;
+    //! Pair type G(u,v), as described above.
+    virtual unsigned short pairType(const unsigned u,
+            const unsigned v) const = 0;
+    //! Sets G(u,v) and G(v,u) to p.
+    virtual void setPairType(const unsigned u, const unsigned v,
+            const unsigned short p) = 0;
+
+    /**
+     * Returns the ideal distances from u to every node.  Implementations
+     * that store full rows return them directly, others fill and return
+     * buffer, which must have room for n values.
+     */
+    virtual const double *distances(const unsigned u,
+            double *buffer) const = 0;
+    //! As distances(), for the pair types G(u,*).
+    virtual const unsigned short *pairTypes(const unsigned u,
+            unsigned short *buffer) const = 0;
+
+    unsigned size() const
+    {
+        return n;
+    }
+
+protected:
+    PathLengths(const unsigned n) : n(n) {}
+    unsigned n;
+};
+
+/**
+ * Exact all-pairs shortest paths stored as n*n matrices.
+ */
+class DensePathLengths : public PathLengths {
+public:
+    /**
+     * @param n         number of nodes
+     * @param es        edges
+     * @param eLengths  individual edge lengths, or NULL
+     * @param scale     if eLengths is NULL, the length of every edge
+     */
+    DensePathLengths(const unsigned n, const std::vector<Edge>& es,
+            const std::valarray<double> *eLengths, const double scale);
+    ~DensePathLengths();
+
+    double distance(const unsigned u, const unsigned v) const
+    {
+        return D[u][v];
+    }
+    unsigned short pairType(const unsigned u, const unsigned v) const
+    {
+        return G[u][v];
+    }
+    void setPairType(const unsigned u, const unsigned v,
+            const unsigned short p);
+    const double *distances(const unsigned u, double *) const
+    {
+        return D[u];
+    }
+    const unsigned short *pairTypes(const unsigned u,
+            unsigned short *) const
+    {
+        return G[u];
+    }
+
+    /**
+     * Adds a new unconnected node, numbered size(), in O(n^2) time.  Its
+     * edges can then be added with addEdge().
+     */
+    void addNode();
+    /**
+     * Updates the path lengths for a new edge between u and v in O(n^2) 
+     * time, rather than recomputing them all.  Pair types set with 
+     * setPairType() are kept.
+     * @param length  the ideal length of the edge, i.e., its entry in 
+     *                eLengths or else scale
+     */
+    void addEdge(const unsigned u, const unsigned v, const double length);
+    /**
+     * Updates the path lengths after the edge between u and v is removed,
+     * recomputing only the sources for which it was on a shortest path.
+     * Pair types set with setPairType() are kept, except for pairs that
+     * are no longer connected.
+     * @param length    the ideal length of the removed edge
+     * @param es        the remaining edges
+     * @param eLengths  lengths of the remaining edges, or NULL
+     */
+    void removeEdge(const unsigned u, const unsigned v, const double length,
+            const std::vector<Edge>& es,
+            const std::valarray<double> *eLengths);
+    //! Restores the pair types set with setPairType() to those given by
+    //! the graph.
+    void clearPairTypeOverrides();
+
+private:
+    DensePathLengths(const DensePathLengths&);
+    DensePathLengths& operator=(const DensePathLengths&);
+
+    unsigned short graphPairType(const unsigned u, const unsigned v) const;
+    void applyPairTypeOverrides();
+
+    double **D;
+    unsigned short **G;
+    const double scale;
+    // Number of edges between each pair of nodes, keyed by the pair with
+    // its lower numbered node first.
+    std::map<Edge, unsigned> m_edgeCount;
+    // Pair types set with setPairType(), keyed as m_edgeCount.
+    std::map<Edge, unsigned short> m_overriddenTypes;
+};
+
+/**
+ * Memory-bounded path lengths for large graphs.
+ *
+ * Shortest path distances are stored exactly, in compressed rows, from
+ * each node to the nearest nodes within a given number of hops (and always
+ * to its immediate neighbours).  Other distances are estimated from the
+ * distances to a set of landmark nodes, chosen by max-min (farthest point)
+ * selection.  Memory use is O(n(localSize+landmarks))
+ * and setup takes a bounded Dijkstra per node plus one full Dijkstra per
+ * landmark.  The estimates are also computed once at setup and kept,
+ * rather than recomputed on every call, but only while they take no more
+ * than cacheFactor times the memory of the landmark distances.  This caps
+ * them at O(nk) memory, so they are kept only for graphs of up to
+ * 2*cacheFactor*landmarks nodes (2048 by default).
+ *
+ * Both the stored and the estimated distances are symmetric, as the 
+ * stress and its Hessian require.
+ */
+class LandmarkPathLengths : public PathLengths {
+public:
+    /**
+     * @param n          number of nodes
+     * @param es         edges
+     * @param eLengths   individual edge lengths, or NULL
+     * @param scale      if eLengths is NULL, the length of every edge
+     * @param hops       exact distances are stored to nodes up to this
+     *                   many hops away
+     * @param localSize  at most this many of those nodes (the closest) are
+     *                   stored for each node, besides its neighbours
+     * @param landmarks  number of landmark nodes
+     * @param cacheFactor  estimates are kept only if they fit in this many
+     *                   times the memory used by the landmark distances
+     */
+    LandmarkPathLengths(const unsigned n, const std::vector<Edge>& es,
+            const std::valarray<double> *eLengths, const double scale,
+            const unsigned hops = 2, const unsigned localSize = 64,
+            const unsigned landmarks = 16, const unsigned cacheFactor = 64);
+
+    double distance(const unsigned u, const unsigned v) const;
+    unsigned short pairType(const unsigned u, const unsigned v) const;
+    void setPairType(const unsigned u, const unsigned v,
+            const unsigned short p);
+    const double *distances(const unsigned u, double *buffer) const;
+    const unsigned short *pairTypes(const unsigned u,
+            unsigned short *buffer) const;
+
+    unsigned landmarkCount() const
+    {
+        return m_landmarks.size();
+    }
+
+private:
+    int findLocal(const unsigned u, const unsigned v) const;
+    double estimate(const unsigned u, const unsigned v) const;
+    void estimateRow(const unsigned u, double *row) const;
+
+    // Connected component of each node.
+    std::vector<unsigned> m_component;
+    // Exact distances to nearby nodes, in compressed rows sorted by node.
+    std::vector<unsigned> m_localStart;
+    std::vector<unsigned> m_localNode;
+    std::vector<double> m_localDist;
+    std::vector<unsigned short> m_localType;
+    // Largest stored local distance for each node.
+    std::vector<double> m_radius;
+    // m_landmarkDist[l*n+v] is the distance from landmark l to v.
+    std::vector<unsigned> m_landmarks;
+    std::vector<double> m_landmarkDist;
+    // If kept, m_estimates[u*n+v] is estimate(u,v).
+    std::vector<float> m_estimates;
+    // Pair types set for pairs that have no local entry.
+    std::map<Edge, unsigned short> m_overriddenTypes;
+};
+
+/**
+ * Keeps the path lengths of a graph from one ConstrainedFDLayout to the 
+ * next, for an application that lays out the same graph again after each
+ * edit.  If the graph has only gained nodes, or gained or lost a few
+ * edges, since it was last seen, its DensePathLengths are updated with
+ * addNode(), addEdge() and removeEdge() rather than recomputed.  Other 
+ * changes, and graphs large enough for LandmarkPathLengths, are
+ * recomputed in full.
+ */
+class PathLengthsCache {
+public:
+    //! At most this many added or removed edges and nodes are applied 
+    //! incrementally, since each costs O(n^2) or more.
+    static const unsigned MAX_INCREMENTAL_CHANGES = 16;
+
+    PathLengthsCache();
+    ~PathLengthsCache();
+
+    /**
+     * Returns the path lengths for the graph, which remain owned by the 
+     * cache and are valid until the next call.  Pair types set by the 
+     * previous user are cleared.  The arguments are as for 
+     * DensePathLengths.
+     */
+    PathLengths *pathLengths(const unsigned n, const std::vector<Edge>& es,
+            const std::valarray<double> *eLengths, const double scale);
+
+private:
+    PathLengthsCache(const PathLengthsCache&);
+    PathLengthsCache& operator=(const PathLengthsCache&);
+
+    bool update(const unsigned n, const std::vector<Edge>& es,
+            const std::vector<double>& lengths);
+
+    PathLengths *m_pathLengths;
+    // The graph m_pathLengths is for, if it is a DensePathLengths.
+    std::vector<Edge> m_edges;
+    std::vector<double> m_lengths;
+};
+
+} // namespace cola
+
+#endif // COLA_PATH_LENGTHS_H
@@ -0,0 +1,158 @@
+/*
+ * vim: ts=4 sw=4 et tw=0 wm=0
+ *
+ * libcola - A library providing force-directed network layout using the
+ *           stress-majorization method subject to separation constraints.
+ *
+ * Copyright (C) 2026  Dunnart contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library in the file LICENSE; if not,
+ * write to the Free Software Foundation, Inc., 59 Temple Place,
+ * Suite 330, Boston, MA  02111-1307  USA
+ *
+*/
+
+#include <cfloat>
+#include <algorithm>
+
+#include "libvpsc/assertions.h"
+#include "libcola/quadtree.h"
+
+namespace cola {
+
+// Stops runaway subdivision when many nodes share the same position.
+static const unsigned MAX_DEPTH = 32;
+
+namespace {
+    // Predicate used to partition the node ordering about a split line.
+    struct LessThan {
+        LessThan(const std::valarray<double>& coords, const double split)
+            : coords(coords), split(split) {}
+        bool operator()(const unsigned v) const {
+            return coords[v] < split;
+        }
+        const std::valarray<double>& coords;
+        const double split;
+    };
+}
+
+QuadTree::QuadTree(const std::valarray<double>& X,
+        const std::valarray<double>& Y, const unsigned leafSize)
+    : X(X),
+      Y(Y),
+      m_leafSize(std::max(leafSize, 1u)),
+      m_order(X.size()),
+      m_position(X.size())
+{
+    COLA_ASSERT(X.size() == Y.size());
+    const unsigned n = X.size();
+    for (unsigned i = 0; i < n; ++i)
+    {
+        m_order[i] = i;
+    }
+    // A balanced tree has at most about 4n/leafSize cells.
+    m_cells.reserve(4 * (n / m_leafSize + 1));
+    if (n > 0)
+    {
+        build(0, n, 0);
+    }
+    for (unsigned i = 0; i < n; ++i)
+    {
+        m_position[m_order[i]] = i;
+    }
+}
+
+unsigned QuadTree::build(const unsigned begin, const unsigned end,
+        const unsigned depth)
+{
+    COLA_ASSERT(begin < end);
+    const unsigned index = m_cells.size();
+    m_cells.push_back(Cell());
+
+    Cell c;
+    c.begin = begin;
+    c.end = end;
+    c.minX = c.minY = DBL_MAX;
+    c.maxX = c.maxY = -DBL_MAX;
+    c.cx = c.cy = 0;
+    for (unsigned i = begin; i < end; ++i)
+    {
+        const unsigned v = m_order[i];
+        c.minX = std::min(c.minX, X[v]);
+        c.maxX = std::max(c.maxX, X[v]);
+        c.minY = std::min(c.minY, Y[v]);
+        c.maxY = std::max(c.maxY, Y[v]);
+        c.cx += X[v];
+        c.cy += Y[v];
+    }
+    c.cx /= (end - begin);
+    c.cy /= (end - begin);
+
+    double bestDist = DBL_MAX;
+    c.representative = m_order[begin];
+    for (unsigned i = begin; i < end; ++i)
+    {
+        const unsigned v = m_order[i];
+        const double dx = X[v] - c.cx, dy = Y[v] - c.cy;
+        const double dist = dx * dx + dy * dy;
+        if (dist < bestDist)
+        {
+            bestDist = dist;
+            c.representative = v;
+        }
+    }
+    for (unsigned q = 0; q < 4; ++q)
+    {
+        c.children[q] = NO_CHILD;
+    }
+    m_cells[index] = c;
+
+    if ((end - begin) <= m_leafSize || depth >= MAX_DEPTH || c.size() <= 0)
+    {
+        return index;
+    }
+
+    // Split into quadrants about the centre of the bounds:
+    //   [begin,midY) below, [midY,end) above, each then split in x.
+    const double splitX = (c.minX + c.maxX) / 2;
+    const double splitY = (c.minY + c.maxY) / 2;
+    std::vector<unsigned>::iterator first = m_order.begin() + begin;
+    std::vector<unsigned>::iterator last = m_order.begin() + end;
+    std::vector<unsigned>::iterator midY =
+            std::partition(first, last, LessThan(Y, splitY));
+    std::vector<unsigned>::iterator midLow =
+            std::partition(first, midY, LessThan(X, splitX));
+    std::vector<unsigned>::iterator midHigh =
+            std::partition(midY, last, LessThan(X, splitX));
+
+    const unsigned bounds[5] = { begin,
+            (unsigned) (midLow - m_order.begin()),
+            (unsigned) (midY - m_order.begin()),
+            (unsigned) (midHigh - m_order.begin()),
+            end };
+    for (unsigned q = 0; q < 4; ++q)
+    {
+        if (bounds[q] < bounds[q + 1])
+        {
+            // Note: recursion may reallocate m_cells, so index afresh.
+            int child = build(bounds[q], bounds[q + 1], depth + 1);
+            m_cells[index].children[q] = child;
+        }
+    }
+    return index;
+}
+
+} // namespace cola
+
+// vim: filetype=cpp:cindent:expandtab:shiftwidth=4:tabstop=4:softtabstop=4 :
@@ -0,0 +1,116 @@
+/*
+ * vim: ts=4 sw=4 et tw=0 wm=0
+ *
+ * libcola - A library providing force-directed network layout using the
+ *           stress-majorization method subject to separation constraints.
+ *
+ * Copyright (C) 2026  Dunnart contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library in the file LICENSE; if not,
+ * write to the Free Software Foundation, Inc., 59 Temple Place,
+ * Suite 330, Boston, MA  02111-1307  USA
+ *
+*/
+
+/**
+ * A point region quadtree over node positions, used by ConstrainedFDLayout
+ * to approximate the stress contribution of distant groups of nodes in the
+ * style of Barnes-Hut.
+ *
+ * Nodes are stored in an index array ordered so that every cell owns a
+ * contiguous range [begin,end) of it.  This means membership of a node in
+ * a cell can be tested in constant time via position().
+ */
+#ifndef COLA_QUADTREE_H
+#define COLA_QUADTREE_H
+
+#include <vector>
+#include <valarray>
+#include <algorithm>
+
+namespace cola {
+
+class QuadTree {
+public:
+    static const int NO_CHILD = -1;
+
+    struct Cell {
+        // Bounds of the nodes contained in this cell.
+        double minX, maxX, minY, maxY;
+        // Centre of mass of the contained nodes.
+        double cx, cy;
+        // Range of indices into order() for the contained nodes.
+        unsigned begin, end;
+        // The contained node closest to the centre of mass.
+        unsigned representative;
+        int children[4];
+
+        unsigned count() const {
+            return end - begin;
+        }
+        bool isLeaf() const {
+            return children[0] == NO_CHILD && children[1] == NO_CHILD &&
+                   children[2] == NO_CHILD && children[3] == NO_CHILD;
+        }
+        double size() const {
+            return std::max(maxX - minX, maxY - minY);
+        }
+        bool contains(const double x, const double y) const {
+            return x >= minX && x <= maxX && y >= minY && y <= maxY;
+        }
+    };
+
+    /**
+     * @param X x-coordinates of the nodes
+     * @param Y y-coordinates of the nodes
+     * @param leafSize cells with at most this many nodes are not split
+     */
+    QuadTree(const std::valarray<double>& X, const std::valarray<double>& Y,
+            const unsigned leafSize = 8);
+
+    const Cell& cell(const unsigned i) const {
+        return m_cells[i];
+    }
+    unsigned cellCount() const {
+        return m_cells.size();
+    }
+    //! The node stored at position i of the ordering.
+    unsigned node(const unsigned i) const {
+        return m_order[i];
+    }
+    //! The position of node v in the ordering.
+    unsigned position(const unsigned v) const {
+        return m_position[v];
+    }
+    //! Whether node v lies within cell c.
+    bool inCell(const unsigned v, const Cell& c) const {
+        const unsigned p = m_position[v];
+        return p >= c.begin && p < c.end;
+    }
+
+private:
+    unsigned build(const unsigned begin, const unsigned end,
+            const unsigned depth);
+
+    const std::valarray<double>& X;
+    const std::valarray<double>& Y;
+    const unsigned m_leafSize;
+    std::vector<Cell> m_cells;
+    std::vector<unsigned> m_order;
+    std::vector<unsigned> m_position;
+};
+
+} // namespace cola
+
+#endif // COLA_QUADTREE_H
@@ -151,6 +151,32 @@ void dijkstra(
     dijkstra(s,vs,d);
 }
 
+// Runs dijkstra from each of the given sources.  The searches are
+// independent, so with OpenMP each thread takes sources from a shared
+// queue, using its own copy of the node array as scratch space.
+template <typename T>
+void dijkstra_sources(
+        unsigned const n,
+        T** D, 
+        vector<Edge> const & es,
+        valarray<T> const * eweights,
+        vector<unsigned> const & sources) 
+{
+    const int count=sources.size();
+#ifdef _OPENMP
+    #pragma omp parallel
+#endif
+    {
+        vector<Node<T> > vs(n);
+        dijkstra_init(vs,es,eweights);
+#ifdef _OPENMP
+        #pragma omp for schedule(dynamic,16)
+#endif
+        for(int k=0;k<count;k++) {
+            dijkstra(sources[k],vs,D[sources[k]]);
+        }
+    }
+}
 template <typename T>
 void johnsons(
         unsigned const n,
@@ -158,10 +184,90 @@ void johnsons(
         vector<Edge> const & es,
         valarray<T> const * eweights) 
 {
-    vector<Node<T> > vs(n);
-    dijkstra_init(vs,es,eweights);
+    vector<unsigned> sources(n);
     for(unsigned k=0;k<n;k++) {
-        dijkstra(k,vs,D[k]);
+        sources[k]=k;
+    }
+    dijkstra_sources(n,D,es,eweights,sources);
+}
+template <typename T>
+void add_edge(
+        unsigned const n,
+        T** D, 
+        unsigned const u,
+        unsigned const v,
+        T const w)
+{
+    COLA_ASSERT(u<n && v<n);
+    const T inf=numeric_limits<T>::max();
+    // Any new shortest path i~>j is i~>u-v~>j or i~>v-u~>j.  Rows u and v
+    // are copied since they change as we go.
+    const vector<T> du(D[u],D[u]+n), dv(D[v],D[v]+n);
+    const int rows=n;
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for(int i=0;i<rows;i++) {
+        T* Di=D[i];
+        const T diu=du[i], div=dv[i];
+        for(unsigned j=0;j<n;j++) {
+            if(diu!=inf && dv[j]!=inf && diu+w+dv[j]<Di[j]) {
+                Di[j]=diu+w+dv[j];
+            }
+            if(div!=inf && du[j]!=inf && div+w+du[j]<Di[j]) {
+                Di[j]=div+w+du[j];
+            }
+        }
+    }
+}
+template <typename T>
+void add_node(
+        unsigned const n,
+        T** D)
+{
+    for(unsigned i=0;i<n;i++) {
+        D[i][n-1]=D[n-1][i]=numeric_limits<T>::max();
+    }
+    D[n-1][n-1]=0;
+}
+// Whether the edge (u,v) of weight w is on a shortest path from s, allowing
+// for rounding in the path lengths.
+template <typename T>
+bool tight(T const dsu, T const dsv, T const w)
+{
+    const T inf=numeric_limits<T>::max();
+    if(dsu==inf || dsv==inf) {
+        return false;
+    }
+    const double near=(double)dsu+(double)w, far=(double)dsv;
+    return far>=near-1e-9*near;
+}
+template <typename T>
+void remove_edge(
+        unsigned const n,
+        T** D, 
+        vector<Edge> const & es,
+        valarray<T> const * eweights,
+        unsigned const u,
+        unsigned const v,
+        T const w)
+{
+    COLA_ASSERT(u<n && v<n);
+    // The distances from s can only have changed if the edge was tight,
+    // i.e. on some shortest path from s.
+    vector<unsigned> sources;
+    for(unsigned s=0;s<n;s++) {
+        if(tight(D[s][u],D[s][v],w) || tight(D[s][v],D[s][u],w)) {
+            sources.push_back(s);
+        }
+    }
+    dijkstra_sources(n,D,es,eweights,sources);
+    // Keep D symmetric.
+    for(unsigned k=0;k<sources.size();k++) {
+        const unsigned s=sources[k];
+        for(unsigned j=0;j<n;j++) {
+            D[j][s]=D[s][j];
+        }
     }
 }
 }
@@ -77,7 +77,8 @@ void floyd_warshall(unsigned const n, T** D,
         std::vector<Edge> const & es,std::valarray<T> const * eweights=NULL); 
 
 /**
- * find all pairs shortest paths, faster, uses dijkstra
+ * find all pairs shortest paths, faster, uses dijkstra.  When built with 
+ * OpenMP the single source searches are shared between threads.
  * @param n total number of nodes
  * @param D n*n matrix of shortest paths
  * @param es edge pairs
@@ -86,6 +87,42 @@ void floyd_warshall(unsigned const n, T** D,
 template <typename T>
 void johnsons(unsigned const n, T** D,
         std::vector<Edge> const & es, std::valarray<T> const * eweights=NULL);
+/**
+ * update all pairs shortest paths after an edge is added, in O(n^2) time
+ * rather than recomputing them all.
+ * @param n total number of nodes
+ * @param D n*n matrix of shortest paths, before the edge was added
+ * @param u first end of the new edge
+ * @param v second end of the new edge
+ * @param w weight of the new edge
+ */
+template <typename T>
+void add_edge(unsigned const n, T** D,
+        unsigned const u, unsigned const v, T const w);
+/**
+ * set up the last row and column of D for a newly added node, which is
+ * unconnected.  Its edges can then be added with add_edge.
+ * @param n total number of nodes, including the new one
+ * @param D n*n matrix of shortest paths
+ */
+template <typename T>
+void add_node(unsigned const n, T** D);
+/**
+ * update all pairs shortest paths after an edge is removed.  Only the
+ * sources for which the edge lay on a shortest path are recomputed, using
+ * dijkstra.  To remove a node, remove each of its edges in turn.
+ * @param n total number of nodes
+ * @param D n*n matrix of shortest paths, before the edge was removed
+ * @param es edge pairs, no longer including the removed edge
+ * @param eweights edge weights, if NULL then all weights will be taken as 1
+ * @param u first end of the removed edge
+ * @param v second end of the removed edge
+ * @param w weight of the removed edge
+ */
+template <typename T>
+void remove_edge(unsigned const n, T** D,
+        std::vector<Edge> const & es, std::valarray<T> const * eweights,
+        unsigned const u, unsigned const v, T const w);
 /**
  * find shortest path lengths from node s to all other nodes
  * @param s starting node
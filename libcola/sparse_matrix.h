@@ -41,6 +41,7 @@
 #define _SPARSE_MATRIX_H
 
 #include <valarray>
+#include <vector>
 #include <map>
 #include <cstdio>
 
@@ -88,12 +89,18 @@ struct SparseMap {
  * The length of row i is determined by IA(i+1) - IA(i). Therefore IA needs to
  * be of length N + 1. In array JA, the column index of the element A(j) is
  * stored. JA is of length NZ.
+ *
+ * Besides conversion from a SparseMap, the matrix can be assembled directly
+ * a row at a time (see beginAssembly()).  Storage is kept between 
+ * assemblies and entries are written over the previous ones in place, so 
+ * reassembling a matrix with a similar sparsity pattern, as happens on 
+ * every layout iteration, needs no allocation and no map lookups.
  */
 class SparseMatrix {
 public:
     SparseMatrix(SparseMap const & m)
-            : n(m.n), NZ(m.nonZeroCount()), sparseMap(m), 
-              A(std::valarray<double>(NZ)), IA(std::valarray<unsigned>(n+1)), JA(std::valarray<unsigned>(NZ)) {
+            : n(m.n), NZ(m.nonZeroCount()), A(NZ), IA(n+1), JA(NZ),
+              diag(n, NO_ENTRY), row(n) {
         unsigned cnt=0;
         int lastrow=-1;
         for(SparseMap::ConstIt i=m.lookup.begin(); i!=m.lookup.end(); i++) {
@@ -108,12 +115,92 @@ public:
                 lastrow=p.first;
             }
             JA[cnt]=p.second;
+            if(p.first==p.second) {
+                diag[p.first]=cnt;
+            }
             cnt++;
         }
         for(unsigned r=lastrow+1;r<=n;r++) {
             IA[r]=NZ;
         }
     }
+    explicit SparseMatrix(const unsigned n = 0)
+            : n(n), NZ(0), IA(n+1, 0), diag(n, NO_ENTRY), row(n) {
+    }
+    /**
+     * Starts assembling the matrix afresh, discarding its entries but 
+     * keeping the storage.  Rows must then be assembled in increasing 
+     * order with beginRow(), add() and endRow().
+     */
+    void beginAssembly() {
+        NZ=0;
+        row=0;
+        IA[0]=0;
+    }
+    void beginRow(const unsigned i) {
+        COLA_ASSERT(i<n);
+        COLA_ASSERT(i>=row);
+        // Rows skipped since the last one are empty.
+        for(;row<i;row++) {
+            IA[row+1]=NZ;
+            diag[row]=NO_ENTRY;
+        }
+        diag[row]=NO_ENTRY;
+    }
+    //! Adds the entry (i,j) to the current row i, returning a reference
+    //! to its value.  Each column may be added at most once per row.
+    double& add(const unsigned j) {
+        COLA_ASSERT(row<n);
+        COLA_ASSERT(j<n);
+        if(NZ<JA.size()) {
+            JA[NZ]=j;
+        } else {
+            JA.push_back(j);
+            A.push_back(0);
+        }
+        if(j==row) {
+            diag[row]=NZ;
+        }
+        return A[NZ++];
+    }
+    void endRow() {
+        IA[++row]=NZ;
+    }
+    //! Copies rows [begin,end) of m into the matrix being assembled.
+    void addRows(const SparseMatrix& m, const unsigned begin,
+            const unsigned end) {
+        COLA_ASSERT(m.n==n);
+        COLA_ASSERT(end<=n);
+        for(unsigned i=begin;i<end;i++) {
+            beginRow(i);
+            for(unsigned j=m.IA[i];j<m.IA[i+1];j++) {
+                add(m.JA[j])=m.A[j];
+            }
+            endRow();
+        }
+    }
+    //! Completes the assembly; any remaining rows are empty.
+    void endAssembly() {
+        for(;row<n;row++) {
+            IA[row+1]=NZ;
+            diag[row]=NO_ENTRY;
+        }
+    }
+    //! The diagonal entry of row i, which must have been added.
+    double& diagonal(const unsigned i) {
+        COLA_ASSERT(i<n);
+        COLA_ASSERT(diag[i]!=NO_ENTRY);
+        return A[diag[i]];
+    }
+    //! Adds all entries of this matrix into m.
+    void addTo(SparseMap& m) const {
+        COLA_ASSERT(m.n==n);
+        for(unsigned i=0;i<n;i++) {
+            for(unsigned j=IA[i];j<IA[i+1];j++) {
+                m(i,JA[j])+=A[j];
+            }
+        }
+    }
     void rightMultiply(std::valarray<double> const & v, std::valarray<double> & r) const {
         COLA_ASSERT(v.size()>=n);
         COLA_ASSERT(r.size()>=n);
@@ -125,7 +212,14 @@ public:
         }
     }
     double getIJ(const unsigned i, const unsigned j) const {
-        return sparseMap.getIJ(i,j);
+        COLA_ASSERT(i<n);
+        COLA_ASSERT(j<n);
+        for(unsigned k=IA[i];k<IA[i+1];k++) {
+            if(JA[k]==j) {
+                return A[k];
+            }
+        }
+        return 0;
     }
     void print() const {
         for(unsigned i=0;i<n;i++) {
@@ -138,11 +232,17 @@ public:
     unsigned rowSize() const {
         return n;
     }
+    unsigned nonZeroCount() const {
+        return NZ;
+    }
 private:
-    const unsigned n,NZ;
-    SparseMap const & sparseMap;
-    std::valarray<double> A;
-    std::valarray<unsigned> IA, JA;
+    static const unsigned NO_ENTRY = ~0u;
+    unsigned n,NZ;
+    std::vector<double> A;
+    std::vector<unsigned> IA, JA;
+    std::vector<unsigned> diag;
+    // The row being assembled.
+    unsigned row;
 };
 } //namespace cola
 #endif /* _SPARSE_MATRIX_H */
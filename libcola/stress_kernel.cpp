@@ -0,0 +1,238 @@
+/*
+ * vim: ts=4 sw=4 et tw=0 wm=0
+ *
+ * libcola - A library providing force-directed network layout using the
+ *           stress-majorization method subject to separation constraints.
+ *
+ * Copyright (C) 2026  Dunnart contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library in the file LICENSE; if not,
+ * write to the Free Software Foundation, Inc., 59 Temple Place,
+ * Suite 330, Boston, MA  02111-1307  USA
+ *
+*/
+
+#include <cmath>
+#include <cstddef>
+
+#include "libvpsc/assertions.h"
+#include "libcola/stress_kernel.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || \
+        (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define COLA_SSE2_KERNEL
+  #include <emmintrin.h>
+#endif
+
+// The AVX2 kernel is compiled with a target attribute so the rest of the
+// library does not require AVX2, which needs GCC 4.9 or Clang.
+#if defined(COLA_SSE2_KERNEL) && (defined(__x86_64__) || defined(__i386__)) \
+        && (defined(__clang__) || \
+            (defined(__GNUC__) && \
+             (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+  #define COLA_AVX2_KERNEL
+  #include <immintrin.h>
+#endif
+
+namespace cola {
+
+void scalarStressKernel(const double *P, const double *S, const double *D,
+        const unsigned short *G, const unsigned u, const unsigned begin,
+        const unsigned end, double *h, StressTerms& terms)
+{
+    COLA_ASSERT(u<begin || u>=end);
+    for(unsigned v=begin;v<end;v++) {
+        if(h) h[v]=0;
+        unsigned short p=G[v];
+        // no forces between disconnected parts of the graph
+        if(p==0) continue;
+        double dx=P[u]-P[v], dy=S[u]-S[v];
+        double l=sqrt(dx*dx+dy*dy);
+        double d=D[v];
+        if(l>d && p>1) continue; // attractive forces not required
+        double d2=d*d;
+        double rl=d-l;
+        terms.stress+=rl*rl/d2;
+        /* force apart zero distances */
+        if (l < 1e-30) {
+            l=0.1;
+        }
+        terms.gradient+=dx*(l-d)/(d2*l);
+        double huv=(d*dy*dy/(l*l*l)-1)/d2;
+        terms.hessianDiagonal-=huv;
+        if(h) h[v]=huv;
+    }
+}
+
+#ifdef COLA_SSE2_KERNEL
+static void sse2StressKernel(const double *P, const double *S,
+        const double *D, const unsigned short *G, const unsigned u,
+        const unsigned begin, const unsigned end, double *h,
+        StressTerms& terms)
+{
+    COLA_ASSERT(u<begin || u>=end);
+    const __m128d pu=_mm_set1_pd(P[u]), su=_mm_set1_pd(S[u]);
+    const __m128d one=_mm_set1_pd(1.0), tiny=_mm_set1_pd(1e-30);
+    const __m128d nudge=_mm_set1_pd(0.1);
+    __m128d stress=_mm_setzero_pd(), gradient=_mm_setzero_pd();
+    __m128d hessian=_mm_setzero_pd();
+    unsigned v=begin;
+    for(;v+2<=end;v+=2) {
+        const __m128d dx=_mm_sub_pd(pu,_mm_loadu_pd(P+v));
+        const __m128d dy=_mm_sub_pd(su,_mm_loadu_pd(S+v));
+        const __m128d d=_mm_loadu_pd(D+v);
+        __m128d l=_mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(dx,dx),
+                    _mm_mul_pd(dy,dy)));
+        // Active unless p==0, or p>1 and l>d.
+        const __m128i p=_mm_set_epi32(0,G[v+1],0,G[v]);
+        const __m128i zero=_mm_setzero_si128();
+        const __m128d connected=_mm_castsi128_pd(_mm_shuffle_epi32(
+                    _mm_cmpeq_epi32(_mm_cmpeq_epi32(p,zero),zero),
+                    _MM_SHUFFLE(2,2,0,0)));
+        const __m128d adjacent=_mm_castsi128_pd(_mm_shuffle_epi32(
+                    _mm_cmpeq_epi32(p,_mm_set1_epi32(1)),
+                    _MM_SHUFFLE(2,2,0,0)));
+        const __m128d active=_mm_and_pd(connected,
+                _mm_or_pd(adjacent,_mm_cmple_pd(l,d)));
+        const __m128d d2=_mm_mul_pd(d,d);
+        const __m128d rl=_mm_sub_pd(d,l);
+        stress=_mm_add_pd(stress,_mm_and_pd(active,
+                    _mm_div_pd(_mm_mul_pd(rl,rl),d2)));
+        // force apart zero distances
+        const __m128d zeroLength=_mm_cmplt_pd(l,tiny);
+        l=_mm_or_pd(_mm_and_pd(zeroLength,nudge),
+                _mm_andnot_pd(zeroLength,l));
+        gradient=_mm_add_pd(gradient,_mm_and_pd(active,
+                    _mm_div_pd(_mm_mul_pd(dx,_mm_sub_pd(l,d)),
+                        _mm_mul_pd(d2,l))));
+        const __m128d l3=_mm_mul_pd(_mm_mul_pd(l,l),l);
+        const __m128d huv=_mm_and_pd(active,_mm_div_pd(_mm_sub_pd(
+                        _mm_div_pd(_mm_mul_pd(d,_mm_mul_pd(dy,dy)),l3),
+                        one),d2));
+        hessian=_mm_sub_pd(hessian,huv);
+        if(h) {
+            _mm_storeu_pd(h+v,huv);
+        }
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes,stress);
+    terms.stress+=lanes[0]+lanes[1];
+    _mm_storeu_pd(lanes,gradient);
+    terms.gradient+=lanes[0]+lanes[1];
+    _mm_storeu_pd(lanes,hessian);
+    terms.hessianDiagonal+=lanes[0]+lanes[1];
+    scalarStressKernel(P,S,D,G,u,v,end,h,terms);
+}
+#endif
+
+#ifdef COLA_AVX2_KERNEL
+__attribute__((target("avx2")))
+static void avx2StressKernel(const double *P, const double *S,
+        const double *D, const unsigned short *G, const unsigned u,
+        const unsigned begin, const unsigned end, double *h,
+        StressTerms& terms)
+{
+    COLA_ASSERT(u<begin || u>=end);
+    const __m256d pu=_mm256_set1_pd(P[u]), su=_mm256_set1_pd(S[u]);
+    const __m256d one=_mm256_set1_pd(1.0), tiny=_mm256_set1_pd(1e-30);
+    const __m256d nudge=_mm256_set1_pd(0.1);
+    const __m256i zero=_mm256_setzero_si256();
+    const __m256i adjacentType=_mm256_set1_epi64x(1);
+    __m256d stress=_mm256_setzero_pd(), gradient=_mm256_setzero_pd();
+    __m256d hessian=_mm256_setzero_pd();
+    unsigned v=begin;
+    for(;v+4<=end;v+=4) {
+        const __m256d dx=_mm256_sub_pd(pu,_mm256_loadu_pd(P+v));
+        const __m256d dy=_mm256_sub_pd(su,_mm256_loadu_pd(S+v));
+        const __m256d d=_mm256_loadu_pd(D+v);
+        __m256d l=_mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(dx,dx),
+                    _mm256_mul_pd(dy,dy)));
+        // Active unless p==0, or p>1 and l>d.
+        const __m256i p=_mm256_cvtepu16_epi64(
+                _mm_loadl_epi64((const __m128i *) (G+v)));
+        const __m256d disconnected=_mm256_castsi256_pd(
+                _mm256_cmpeq_epi64(p,zero));
+        const __m256d adjacent=_mm256_castsi256_pd(
+                _mm256_cmpeq_epi64(p,adjacentType));
+        const __m256d active=_mm256_andnot_pd(disconnected,
+                _mm256_or_pd(adjacent,_mm256_cmp_pd(l,d,_CMP_LE_OQ)));
+        const __m256d d2=_mm256_mul_pd(d,d);
+        const __m256d rl=_mm256_sub_pd(d,l);
+        stress=_mm256_add_pd(stress,_mm256_and_pd(active,
+                    _mm256_div_pd(_mm256_mul_pd(rl,rl),d2)));
+        // force apart zero distances
+        l=_mm256_blendv_pd(l,nudge,_mm256_cmp_pd(l,tiny,_CMP_LT_OQ));
+        gradient=_mm256_add_pd(gradient,_mm256_and_pd(active,
+                    _mm256_div_pd(_mm256_mul_pd(dx,_mm256_sub_pd(l,d)),
+                        _mm256_mul_pd(d2,l))));
+        const __m256d l3=_mm256_mul_pd(_mm256_mul_pd(l,l),l);
+        const __m256d huv=_mm256_and_pd(active,_mm256_div_pd(
+                    _mm256_sub_pd(_mm256_div_pd(
+                            _mm256_mul_pd(d,_mm256_mul_pd(dy,dy)),l3),one),
+                    d2));
+        hessian=_mm256_sub_pd(hessian,huv);
+        if(h) {
+            _mm256_storeu_pd(h+v,huv);
+        }
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes,stress);
+    terms.stress+=(lanes[0]+lanes[1])+(lanes[2]+lanes[3]);
+    _mm256_storeu_pd(lanes,gradient);
+    terms.gradient+=(lanes[0]+lanes[1])+(lanes[2]+lanes[3]);
+    _mm256_storeu_pd(lanes,hessian);
+    terms.hessianDiagonal+=(lanes[0]+lanes[1])+(lanes[2]+lanes[3]);
+    scalarStressKernel(P,S,D,G,u,v,end,h,terms);
+}
+#endif
+
+namespace {
+    struct KernelChoice {
+        KernelChoice() : kernel(scalarStressKernel), name("scalar") {
+#ifdef COLA_SSE2_KERNEL
+            kernel=sse2StressKernel;
+            name="SSE2";
+#endif
+#ifdef COLA_AVX2_KERNEL
+            __builtin_cpu_init();
+            if(__builtin_cpu_supports("avx2")) {
+                kernel=avx2StressKernel;
+                name="AVX2";
+            }
+#endif
+        }
+        StressKernel kernel;
+        const char *name;
+    };
+
+    const KernelChoice& kernelChoice(void)
+    {
+        static const KernelChoice choice;
+        return choice;
+    }
+}
+
+StressKernel stressKernel(void)
+{
+    return kernelChoice().kernel;
+}
+
+const char *stressKernelName(void)
+{
+    return kernelChoice().name;
+}
+
+} // namespace cola
+
+// vim: filetype=cpp:cindent:expandtab:shiftwidth=4:tabstop=4:softtabstop=4 :
@@ -0,0 +1,82 @@
+/*
+ * vim: ts=4 sw=4 et tw=0 wm=0
+ *
+ * libcola - A library providing force-directed network layout using the
+ *           stress-majorization method subject to separation constraints.
+ *
+ * Copyright (C) 2026  Dunnart contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library in the file LICENSE; if not,
+ * write to the Free Software Foundation, Inc., 59 Temple Place,
+ * Suite 330, Boston, MA  02111-1307  USA
+ *
+*/
+
+/**
+ * The inner loop of ConstrainedFDLayout: the p-stress terms between one
+ * node u and a contiguous range of other nodes v, computed over plain
+ * coordinate and distance arrays so that several pairs can be processed
+ * at once with SIMD instructions.
+ *
+ * For each pair with G[v]!=0, and unless G[v]>1 and the nodes are already
+ * further apart than D[v], the kernel adds the pair's stress, negative
+ * gradient and (negated) Hessian entry to the totals.  Pairs that are
+ * skipped are masked out rather than branched around.
+ *
+ * The implementation is chosen at runtime: AVX2 (4 pairs at a time) where
+ * the compiler and processor support it, otherwise SSE2 (2 pairs) on x86,
+ * otherwise plain scalar code.
+ */
+#ifndef COLA_STRESS_KERNEL_H
+#define COLA_STRESS_KERNEL_H
+
+namespace cola {
+
+struct StressTerms {
+    StressTerms() : stress(0), gradient(0), hessianDiagonal(0) {}
+    double stress;
+    double gradient;
+    double hessianDiagonal;
+};
+
+/**
+ * @param P       node positions in the dimension of the gradient
+ * @param S       node positions in the other dimension
+ * @param D       ideal distances from u to each node
+ * @param G       pair types of u with each node (see PathLengths)
+ * @param u       the node
+ * @param begin   first node of the range, the range must not contain u
+ * @param end     one past the last node of the range
+ * @param h       if not NULL, receives the off-diagonal Hessian entry for
+ *                each v in the range, zero for pairs that were skipped
+ * @param terms   accumulates the stress, gradient and Hessian diagonal
+ */
+typedef void (*StressKernel)(const double *P, const double *S,
+        const double *D, const unsigned short *G, const unsigned u,
+        const unsigned begin, const unsigned end, double *h,
+        StressTerms& terms);
+
+//! The fastest kernel supported by this processor.
+StressKernel stressKernel(void);
+//! The name of the kernel returned by stressKernel().
+const char *stressKernelName(void);
+
+//! The portable implementation, also used for the ends of ranges.
+void scalarStressKernel(const double *P, const double *S, const double *D,
+        const unsigned short *G, const unsigned u, const unsigned begin,
+        const unsigned end, double *h, StressTerms& terms);
+
+} // namespace cola
+
+#endif // COLA_STRESS_KERNEL_H
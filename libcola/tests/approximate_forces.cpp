@@ -0,0 +1,133 @@
+/*
+ * vim: ts=4 sw=4 et tw=0 wm=0
+ *
+ * libcola - A library providing force-directed network layout using the
+ *           stress-majorization method subject to separation constraints.
+ *
+ * Copyright (C) 2026  Dunnart contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library in the file LICENSE; if not,
+ * write to the Free Software Foundation, Inc., 59 Temple Place,
+ * Suite 330, Boston, MA  02111-1307  USA
+ *
+*/
+
+// Compares the stress computed by ConstrainedFDLayout's Barnes-Hut 
+// approximation against the exact stress.
+
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+
+#include "libcola/cola.h"
+using namespace cola;
+
+static const double idealLength = 50;
+
+static int failures = 0;
+
+static void check(const char *name, const double exact, 
+        const double approximate, const double tolerance)
+{
+    const double error = fabs(approximate - exact) / exact;
+    printf("%-40s exact %14.4f approx %14.4f error %.2e\n", name, exact,
+            approximate, error);
+    if (!(error <= tolerance))
+    {
+        printf("  FAILED: error exceeds %.2e\n", tolerance);
+        ++failures;
+    }
+}
+
+// A random connected graph on n nodes scattered over a square, or two 
+// such graphs sharing the square if components is 2.
+static void makeGraph(const unsigned n, const unsigned components,
+        vpsc::Rectangles& rs, std::vector<Edge>& es)
+{
+    const double side = idealLength * sqrt((double) n);
+    for (unsigned i = 0; i < n; ++i)
+    {
+        double x = side * rand() / RAND_MAX;
+        double y = side * rand() / RAND_MAX;
+        rs.push_back(new vpsc::Rectangle(x, x + 10, y, y + 10));
+    }
+    for (unsigned i = components; i < n; ++i)
+    {
+        // Nodes i and j are in the same component if i%components is
+        // the same as j%components.
+        unsigned j = (rand() % (i / components)) * components + 
+                i % components;
+        es.push_back(Edge(j, i));
+        if (rand() % 3 == 0)
+        {
+            j = (rand() % (i / components)) * components + i % components;
+            if (j != i)
+            {
+                es.push_back(Edge(j, i));
+            }
+        }
+    }
+}
+
+static void testGraph(const char *name, const unsigned n, 
+        const unsigned components)
+{
+    vpsc::Rectangles rs;
+    std::vector<Edge> es;
+    makeGraph(n, components, rs, es);
+    ConstrainedFDLayout layout(rs, es, idealLength, false);
+
+    const double exact = layout.computeStress();
+    char label[100];
+
+    // With theta zero no cell is ever approximated.
+    layout.setApproximateForces(true, 0);
+    sprintf(label, "%s, theta 0", name);
+    check(label, exact, layout.computeStress(), 1e-9);
+
+    // An exact radius covering the whole diagram leaves nothing to 
+    // approximate, however large theta is.
+    layout.setApproximateForces(true, 10, 4 * idealLength * sqrt((double) n));
+    sprintf(label, "%s, large exact radius", name);
+    check(label, exact, layout.computeStress(), 1e-9);
+
+    layout.setApproximateForces(true, 0.5);
+    sprintf(label, "%s, theta 0.5", name);
+    check(label, exact, layout.computeStress(), 0.01);
+
+    layout.setApproximateForces(true, 0.7);
+    sprintf(label, "%s, theta 0.7", name);
+    check(label, exact, layout.computeStress(), 0.02);
+
+    for (unsigned i = 0; i < rs.size(); ++i)
+    {
+        delete rs[i];
+    }
+}
+
+int main(void)
+{
+    srand(1);
+    testGraph("connected graph", 2000, 1);
+    testGraph("two interleaved components", 2000, 2);
+    
+    if (failures > 0)
+    {
+        printf("%d checks failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
+
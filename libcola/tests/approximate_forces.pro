@@ -0,0 +1,5 @@
+TARGET = approximate_forces
+include(tests.pri)
+CONFIG += testcase
+
+SOURCES += approximate_forces.cpp
@@ -0,0 +1,7 @@
+# Benchmarks for libcola.  Build with "qmake -config benchmarks".
+
+TEMPLATE = subdirs
+
+SUBDIRS = \
+    sparse_matrix_benchmark.pro \
+    stress_kernel_benchmark.pro
@@ -0,0 +1,144 @@
+/*
+ * vim: ts=4 sw=4 et tw=0 wm=0
+ *
+ * libcola - A library providing force-directed network layout using the
+ *           stress-majorization method subject to separation constraints.
+ *
+ * Copyright (C) 2026  Dunnart contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library in the file LICENSE; if not,
+ * write to the Free Software Foundation, Inc., 59 Temple Place,
+ * Suite 330, Boston, MA  02111-1307  USA
+ *
+*/
+
+// Checks that LandmarkPathLengths gives one distance for each pair of 
+// nodes, whichever end it is looked up from, whether or not its 
+// estimates are kept, and that it agrees with DensePathLengths on the
+// distances it stores exactly.
+
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <cfloat>
+
+#include "libcola/path_lengths.h"
+using namespace cola;
+
+static int failures = 0;
+
+static void fail(const char *what, const unsigned u, const unsigned v,
+        const double a, const double b)
+{
+    if (failures < 20)
+    {
+        printf("FAILED: %s for (%u,%u): %g vs %g\n", what, u, v, a, b);
+    }
+    ++failures;
+}
+
+static void checkStore(const char *name, const LandmarkPathLengths& p,
+        const DensePathLengths& dense)
+{
+    const unsigned n = p.size();
+    std::vector<double> rowU(n), rowV(n);
+    unsigned exact = 0;
+    for (unsigned u = 0; u < n; ++u)
+    {
+        const double *du = p.distances(u, &rowU[0]);
+        for (unsigned v = 0; v < n; ++v)
+        {
+            const double d = p.distance(u, v);
+            if (d != du[v])
+            {
+                fail("distances() and distance() differ", u, v, du[v], d);
+            }
+            if (d != p.distance(v, u))
+            {
+                fail("asymmetric distance", u, v, d, p.distance(v, u));
+            }
+            if (p.pairType(u, v) != p.pairType(v, u))
+            {
+                fail("asymmetric pair type", u, v, p.pairType(u, v),
+                        p.pairType(v, u));
+            }
+            if ((d == DBL_MAX) != (dense.distance(u, v) == DBL_MAX))
+            {
+                fail("connectivity differs", u, v, d, dense.distance(u, v));
+            }
+            // Every edge is stored exactly.
+            if (p.pairType(u, v) == 1)
+            {
+                ++exact;
+                if (fabs(d - dense.distance(u, v)) > 1e-9 * d)
+                {
+                    fail("edge length differs", u, v, d, 
+                            dense.distance(u, v));
+                }
+            }
+        }
+    }
+    printf("%s: %u nodes, %u edge distances checked\n", name, n, exact);
+}
+
+int main(void)
+{
+    srand(1);
+    const unsigned n = 1500;
+    std::vector<Edge> es;
+    // Three components.
+    for (unsigned i = 3; i < n; ++i)
+    {
+        es.push_back(Edge((rand() % (i / 3)) * 3 + i % 3, i));
+        if (rand() % 3 == 0)
+        {
+            unsigned j = (rand() % (i / 3)) * 3 + i % 3;
+            if (j != i)
+            {
+                es.push_back(Edge(j, i));
+            }
+        }
+    }
+    const double scale = 50;
+    DensePathLengths dense(n, es, NULL, scale);
+
+    // The graph is small enough for the estimates to be kept by default.
+    LandmarkPathLengths cached(n, es, NULL, scale);
+    checkStore("kept estimates", cached, dense);
+    LandmarkPathLengths uncached(n, es, NULL, scale, 2, 64, 16, 0);
+    checkStore("recomputed estimates", uncached, dense);
+
+    // Kept estimates are held in single precision.
+    for (unsigned u = 0; u < n; ++u)
+    {
+        for (unsigned v = 0; v < n; ++v)
+        {
+            const double a = cached.distance(u, v);
+            const double b = uncached.distance(u, v);
+            if (a != b && fabs(a - b) > 1e-6 * b)
+            {
+                fail("kept and recomputed estimates differ", u, v, a, b);
+            }
+        }
+    }
+
+    if (failures > 0)
+    {
+        printf("%d checks failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
+
@@ -0,0 +1,5 @@
+TARGET = path_lengths
+include(tests.pri)
+CONFIG += testcase
+
+SOURCES += path_lengths.cpp
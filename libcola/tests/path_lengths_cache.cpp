@@ -0,0 +1,167 @@
+/*
+ * vim: ts=4 sw=4 et tw=0 wm=0
+ *
+ * libcola - A library providing force-directed network layout using the
+ *           stress-majorization method subject to separation constraints.
+ *
+ * Copyright (C) 2026  Dunnart contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library in the file LICENSE; if not,
+ * write to the Free Software Foundation, Inc., 59 Temple Place,
+ * Suite 330, Boston, MA  02111-1307  USA
+ *
+*/
+
+
+// Checks that the path lengths PathLengthsCache updates incrementally 
+// after edges and nodes are added or removed match those computed from 
+// scratch, and that DensePathLengths keeps pair types set with 
+// setPairType() across addEdge() and removeEdge().
+
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <cfloat>
+
+#include "libcola/path_lengths.h"
+using namespace cola;
+
+static int failures = 0;
+
+static void fail(const char *what, const unsigned u, const unsigned v,
+        const double a, const double b)
+{
+    if (failures < 20)
+    {
+        printf("FAILED: %s for (%u,%u): %g vs %g\n", what, u, v, a, b);
+    }
+    ++failures;
+}
+
+static void compare(const PathLengths& p, const PathLengths& fresh)
+{
+    const unsigned n = fresh.size();
+    if (p.size() != n)
+    {
+        fail("size differs", 0, 0, p.size(), n);
+        return;
+    }
+    for (unsigned u = 0; u < n; ++u)
+    {
+        for (unsigned v = 0; v < n; ++v)
+        {
+            const double a = p.distance(u, v);
+            const double b = fresh.distance(u, v);
+            if ((a == DBL_MAX) != (b == DBL_MAX) || 
+                    (b != DBL_MAX && fabs(a - b) > 1e-9 * (1 + b)))
+            {
+                fail("distance differs", u, v, a, b);
+            }
+            if (p.pairType(u, v) != fresh.pairType(u, v))
+            {
+                fail("pair type differs", u, v, p.pairType(u, v),
+                        fresh.pairType(u, v));
+            }
+        }
+    }
+}
+
+int main(void)
+{
+    srand(1);
+    unsigned n = 40;
+    std::vector<Edge> es;
+    std::vector<double> lengths;
+    for (unsigned i = 1; i < n; ++i)
+    {
+        // Leaves a few components.
+        if (rand() % 8 != 0)
+        {
+            es.push_back(Edge(rand() % i, i));
+            lengths.push_back(1 + rand() % 3);
+        }
+    }
+
+    PathLengthsCache cache;
+    for (unsigned step = 0; step < 200; ++step)
+    {
+        // Mostly small edits, which are applied incrementally, and now
+        // and then a large one, which is recomputed.
+        const unsigned edits = (step % 25 == 24) ? 40 : 1 + rand() % 4;
+        for (unsigned k = 0; k < edits; ++k)
+        {
+            const int op = rand() % 5;
+            if (op == 0 && n < 60)
+            {
+                ++n;
+            }
+            else if (op <= 2 || es.empty())
+            {
+                const unsigned u = rand() % n;
+                const unsigned v = rand() % n;
+                if (u != v)
+                {
+                    es.push_back(Edge(u, v));
+                    lengths.push_back(1 + rand() % 3);
+                }
+            }
+            else
+            {
+                const unsigned i = rand() % es.size();
+                es.erase(es.begin() + i);
+                lengths.erase(lengths.begin() + i);
+            }
+        }
+        const std::valarray<double> eLengths(
+                lengths.empty() ? NULL : &lengths[0], lengths.size());
+        PathLengths *p = cache.pathLengths(n, es, &eLengths, 10);
+        DensePathLengths fresh(n, es, &eLengths, 10);
+        compare(*p, fresh);
+
+        // The previous user's pair types must not survive.
+        p->setPairType(0, 1, 2);
+    }
+
+    // Pair types set by the caller are kept by addEdge() and removeEdge().
+    std::vector<Edge> path;
+    path.push_back(Edge(0, 1));
+    path.push_back(Edge(1, 2));
+    DensePathLengths dense(4, path, NULL, 10);
+    dense.setPairType(0, 1, 2);
+    dense.addEdge(2, 3, 10);
+    if (dense.pairType(0, 1) != 2)
+    {
+        fail("override lost by addEdge", 0, 1, dense.pairType(0, 1), 2);
+    }
+    path.push_back(Edge(2, 3));
+    path.erase(path.begin() + 2);
+    dense.removeEdge(2, 3, 10, path, NULL);
+    if (dense.pairType(1, 0) != 2)
+    {
+        fail("override lost by removeEdge", 1, 0, dense.pairType(1, 0), 2);
+    }
+    dense.clearPairTypeOverrides();
+    if (dense.pairType(0, 1) != 1)
+    {
+        fail("override not cleared", 0, 1, dense.pairType(0, 1), 1);
+    }
+
+    if (failures > 0)
+    {
+        printf("%d checks failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,5 @@
+TARGET = path_lengths_cache
+include(tests.pri)
+CONFIG += testcase
+
+SOURCES += path_lengths_cache.cpp
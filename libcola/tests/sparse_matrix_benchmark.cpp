@@ -0,0 +1,155 @@
+/*
+ * vim: ts=4 sw=4 et tw=0 wm=0
+ *
+ * libcola - A library providing force-directed network layout using the
+ *           stress-majorization method subject to separation constraints.
+ *
+ * Copyright (C) 2026  Dunnart contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library in the file LICENSE; if not,
+ * write to the Free Software Foundation, Inc., 59 Temple Place,
+ * Suite 330, Boston, MA  02111-1307  USA
+ *
+*/
+
+// Times assembling the layout Hessian as a SparseMatrix, both through a
+// SparseMap and directly a row at a time, and then times whole 
+// ConstrainedFDLayout iterations, which assemble it twice each.
+//
+// Usage: sparse_matrix_benchmark [nodes] [entries per row] [repeats]
+
+#include <vector>
+#include <valarray>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+#include "libcola/cola.h"
+#include "libcola/sparse_matrix.h"
+using namespace cola;
+
+static double seconds(const clock_t start)
+{
+    return (double) (clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char **argv)
+{
+    const unsigned n = (argc > 1) ? atoi(argv[1]) : 2000;
+    const unsigned perRow = (argc > 2) ? atoi(argv[2]) : 200;
+    const unsigned repeats = (argc > 3) ? atoi(argv[3]) : 10;
+
+    // A fixed random pattern of perRow columns per row, including the 
+    // diagonal, sorted as the layout produces them.
+    srand(1);
+    std::vector<std::vector<unsigned> > columns(n);
+    for (unsigned i = 0; i < n; ++i)
+    {
+        std::vector<bool> used(n, false);
+        used[i] = true;
+        for (unsigned k = 1; k < perRow && k < n; ++k)
+        {
+            unsigned j = rand() % n;
+            while (used[j])
+            {
+                j = (j + 1) % n;
+            }
+            used[j] = true;
+        }
+        for (unsigned j = 0; j < n; ++j)
+        {
+            if (used[j])
+            {
+                columns[i].push_back(j);
+            }
+        }
+    }
+    std::valarray<double> x(1.0, n), r(n);
+
+    clock_t start = clock();
+    double check = 0;
+    for (unsigned rep = 0; rep < repeats; ++rep)
+    {
+        SparseMap map(n);
+        for (unsigned i = 0; i < n; ++i)
+        {
+            for (unsigned k = 0; k < columns[i].size(); ++k)
+            {
+                map(i, columns[i][k]) = i + k + rep;
+            }
+        }
+        SparseMatrix m(map);
+        m.rightMultiply(x, r);
+        check += r[n / 2];
+    }
+    const double viaMap = seconds(start);
+
+    start = clock();
+    SparseMatrix direct(n);
+    for (unsigned rep = 0; rep < repeats; ++rep)
+    {
+        direct.beginAssembly();
+        for (unsigned i = 0; i < n; ++i)
+        {
+            direct.beginRow(i);
+            for (unsigned k = 0; k < columns[i].size(); ++k)
+            {
+                direct.add(columns[i][k]) = i + k + rep;
+            }
+            direct.endRow();
+        }
+        direct.endAssembly();
+        direct.rightMultiply(x, r);
+        check -= r[n / 2];
+    }
+    const double assembled = seconds(start);
+
+    printf("%u x %u matrix, %u entries per row, %u assemblies\n", n, n,
+            perRow, repeats);
+    printf("  through SparseMap:  %8.3fs\n", viaMap);
+    printf("  assembled directly: %8.3fs\n", assembled);
+    if (check != 0)
+    {
+        printf("  results differ\n");
+        return 1;
+    }
+
+    // Whole layout iterations on a random graph of n nodes.
+    std::vector<vpsc::Rectangle *> rs;
+    std::vector<Edge> es;
+    for (unsigned i = 0; i < n; ++i)
+    {
+        double px = rand() % 2000, py = rand() % 2000;
+        rs.push_back(new vpsc::Rectangle(px, px + 10, py, py + 10));
+    }
+    for (unsigned i = 1; i < n; ++i)
+    {
+        es.push_back(Edge(rand() % i, i));
+        if (rand() % 3 == 0)
+        {
+            es.push_back(Edge(rand() % i, i));
+        }
+    }
+    ConstrainedFDLayout layout(rs, es, 50, false);
+    start = clock();
+    layout.runOnce();
+    printf("  one layout iteration on %u nodes: %8.3fs\n", n, 
+            seconds(start));
+    for (unsigned i = 0; i < n; ++i)
+    {
+        delete rs[i];
+    }
+    return 0;
+}
+
@@ -0,0 +1,4 @@
+TARGET = sparse_matrix_benchmark
+include(tests.pri)
+
+SOURCES += sparse_matrix_benchmark.cpp
@@ -0,0 +1,147 @@
+/*
+ * vim: ts=4 sw=4 et tw=0 wm=0
+ *
+ * libcola - A library providing force-directed network layout using the
+ *           stress-majorization method subject to separation constraints.
+ *
+ * Copyright (C) 2026  Dunnart contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library in the file LICENSE; if not,
+ * write to the Free Software Foundation, Inc., 59 Temple Place,
+ * Suite 330, Boston, MA  02111-1307  USA
+ *
+*/
+
+
+// Checks that the kernel chosen for this processor agrees with the 
+// scalar kernel to within rounding, over ranges of every alignment and
+// length, every pair type, and coincident nodes.
+
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+
+#include "libcola/stress_kernel.h"
+using namespace cola;
+
+static int failures = 0;
+
+static bool close(const double a, const double b, const double tolerance)
+{
+    return fabs(a - b) <= tolerance * (1 + fabs(a) + fabs(b));
+}
+
+static void check(const char *what, const unsigned u, const unsigned begin,
+        const unsigned end, const double a, const double b, 
+        const double tolerance)
+{
+    if (!close(a, b, tolerance))
+    {
+        if (failures < 20)
+        {
+            printf("FAILED: %s for u=%u [%u,%u): %.17g vs %.17g\n", what, 
+                    u, begin, end, a, b);
+        }
+        ++failures;
+    }
+}
+
+int main(void)
+{
+    const unsigned n = 1001;
+    std::vector<double> P(n), S(n), D(n), hScalar(n), hKernel(n);
+    std::vector<unsigned short> G(n);
+    srand(1);
+    for (unsigned i = 0; i < n; ++i)
+    {
+        P[i] = rand() % 1000;
+        S[i] = rand() % 1000;
+        D[i] = 1 + rand() % 900;
+        G[i] = rand() % 4;
+    }
+    // Nodes on top of each other are pushed apart.
+    P[7] = P[3];
+    S[7] = S[3];
+    P[500] = P[3];
+    S[500] = S[3];
+
+    StressKernel kernel = stressKernel();
+    printf("checking the %s kernel\n", stressKernelName());
+    unsigned ranges = 0;
+    for (unsigned u = 0; u < 8; ++u)
+    {
+        // Every short range, so each start alignment and tail length.
+        for (unsigned begin = u + 1; begin < u + 12; ++begin)
+        {
+            for (unsigned end = begin; end < begin + 12; ++end)
+            {
+                StressTerms a, b;
+                scalarStressKernel(&P[0], &S[0], &D[0], &G[0], u, begin,
+                        end, &hScalar[0], a);
+                kernel(&P[0], &S[0], &D[0], &G[0], u, begin, end, 
+                        &hKernel[0], b);
+                check("stress", u, begin, end, a.stress, b.stress, 1e-14);
+                check("gradient", u, begin, end, a.gradient, b.gradient,
+                        1e-14);
+                check("Hessian diagonal", u, begin, end, 
+                        a.hessianDiagonal, b.hessianDiagonal, 1e-14);
+                for (unsigned v = begin; v < end; ++v)
+                {
+                    check("Hessian entry", u, v, v + 1, hScalar[v], 
+                            hKernel[v], 1e-15);
+                }
+                ++ranges;
+            }
+        }
+    }
+    // Whole rows, summed in a different order by the SIMD kernels.
+    for (unsigned u = 0; u < n; u += 37)
+    {
+        StressTerms a, b, c;
+        scalarStressKernel(&P[0], &S[0], &D[0], &G[0], u, 0, u, 
+                &hScalar[0], a);
+        scalarStressKernel(&P[0], &S[0], &D[0], &G[0], u, u + 1, n, 
+                &hScalar[0], a);
+        kernel(&P[0], &S[0], &D[0], &G[0], u, 0, u, &hKernel[0], b);
+        kernel(&P[0], &S[0], &D[0], &G[0], u, u + 1, n, &hKernel[0], b);
+        // Without the off-diagonal entries.
+        kernel(&P[0], &S[0], &D[0], &G[0], u, 0, u, NULL, c);
+        kernel(&P[0], &S[0], &D[0], &G[0], u, u + 1, n, NULL, c);
+        check("row stress", u, 0, n, a.stress, b.stress, 1e-12);
+        check("row gradient", u, 0, n, a.gradient, b.gradient, 1e-12);
+        check("row Hessian diagonal", u, 0, n, a.hessianDiagonal,
+                b.hessianDiagonal, 1e-12);
+        check("row stress without h", u, 0, n, b.stress, c.stress, 0);
+        check("row gradient without h", u, 0, n, b.gradient, c.gradient,
+                0);
+        for (unsigned v = 0; v < n; ++v)
+        {
+            if (v != u)
+            {
+                check("row Hessian entry", u, v, v + 1, hScalar[v],
+                        hKernel[v], 1e-15);
+            }
+        }
+        ++ranges;
+    }
+    printf("%u ranges checked\n", ranges);
+
+    if (failures > 0)
+    {
+        printf("%d checks failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
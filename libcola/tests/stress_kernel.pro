@@ -0,0 +1,5 @@
+TARGET = stress_kernel
+include(tests.pri)
+CONFIG += testcase
+
+SOURCES += stress_kernel.cpp
@@ -0,0 +1,124 @@
+/*
+ * vim: ts=4 sw=4 et tw=0 wm=0
+ *
+ * libcola - A library providing force-directed network layout using the
+ *           stress-majorization method subject to separation constraints.
+ *
+ * Copyright (C) 2026  Dunnart contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library in the file LICENSE; if not,
+ * write to the Free Software Foundation, Inc., 59 Temple Place,
+ * Suite 330, Boston, MA  02111-1307  USA
+ *
+*/
+
+
+// Times the stress kernel chosen for this processor against the scalar 
+// kernel over whole rows, as ConstrainedFDLayout calls it, and then 
+// times whole layout iterations.
+//
+// Usage: stress_kernel_benchmark [nodes] [repeats]
+
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+#include "libcola/cola.h"
+#include "libcola/stress_kernel.h"
+using namespace cola;
+
+static double seconds(const clock_t start)
+{
+    return (double) (clock() - start) / CLOCKS_PER_SEC;
+}
+
+static double timeKernel(StressKernel kernel, const std::vector<double>& P,
+        const std::vector<double>& S, const std::vector<double>& D,
+        const std::vector<unsigned short>& G, std::vector<double>& h,
+        const unsigned repeats, double& stress)
+{
+    const unsigned n = P.size();
+    StressTerms terms;
+    clock_t start = clock();
+    for (unsigned rep = 0; rep < repeats; ++rep)
+    {
+        for (unsigned u = 0; u < n; ++u)
+        {
+            kernel(&P[0], &S[0], &D[0], &G[0], u, 0, u, &h[0], terms);
+            kernel(&P[0], &S[0], &D[0], &G[0], u, u + 1, n, &h[0], terms);
+        }
+    }
+    stress = terms.stress;
+    return seconds(start);
+}
+
+int main(int argc, char **argv)
+{
+    const unsigned n = (argc > 1) ? atoi(argv[1]) : 2000;
+    const unsigned repeats = (argc > 2) ? atoi(argv[2]) : 20;
+
+    srand(1);
+    std::vector<double> P(n), S(n), D(n), h(n);
+    std::vector<unsigned short> G(n);
+    for (unsigned i = 0; i < n; ++i)
+    {
+        P[i] = rand() % 2000;
+        S[i] = rand() % 2000;
+        D[i] = 1 + rand() % 1500;
+        G[i] = 1 + (rand() % 8 == 0);
+    }
+
+    double scalarStress, kernelStress;
+    const double scalar = timeKernel(scalarStressKernel, P, S, D, G, h,
+            repeats, scalarStress);
+    const double simd = timeKernel(stressKernel(), P, S, D, G, h,
+            repeats, kernelStress);
+    printf("%u rows of %u pairs, %u repeats\n", n, n, repeats);
+    printf("  scalar kernel: %8.3fs\n", scalar);
+    printf("  %s kernel: %8.3fs (%.2fx)\n", stressKernelName(), simd,
+            scalar / simd);
+
+    // Whole layout iterations on a random graph of n nodes.
+    std::vector<vpsc::Rectangle *> rs;
+    std::vector<Edge> es;
+    for (unsigned i = 0; i < n; ++i)
+    {
+        double px = rand() % 2000, py = rand() % 2000;
+        rs.push_back(new vpsc::Rectangle(px, px + 10, py, py + 10));
+    }
+    for (unsigned i = 1; i < n; ++i)
+    {
+        es.push_back(Edge(rand() % i, i));
+        if (rand() % 3 == 0)
+        {
+            es.push_back(Edge(rand() % i, i));
+        }
+    }
+    ConstrainedFDLayout layout(rs, es, 50, false);
+    layout.runOnce();
+    clock_t start = clock();
+    const unsigned iterations = 5;
+    for (unsigned i = 0; i < iterations; ++i)
+    {
+        layout.runOnce();
+    }
+    printf("  %u layout iterations on %u nodes: %8.3fs\n", iterations, n,
+            seconds(start));
+    for (unsigned i = 0; i < n; ++i)
+    {
+        delete rs[i];
+    }
+    return 0;
+}
@@ -0,0 +1,4 @@
+TARGET = stress_kernel_benchmark
+include(tests.pri)
+
+SOURCES += stress_kernel_benchmark.cpp
@@ -0,0 +1,19 @@
+# Options shared by the libcola test and benchmark programs.
+
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+DEPENDPATH += ../.. .
+INCLUDEPATH += ../.. \
+    ../../libvpsc
+include(../../common_options.qmake)
+CONFIG -= qt
+
+macx:!arcadia {
+LIBS += -L$$DUNNARTBASE/Dunnart.app/Contents/Frameworks
+} else {
+LIBS += -L$$DESTDIR
+}
+LIBS += -lcola -lvpsc
+
+DESTDIR = $$DUNNARTBASE/build/tests
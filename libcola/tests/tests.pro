@@ -0,0 +1,10 @@
+# Tests for libcola.  Build with "qmake -config tests" and run with 
+# "make check".
+
+TEMPLATE = subdirs
+
+SUBDIRS = \
+    approximate_forces.pro \
+    path_lengths.pro \
+    path_lengths_cache.pro \
+    stress_kernel.pro
@@ -239,9 +239,12 @@ Canvas::Canvas()
     m_router->setRoutingParameter(Avoid::shapeBufferDistance, 4.0);
     m_router->setRoutingOption(
             Avoid::nudgeOrthogonalSegmentsConnectedToShapes, true);
+    m_router->setRoutingOption(
+            Avoid::reuseUnaffectedOrthogonalRoutes, true);
 
     m_router->setRoutingParameter(Avoid::segmentPenalty, 50);
     m_router->setRoutingParameter(Avoid::clusterCrossingPenalty, 0);
+    m_router->setWorkerCount(qMax(QThread::idealThreadCount(), 1));
     //m_router->setRoutingParameter(Avoid::fixedSharedPathPenalty);
 
     m_animation_group = new QParallelAnimationGroup();
@@ -1268,6 +1271,18 @@ void Canvas::setDebugCOLAOutput(const bool value)
     m_graphlayout->setOutputDebugFiles(value);
 }
 
+void Canvas::setDebugRoutingTelemetry(const bool value)
+{
+    // While enabled, reroute_connectors() logs the router's telemetry
+    // for each transaction.
+    m_router->setTelemetryEnabled(value);
+}
+
+bool Canvas::debugRoutingTelemetry(void) const
+{
+    return m_router->telemetryEnabled();
+}
+
 QColor Canvas::optCanvasBackgroundColour(void) const
 {
     return m_opt_canvas_background_colour;
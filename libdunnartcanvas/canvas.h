@@ -219,6 +219,7 @@ class Canvas : public QGraphicsScene
         bool overlayRouterObstacles(void) const;
         bool overlayRouterVisGraph(void) const;
         bool overlayRouterOrthogonalVisGraph(void) const;
+        bool debugRoutingTelemetry(void) const;
         Actions& getActions(void);
         QString assignStringId(QString id);
         uint assignInternalId(void);
@@ -273,6 +274,7 @@ class Canvas : public QGraphicsScene
         void setOptIdealEdgeLengthModifier(double modifier);
 
         void setDebugCOLAOutput(const bool value);
+        void setDebugRoutingTelemetry(const bool value);
         void setOptAutomaticGraphLayout(const bool value);
         void setOptPreventOverlaps(const bool value);
         void setOptPreserveTopology(const bool value);
@@ -144,6 +144,10 @@ CanvasTabWidget::CanvasTabWidget(QMainWindow *window) :
     m_action_cola_debug_output = new QAction(tr("Output COLA debug files"), this);
     m_action_cola_debug_output->setCheckable(true);
 
+    m_action_routing_telemetry_output = new QAction(
+            tr("Output routing telemetry"), this);
+    m_action_routing_telemetry_output->setCheckable(true);
+
     m_action_lock = new QAction(QIcon(":/resources/images/locklayout.png"),
             tr("Pin/Unpin"), this);
 
@@ -303,6 +307,12 @@ void CanvasTabWidget::currentChanged(int index)
     connect(m_action_cola_debug_output, SIGNAL(triggered(bool)),
             m_canvas, SLOT(setDebugCOLAOutput(bool)));
 
+    m_action_routing_telemetry_output->disconnect();
+    connect(m_action_routing_telemetry_output, SIGNAL(triggered(bool)),
+            m_canvas, SLOT(setDebugRoutingTelemetry(bool)));
+    m_action_routing_telemetry_output->setChecked(
+            m_canvas->debugRoutingTelemetry());
+
     m_action_lock->disconnect();
     connect(m_action_lock, SIGNAL(triggered()),
             m_canvas, SLOT(toggleSelectedShapePinning()));
@@ -530,6 +540,7 @@ void CanvasTabWidget::addLayoutMenuActions(QMenu *layout_menu)
     layout_menu->addAction(m_action_automatic_layout);
     layout_menu->addSeparator();
     layout_menu->addAction(m_action_cola_debug_output);
+    layout_menu->addAction(m_action_routing_telemetry_output);
 }
 
 
@@ -99,6 +99,7 @@ private:
     QAction *m_action_lock;
     QAction *m_action_automatic_layout;
     QAction *m_action_cola_debug_output;
+    QAction *m_action_routing_telemetry_output;
     QAction *m_action_overlay_router_obstacles;
     QAction *m_action_overlay_router_visgraph;
     QAction *m_action_overlay_router_orthogonal_visgraph;
@@ -1257,9 +1257,10 @@ void GraphLayout::run(const bool shouldReinitialise)
 
     cola::ConstrainedFDLayout alg(m_graph->rs, m_graph->edges, 1.0,
             m_canvas->m_opt_prevent_overlaps, &elengths[0], postIter, 
-            &preIter);
+            &preIter, &m_path_lengths_cache);
     alg.setConstraints(m_graph->ccs);
     alg.setClusterHierarchy(&(m_graph->clusterHierarchy));
+    alg.setWorkerCount(qMax(QThread::idealThreadCount(), 1));
     if (runLevel == 1)
     {
         if (shouldReinitialise)
@@ -34,6 +34,7 @@
 #include <set>
 
 #include "libcola/cola.h"
+#include "libcola/path_lengths.h"
 #include "libdunnartcanvas/shape.h"
 #include "libdunnartcanvas/canvas.h"
 
@@ -188,6 +189,9 @@ private:
 
     //! the graph itself and mappings to/from dunnart objects
     GraphData *m_graph;
+    //! path lengths kept from one layout to the next, so that an edit
+    //! to the graph's structure only updates them
+    cola::PathLengthsCache m_path_lengths_cache;
     bool m_is_running;
     // The following are lists of PosInfo used to communicate between the GUI
     PosInfos retPositions;
@@ -483,6 +483,25 @@ void reroute_connectors(Canvas *canvas, const bool force,
     }
     bool changes = router->processTransaction();
     //router->outputInstanceToSVG("libavoid-debug-new");
+    if (changes && router->telemetryEnabled())
+    {
+        const TransactionTelemetry& telemetry =
+                router->lastTransactionTelemetry();
+        qDebug("Routing: %.1fms total, %.1fms visibility graph, "
+               "%.1fms path search (%lu nodes expanded), %.1fms crossings, "
+               "%.1fms hyperedges, %.1fms nudging; %u connectors rerouted, "
+               "%u searched, %u rerouted for crossings",
+               telemetry.totalTime * 1000,
+               telemetry.visibilityGraphTime * 1000,
+               telemetry.pathSearchTime * 1000,
+               telemetry.pathSearchExpansions,
+               telemetry.crossingTime * 1000,
+               telemetry.hyperedgeTime * 1000,
+               telemetry.nudgingTime * 1000,
+               telemetry.connectorsRerouted,
+               telemetry.connectorsSearched,
+               telemetry.crossingConnectorsRerouted);
+    }
     // Update connectors.
     if (changes)
     {
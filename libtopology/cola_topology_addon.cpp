@@ -28,6 +28,7 @@
 #include "libvpsc/rectangle.h"
 #include "libvpsc/constraint.h"
 #include "libcola/compound_constraints.h"
+#include "libcola/path_lengths.h"
 #include "libtopology/topology_constraints.h"
 #include "libtopology/cola_topology_addon.h"
 
@@ -88,7 +89,7 @@ void ColaTopologyAddon::handleResizes(const cola::Resizes& resizeList,
     FILE_LOG(cola::logDEBUG) << "ColaTopologyAddon::handleResizes()... done.";
 }
 
-void ColaTopologyAddon::computePathLengths(unsigned short** G)
+void ColaTopologyAddon::computePathLengths(cola::PathLengths& pathLengths)
 {
     // we don't need to compute attractive forces between nodes connected
     // by an edge if there is a topologyRoute between them (since the
@@ -100,7 +101,7 @@ void ColaTopologyAddon::computePathLengths(unsigned short** G)
             if(!e->cycle()) {
                 unsigned u=e->firstSegment->start->node->id,
                          v=e->lastSegment->end->node->id;
-                G[u][v]=G[v][u]=2;
+                pathLengths.setPairType(u,v,2);
             }
         }
     }
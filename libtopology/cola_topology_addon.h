@@ -54,7 +54,7 @@ class ColaTopologyAddon : public cola::TopologyAddonInterface
                 cola::CompoundConstraints& ccs, 
                 vpsc::Rectangles& boundingBoxes,
                 cola::RootCluster* clusterHierarchy);
-        void computePathLengths(unsigned short** G);
+        void computePathLengths(cola::PathLengths& pathLengths);
         double computeStress(void) const;
         bool useTopologySolver(void) const;
         void makeFeasible(bool generateNonOverlapConstraints, 
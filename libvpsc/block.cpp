@@ -128,7 +128,7 @@ void Block::setUpOutConstraints() {
 }
 void Block::setUpConstraintHeap(PairingHeap<Constraint*,CompareConstraints>* &h,bool in) {
     delete h;
-    h = new PairingHeap<Constraint*,CompareConstraints>();
+    h = new PairingHeap<Constraint*,CompareConstraints>(blocks->nodePool);
     for (Vit i=vars->begin();i!=vars->end();++i) {
         Variable *v=*i;
         std::vector<Constraint*> *cs=in?&(v->in):&(v->out);
@@ -444,25 +444,6 @@ Block::Pair Block::compute_dfdv_between(
 }
 */
 
-// resets LMs for all active constraints to 0 by
-// traversing active constraint tree starting from v,
-// not back tracking over u
-void Block::reset_active_lm(Variable* const v, Variable* const u) {
-    for(Cit it=v->out.begin();it!=v->out.end();++it) {
-        Constraint *c=*it;
-        if(canFollowRight(c,u)) {
-            c->lm=0;
-            reset_active_lm(c->right,v);
-        }
-    }
-    for(Cit it=v->in.begin();it!=v->in.end();++it) {
-        Constraint *c=*it;
-        if(canFollowLeft(c,u)) {
-            c->lm=0;
-            reset_active_lm(c->left,v);
-        }
-    }
-}
 void Block::list_active(Variable* const v, Variable* const u) {
     for(Cit it=v->out.begin();it!=v->out.end();++it) {
         Constraint *c=*it;
@@ -489,9 +470,10 @@ void Block::list_active(Variable* const v, Variable* const u) {
  * finds the constraint with the minimum lagrange multiplier, that is, the constraint
  * that most wants to split
  */
+// compute_dfdv() sets the LM of every active constraint it traverses, so 
+// they need not be reset first.
 Constraint *Block::findMinLM() {
     Constraint *min_lm=NULL;
-    reset_active_lm(vars->front(),NULL);
     compute_dfdv(vars->front(),NULL,min_lm);
 #ifdef LIBVPSC_LOGGING
     ofstream f(LOGFILE,ios::app);
@@ -501,7 +483,6 @@ Constraint *Block::findMinLM() {
     return min_lm;
 }
 Constraint *Block::findMinLMBetween(Variable* const lv, Variable* const rv) {
-    reset_active_lm(vars->front(),NULL);
     compute_dfdv(vars->front(),NULL);
     Constraint *min_lm=NULL;
     split_path(rv,lv,NULL,min_lm);
@@ -100,7 +100,6 @@ public:
 private:
 	typedef enum {NONE, LEFT, RIGHT} Direction;
 	typedef std::pair<double, Constraint*> Pair;
-	void reset_active_lm(Variable* const v, Variable* const u);
 	void list_active(Variable* const v, Variable* const u);
 	double compute_dfdv(Variable* const v, Variable* const u);
 	double compute_dfdv(Variable* const v, Variable* const u, Constraint *&min_lm);
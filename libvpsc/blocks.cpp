@@ -39,6 +39,7 @@
 #include "libvpsc/block.h"
 #include "libvpsc/constraint.h"
 #include "libvpsc/variable.h"
+#include "libvpsc/pairing_heap.h"
 #include "libvpsc/assertions.h"
 
 #ifdef LIBVPSC_LOGGING
@@ -58,6 +59,7 @@ namespace vpsc {
 
 Blocks::Blocks(vector<Variable*> const &vs) : vs(vs),nvs(vs.size()) {
     blockTimeCtr=0;
+    nodePool=new PairNodePool<Constraint*>();
     m_blocks.resize(nvs);
     for(int i=0;i<nvs;i++) {
         m_blocks[i] = new Block(this, vs[i]);
@@ -72,6 +74,7 @@ Blocks::~Blocks(void)
         delete m_blocks[i];
     }
     m_blocks.clear();
+    delete nodePool;
 }
 
 /**
@@ -48,6 +48,8 @@
 // size_t is strangely not defined on some older MinGW GCC versions. 
 #include <cstddef>
 
+template <class T> class PairNodePool;
+
 namespace vpsc {
 class Block;
 class Variable;
@@ -74,6 +76,9 @@ public:
     void insert(Block *block);
     
     long blockTimeCtr;
+    // Nodes for the constraint heaps of all the blocks, which are merged
+    // with one another as the blocks are.
+    PairNodePool<Constraint*> *nodePool;
 private:
 	void dfsVisit(Variable *v, std::list<Variable*> *order);
 	void removeBlock(Block *doomed);
@@ -42,6 +42,7 @@
 #define VPSC_PAIRING_HEAP_H
 
 #include <cstdlib>
+#include <new>
 #include <fstream>
 #include <vector>
 #include <list>
@@ -80,6 +81,50 @@ struct PairNode
        	{ }
 };
 
+// Arena of nodes shared by a group of heaps, such as those of the blocks
+// of one solver.  Nodes are carved from chunks and recycled through a free
+// list, rather than allocated individually for each insert.  Heaps may
+// only be merged with other heaps using the same pool.
+template <class T>
+class PairNodePool
+{
+public:
+	PairNodePool() : freeList(NULL) { }
+	~PairNodePool() {
+		for(size_t i=0;i<chunks.size();++i) {
+			::operator delete(chunks[i]);
+		}
+	}
+	PairNode<T> *allocate( const T & x ) {
+		if( freeList == NULL ) {
+			addChunk();
+		}
+		PairNode<T> *node = freeList;
+		freeList = node->nextSibling;
+		return new (node) PairNode<T>( x );
+	}
+	void release( PairNode<T> *node ) {
+		node->~PairNode<T>();
+		node->nextSibling = freeList;
+		freeList = node;
+	}
+private:
+	PairNodePool(const PairNodePool &);
+	PairNodePool &operator=(const PairNodePool &);
+	void addChunk() {
+		const size_t chunkSize = 256;
+		PairNode<T> *chunk = static_cast<PairNode<T> *>(
+				::operator new(chunkSize * sizeof(PairNode<T>)));
+		chunks.push_back(chunk);
+		for(size_t i=0;i<chunkSize;++i) {
+			chunk[i].nextSibling = freeList;
+			freeList = &chunk[i];
+		}
+	}
+	std::vector<PairNode<T> *> chunks;
+	PairNode<T> *freeList;
+};
+
 template <class T, class TCompare>
 class PairingHeap;
 
@@ -93,8 +138,10 @@ class PairingHeap
 	friend std::ostream& operator<< <T,TCompare> (std::ostream &os, const PairingHeap<T,TCompare> &b);
 #endif
 public:
-	PairingHeap() : root(NULL), counter(0) { }
-	PairingHeap(const PairingHeap & rhs) { 
+	PairingHeap(PairNodePool<T> *pool = NULL) 
+		: pool(pool), root(NULL), counter(0), treeArray(5) { }
+	PairingHeap(const PairingHeap & rhs) 
+		: pool(rhs.pool), root(NULL), counter(0), treeArray(5) { 
 		// uses operator= to make deep copy
 		*this = rhs; 
 	}
@@ -128,12 +175,22 @@ protected:
 	}
 	TCompare lessThan;
 private:
+	PairNodePool<T> *pool;
 	PairNode<T> *root;
 	unsigned counter;
+	// Scratch space for combineSiblings(), kept per heap rather than 
+	// shared so that separate solver instances can run concurrently.
+	mutable std::vector<PairNode<T> *> treeArray;
 	void reclaimMemory( PairNode<T> *t ) const;
 	void compareAndLink( PairNode<T> * & first, PairNode<T> *second ) const;
 	PairNode<T> * combineSiblings( PairNode<T> *firstSibling ) const;
 	PairNode<T> * clone( PairNode<T> * t ) const;
+	PairNode<T> * newNode( const T & x ) const {
+		return pool ? pool->allocate( x ) : new PairNode<T>( x );
+	}
+	void deleteNode( PairNode<T> *t ) const {
+		if( pool ) pool->release( t ); else delete t;
+	}
 };
 
 
@@ -145,14 +202,14 @@ template <class T,class TCompare>
 PairNode<T> *
 PairingHeap<T,TCompare>::insert( const T & x )
 {
-	PairNode<T> *newNode = new PairNode<T>( x );
+	PairNode<T> *node = newNode( x );
 
 	if( root == NULL )
-		root = newNode;
+		root = node;
 	else
-		compareAndLink( root, newNode );
+		compareAndLink( root, node );
 	counter++;
-	return newNode;
+	return node;
 }
 
 /**
@@ -184,7 +241,7 @@ void PairingHeap<T,TCompare>::deleteMin( )
         root = combineSiblings( root->leftChild );
     COLA_ASSERT(counter);
     counter--;
-    delete oldRoot;
+    deleteNode(oldRoot);
 }
 
 /**
@@ -215,7 +272,7 @@ void PairingHeap<T,TCompare>::reclaimMemory( PairNode<T> * t ) const
 	{
 		reclaimMemory( t->leftChild );
 		reclaimMemory( t->nextSibling );
-		delete t;
+		deleteNode(t);
 	}
 }
 
@@ -252,6 +309,7 @@ void PairingHeap<T,TCompare>::decreaseKey( PairNode<T> *p,
 template <class T,class TCompare>
 void PairingHeap<T,TCompare>::merge( PairingHeap<T,TCompare> *rhs )
 {	
+	COLA_ASSERT(pool == rhs->pool);
 	unsigned rhsSize;
 	PairNode<T> *broot=rhs->removeRootForMerge(rhsSize);
 	if (root == NULL) {
@@ -315,9 +373,6 @@ PairingHeap<T,TCompare>::combineSiblings( PairNode<T> *firstSibling ) const
 	if( firstSibling->nextSibling == NULL )
 		return firstSibling;
 
-	// Allocate the array
-	static std::vector<PairNode<T> *> treeArray( 5 );
-
 	// Store the subtrees in an array
 	int numSiblings = 0;
 	for( ; firstSibling != NULL; numSiblings++ )
@@ -363,7 +418,7 @@ PairingHeap<T,TCompare>::clone( PairNode<T> * t ) const
 		return NULL;
 	else
 	{
-		PairNode<T> *p = new PairNode<T>( t->element );
+		PairNode<T> *p = newNode( t->element );
 		if( ( p->leftChild = clone( t->leftChild ) ) != NULL )
 			p->leftChild->prev = p;
 		if( ( p->nextSibling = clone( t->nextSibling ) ) != NULL )
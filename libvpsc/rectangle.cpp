@@ -202,33 +202,69 @@ NodeSet* getRightNeighbours(NodeSet &scanline,Node *v) {
     return rightv;
 }
 
-typedef enum {Open, Close} EventType;
-struct Event {
-    EventType type;
-    Node *v;
-    double pos;
-    Event(EventType t, Node *v, double p) : type(t),v(v),pos(p) {};
+typedef ConstraintGenerator::Event Event;
+struct CmpEvents {
+    bool operator()(const Event& a, const Event& b) const {
+        if(a.pos!=b.pos) {
+            return a.pos<b.pos;
+        }
+        if(a.open!=b.open) {
+            // when comparing opening and closing
+            // open must come first
+            return a.open;
+        }
+        // Unlike the qsort() comparison this replaced, ties between
+        // events of the same type are broken by rectangle index, so the
+        // order is the same whichever order the events started in.
+        return a.index<b.index;
+    }
 };
-Event **events;
-int compare_events(const void *a, const void *b) {
-    Event *ea=*(Event**)a;
-    Event *eb=*(Event**)b;
-    if(ea->pos==eb->pos) {
-        // when comparing opening and closing
-        // open must come first
-        if(ea->type==Open) return -1;
-        return 1;
-    } else if(ea->pos > eb->pos) {
-        return 1;
-    } else if(ea->pos < eb->pos) {
-        return -1;
-    } else if(isNaN(ea->pos) != isNaN(ea->pos)) {
-        /* See comment in CmpNodePos. */
-        return ( isNaN(ea->pos)
-             ? -1
-             : 1 );
+
+/**
+ * Brings the sweep events for constraints in dimension dim up to date
+ * with the rectangles and sorts them.  The events are swept along the
+ * conjugate dimension.  If the previous call was for the same number of
+ * rectangles its order is used as the starting point for an insertion
+ * sort, which is abandoned for a full sort once it has made more than
+ * about 2n log 2n moves.
+ */
+void ConstraintGenerator::sortEvents(const Dim dim, const Rectangles& rs) {
+    const Dim sweep=conjugate(dim);
+    vector<Event> &es=events[dim];
+    const size_t n=rs.size(), m=2*n;
+    const bool incremental=es.size()==m;
+    if(!incremental) {
+        es.resize(m);
+        for(unsigned i=0;i<n;i++) {
+            es[2*i].index=es[2*i+1].index=i;
+            es[2*i].open=true;
+            es[2*i+1].open=false;
+        }
+    }
+    for(vector<Event>::iterator e=es.begin();e!=es.end();++e) {
+        Rectangle *r=rs[e->index];
+        e->pos=e->open?r->getMinD(sweep):r->getMaxD(sweep);
+    }
+    CmpEvents cmp;
+    if(incremental) {
+        size_t budget=m, moves=0;
+        for(size_t l=m;l>1;l>>=1) {
+            budget+=m;
+        }
+        size_t i=1;
+        for(;i<m&&moves<=budget;i++) {
+            Event e=es[i];
+            size_t j=i;
+            for(;j>0&&cmp(e,es[j-1]);--j,++moves) {
+                es[j]=es[j-1];
+            }
+            es[j]=e;
+        }
+        if(i>=m) {
+            return;
+        }
     }
-    return 0;
+    std::sort(es.begin(),es.end(),cmp);
 }
 
 /**
@@ -237,23 +273,34 @@ int compare_events(const void *a, const void *b) {
  * all overlap in the x pass, or leave some overlaps for the y pass.
  */
 void generateXConstraints(vector<Rectangle*> const & rs, vector<Variable*> const &vars, vector<Constraint*> &cs, const bool useNeighbourLists) {
+    ConstraintGenerator g;
+    g.generateXConstraints(rs,vars,cs,useNeighbourLists);
+}
+
+/**
+ * Prepares constraints in order to apply VPSC vertically to remove ALL overlap.
+ */
+void generateYConstraints(const Rectangles& rs, const Variables& vars, Constraints& cs) {
+    ConstraintGenerator g;
+    g.generateYConstraints(rs,vars,cs);
+}
+
+void ConstraintGenerator::generateXConstraints(const Rectangles& rs, const Variables& vars, Constraints& cs, const bool useNeighbourLists) {
     const unsigned n = rs.size();
     COLA_ASSERT(vars.size()>=n);
-    events=new Event*[2*n];
-    unsigned i,ctr=0;
+    vector<Node*> nodes(n);
+    unsigned i;
     for(i=0;i<n;i++) {
         vars[i]->desiredPosition=rs[i]->getCentreX();
-        Node *v = new Node(vars[i],rs[i],rs[i]->getCentreX());
-        events[ctr++]=new Event(Open,v,rs[i]->getMinY());
-        events[ctr++]=new Event(Close,v,rs[i]->getMaxY());
+        nodes[i] = new Node(vars[i],rs[i],rs[i]->getCentreX());
     }
-    qsort((Event*)events, (size_t)2*n, sizeof(Event*), compare_events );
+    sortEvents(XDIM,rs);
 
     NodeSet scanline;
     for(i=0;i<2*n;i++) {
-        Event *e=events[i];
-        Node *v=e->v;
-        if(e->type==Open) {
+        const Event &e=events[XDIM][i];
+        Node *v=nodes[e.index];
+        if(e.open) {
             scanline.insert(v);
             if(useNeighbourLists) {
                 v->setNeighbours(
@@ -314,41 +361,29 @@ void generateXConstraints(vector<Rectangle*> const & rs, vector<Variable*> const
             COLA_ASSERT(result==1);
             delete v;
         }
-        delete e;
     }
     COLA_ASSERT(scanline.size()==0);
-    delete [] events;
 }
 
-/**
- * Prepares constraints in order to apply VPSC vertically to remove ALL overlap.
- */
-void generateYConstraints(const Rectangles& rs, const Variables& vars, Constraints& cs) {
+void ConstraintGenerator::generateYConstraints(const Rectangles& rs, const Variables& vars, Constraints& cs) {
     const unsigned n = rs.size();
     COLA_ASSERT(vars.size()>=n);
-    events=new Event*[2*n];
-    unsigned ctr=0;
-    Rectangles::const_iterator ri=rs.begin(), re=rs.end();
-    Variables::const_iterator vi=vars.begin(), ve=vars.end();
-    for(;ri!=re&&vi!=ve;++ri,++vi) {
-        Rectangle* r=*ri;
-        Variable* v=*vi;
-        v->desiredPosition=r->getCentreY();
-        Node *node = new Node(v,r,r->getCentreY());
+    vector<Node*> nodes(n);
+    for(unsigned i=0;i<n;i++) {
+        Rectangle* r=rs[i];
+        vars[i]->desiredPosition=r->getCentreY();
+        nodes[i] = new Node(vars[i],r,r->getCentreY());
         COLA_ASSERT(r->getMinX()<r->getMaxX());
-        events[ctr++]=new Event(Open,node,r->getMinX());
-        events[ctr++]=new Event(Close,node,r->getMaxX());
     }
-    COLA_ASSERT(ri==rs.end());
-    qsort((Event*)events, (size_t)2*n, sizeof(Event*), compare_events );
+    sortEvents(YDIM,rs);
     NodeSet scanline;
 #ifndef NDEBUG
     size_t deletes=0;
 #endif
     for(unsigned i=0;i<2*n;i++) {
-        Event *e=events[i];
-        Node *v=e->v;
-        if(e->type==Open) {
+        const Event &e=events[YDIM][i];
+        Node *v=nodes[e.index];
+        if(e.open) {
             scanline.insert(v);
             NodeSet::iterator it=scanline.find(v);
             if(it!=scanline.begin()) {
@@ -383,11 +418,9 @@ void generateYConstraints(const Rectangles& rs, const Variables& vars, Constrain
             COLA_ASSERT(erased==1);
             delete v;
         }
-        delete e;
     }
     COLA_ASSERT(scanline.size()==0);
     COLA_ASSERT(deletes==n);
-    delete [] events;
 }
 #include "libvpsc/linesegment.h"
 using namespace linesegment;
@@ -603,7 +636,8 @@ void removeoverlaps(Rectangles& rs, const set<unsigned>& fixed, bool thirdPass)
             }
         }
         Constraints cs;
-        generateXConstraints(rs,vs,cs,true);
+        ConstraintGenerator generator;
+        generator.generateXConstraints(rs,vs,cs,true);
         Solver vpsc_x(vs,cs);
         vpsc_x.solve();
         Rectangles::iterator r=rs.begin();
@@ -617,7 +651,7 @@ void removeoverlaps(Rectangles& rs, const set<unsigned>& fixed, bool thirdPass)
         // Removing the extra gap here ensures things that were moved to be
         // adjacent to one another above are not considered overlapping
         Rectangle::setXBorder(xBorder);
-        generateYConstraints(rs,vs,cs);
+        generator.generateYConstraints(rs,vs,cs);
         Solver vpsc_y(vs,cs);
         vpsc_y.solve();
         r=rs.begin();
@@ -640,7 +674,7 @@ void removeoverlaps(Rectangles& rs, const set<unsigned>& fixed, bool thirdPass)
             for(v=vs.begin();v!=vs.end();++v,++r) {
                 (*r)->moveCentreX(initX[(*v)->id]);
             }
-            generateXConstraints(rs,vs,cs,false);
+            generator.generateXConstraints(rs,vs,cs,false);
             Solver vpsc_x2(vs,cs);
             vpsc_x2.solve();
             r=rs.begin();
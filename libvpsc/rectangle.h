@@ -240,6 +240,31 @@ class Constraint;
 void generateXConstraints(const Rectangles& rs, std::vector<Variable*> const & vars, std::vector<Constraint*> & cs, const bool useNeighbourLists);
 void generateYConstraints(std::vector<Rectangle*> const & rs, std::vector<Variable*> const & vars, std::vector<Constraint*> & cs);
 
+/**
+ * Generates non-overlap constraints like generateXConstraints and
+ * generateYConstraints, but keeps the sorted sweep events from one call
+ * to the next.  Only the sort is incremental: every call sweeps all the
+ * events and generates all the constraints again.  When the rectangles
+ * have moved only a little since the previous call the old event order
+ * is repaired with an insertion sort, which gives up and falls back to a
+ * full sort once it has done O(n log n) work, so a call is never
+ * asymptotically worse than the stateless functions.
+ */
+class ConstraintGenerator {
+public:
+    ConstraintGenerator() {}
+    void generateXConstraints(const Rectangles& rs, std::vector<Variable*> const & vars, std::vector<Constraint*> & cs, const bool useNeighbourLists);
+    void generateYConstraints(const Rectangles& rs, std::vector<Variable*> const & vars, std::vector<Constraint*> & cs);
+    struct Event {
+        double pos;
+        unsigned index;
+        bool open;
+    };
+private:
+    void sortEvents(const Dim dim, const Rectangles& rs);
+    std::vector<Event> events[2];
+};
+
 /** 
  * Moves all the rectangles to remove all overlaps.  Heuristic
  * attempts to move by as little as possible.
@@ -36,6 +36,7 @@
 #include <map>
 #include <cfloat>
 #include <set>
+#include <algorithm>
 
 #include "libvpsc/constraint.h"
 #include "libvpsc/block.h"
@@ -302,6 +303,7 @@ bool IncSolver::satisfy() {
     f<<"  finished merges."<<endl;
 #endif
     bs->cleanup();
+    COLA_ASSERT(m==cs.size());
     bool activeConstraints=false;
     for(unsigned i=0;i<m;i++) {
         v=cs[i];
@@ -323,6 +325,57 @@ bool IncSolver::satisfy() {
     copyResult();
     return activeConstraints;
 }
+/**
+ * Adds constraint c to the problem as an inactive constraint, to be merged
+ * across by the next satisfy() if it is violated.
+ */
+void IncSolver::addConstraint(Constraint *c) {
+    c->active=false;
+    c->left->out.push_back(c);
+    c->right->in.push_back(c);
+    inactive.push_back(c);
+    ++m;
+}
+static void eraseConstraint(Constraints &l, Constraint *c) {
+    Constraints::iterator i=find(l.begin(),l.end(),c);
+    COLA_ASSERT(i!=l.end());
+    *i=l.back();
+    l.pop_back();
+}
+/**
+ * Removes the doomed constraints from the problem.  Blocks are split across
+ * any of them that are active, leaving the remaining active constraints in 
+ * place.  The constraints may be deleted once this returns.
+ */
+void IncSolver::removeConstraints(Constraints const &doomed) {
+    if(doomed.empty()) return;
+    for(Constraints::const_iterator i=doomed.begin();i!=doomed.end();++i) {
+        Constraint *c=*i;
+        if(c->active) {
+            Block *b=c->left->block, *l=NULL, *r=NULL;
+            COLA_ASSERT(c->left->block == c->right->block);
+            b->split(l,r,c);
+            l->updateWeightedPosition();
+            r->updateWeightedPosition();
+            bs->insert(l);
+            bs->insert(r);
+            b->deleted=true;
+        }
+        eraseConstraint(c->left->out,c);
+        eraseConstraint(c->right->in,c);
+    }
+    bs->cleanup();
+    set<Constraint*> doomedSet(doomed.begin(),doomed.end());
+    size_t j=0;
+    for(size_t i=0;i<inactive.size();++i) {
+        if(doomedSet.find(inactive[i])==doomedSet.end()) {
+            inactive[j++]=inactive[i];
+        }
+    }
+    inactive.resize(j);
+    COLA_ASSERT(m>=doomed.size());
+    m-=doomed.size();
+}
 void IncSolver::moveBlocks() {
 #ifdef LIBVPSC_LOGGING
     ofstream f(LOGFILE,ios::app);
@@ -93,6 +93,12 @@ public:
 	void moveBlocks();
 	void splitBlocks();
 	IncSolver(std::vector<Variable*> const &vs, std::vector<Constraint*> const &cs);
+	// Changes to the problem of a solver that is kept between solves.
+	// The block structure is kept, so the next satisfy() resumes from the
+	// previous active set.  The caller must update the constraint list
+	// the solver was constructed with to match before calling satisfy().
+	void addConstraint(Constraint *c);
+	void removeConstraints(Constraints const &doomed);
 private:
 	Constraints inactive;
 	Constraints violated;
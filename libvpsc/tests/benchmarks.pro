@@ -0,0 +1,6 @@
+# Benchmarks for libvpsc.  Build with "qmake -config benchmarks".
+
+TEMPLATE = subdirs
+
+SUBDIRS = \
+    solver_benchmark.pro
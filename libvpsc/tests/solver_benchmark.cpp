@@ -0,0 +1,110 @@
+/*
+ * vim: ts=4 sw=4 et tw=0 wm=0
+ *
+ * libvpsc - A solver for the problem of Variable Placement with
+ *           Separation Constraints.
+ *
+ * Copyright (C) 2026  Dunnart contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library in the file LICENSE; if not,
+ * write to the Free Software Foundation, Inc., 59 Temple Place,
+ * Suite 330, Boston, MA  02111-1307  USA
+ *
+*/
+
+// Times solving a large separation constraint problem, either with
+// Solver or with IncSolver.  Each variable is separated from the next,
+// and from a few others a short distance further on, as for a row of
+// overlapping rectangles.  The checksum of the final positions lets
+// results be compared between versions of the solver.
+//
+// Usage: solver_benchmark [variables] [incremental] [extra constraints]
+//                         [spread]
+// Each variable gets the given number of extra constraints.  Desired
+// positions are drawn from [0, variables * spread).
+
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+#include "libvpsc/solve_VPSC.h"
+#include "libvpsc/variable.h"
+#include "libvpsc/constraint.h"
+using namespace vpsc;
+
+static double seconds(const clock_t start)
+{
+    return (double) (clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char **argv)
+{
+    const int n = (argc > 1) ? atoi(argv[1]) : 100000;
+    const bool incremental = (argc > 2) ? (atoi(argv[2]) != 0) : false;
+    const int extra = (argc > 3) ? atoi(argv[3]) : 2;
+    const int spread = (argc > 4) ? atoi(argv[4]) : 2;
+
+    srand(5);
+    Variables vs;
+    Constraints cs;
+    for (int i = 0; i < n; ++i)
+    {
+        vs.push_back(new Variable(i, rand() % (n * spread), 1 + rand() % 3));
+    }
+    for (int i = 0; i + 1 < n; ++i)
+    {
+        cs.push_back(new Constraint(vs[i], vs[i + 1], 1 + rand() % 3));
+        for (int e = 0; e < extra; ++e)
+        {
+            int j = i + 1 + rand() % 50;
+            if (j < n)
+            {
+                cs.push_back(new Constraint(vs[i], vs[j], rand() % 40));
+            }
+        }
+    }
+
+    clock_t start = clock();
+    if (incremental)
+    {
+        IncSolver solver(vs, cs);
+        solver.solve();
+    }
+    else
+    {
+        Solver solver(vs, cs);
+        solver.solve();
+    }
+    const double solveTime = seconds(start);
+
+    double checksum = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        checksum += vs[i]->finalPosition * ((i % 7) + 1);
+    }
+    printf("%d variables, %d constraints, %s solver\n", n, (int) cs.size(),
+            incremental ? "incremental" : "static");
+    printf("  solve: %8.3fs  checksum %.6f\n", solveTime, checksum);
+
+    for (Constraints::iterator c = cs.begin(); c != cs.end(); ++c)
+    {
+        delete *c;
+    }
+    for (Variables::iterator v = vs.begin(); v != vs.end(); ++v)
+    {
+        delete *v;
+    }
+    return 0;
+}
@@ -0,0 +1,4 @@
+TARGET = solver_benchmark
+include(tests.pri)
+
+SOURCES += solver_benchmark.cpp
@@ -0,0 +1,18 @@
+# Options shared by the libvpsc test and benchmark programs.
+
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+DEPENDPATH += ../.. .
+INCLUDEPATH += ../..
+include(../../common_options.qmake)
+CONFIG -= qt
+
+macx:!arcadia {
+LIBS += -L$$DUNNARTBASE/Dunnart.app/Contents/Frameworks
+} else {
+LIBS += -L$$DESTDIR
+}
+LIBS += -lvpsc
+
+DESTDIR = $$DUNNARTBASE/build/tests
@@ -26,26 +26,33 @@
 
 #include <QtGui>
 #include <QString>
-#include <QDomNode>
-#include <QDomAttr>
-#include <QDomNamedNodeMap>
+#include <QXmlStreamReader>
+#include <QXmlStreamAttributes>
 
-CDSpeciesAlias::CDSpeciesAlias(QDomNode node)
+CDSpeciesAlias::CDSpeciesAlias(QXmlStreamReader& reader) :
+    m_x(0),
+    m_y(0),
+    m_width(0),
+    m_height(0)
 {
-    QDomNamedNodeMap attrs = node.attributes();
-    QDomNode idNode = attrs.namedItem("id");
-    QDomAttr idAttr = idNode.toAttr();
-    m_id = idAttr.value();
+    QXmlStreamAttributes attrs = reader.attributes();
+    m_id = attrs.value("id").toString();
 
-    m_speciesName = attrs.namedItem("species").toAttr().value();
-    m_compartmentAlias = attrs.namedItem("compartmentAlias").toAttr().value();
+    m_speciesName = attrs.value("species").toString();
+    m_compartmentAlias = attrs.value("compartmentAlias").toString();
 
-    QDomNode bounds = node.namedItem("bounds");
-    QDomNamedNodeMap battrs = bounds.attributes();
-    m_x = battrs.namedItem("x").toAttr().value().toDouble();
-    m_y = battrs.namedItem("y").toAttr().value().toDouble();
-    m_width = battrs.namedItem("w").toAttr().value().toDouble();
-    m_height = battrs.namedItem("h").toAttr().value().toDouble();
+    while (reader.readNextStartElement())
+    {
+        if (reader.name() == "bounds")
+        {
+            QXmlStreamAttributes battrs = reader.attributes();
+            m_x = battrs.value("x").toString().toDouble();
+            m_y = battrs.value("y").toString().toDouble();
+            m_width = battrs.value("w").toString().toDouble();
+            m_height = battrs.value("h").toString().toDouble();
+        }
+        reader.skipCurrentElement();
+    }
 
     //m_x = battrs.namedItem("x").toAttr().value();
     //m_y = battrs.namedItem("y").toAttr().value();
@@ -53,7 +60,7 @@ CDSpeciesAlias::CDSpeciesAlias(QDomNode node)
     //m_height = battrs.namedItem("h").toAttr().value();
 
     qDebug() << toString();
-    //qDebug() << "found species alias with id " << idAttr.value();
+    //qDebug() << "found species alias with id " << m_id;
 }
 
 QString CDSpeciesAlias::toString()
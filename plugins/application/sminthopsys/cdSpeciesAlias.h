@@ -26,10 +26,13 @@
 #define CDSPECIESALIAS_H
 
 #include <QString>
-#include <QDomNode>
+
+class QXmlStreamReader;
 
 struct CDSpeciesAlias {
-    CDSpeciesAlias(QDomNode node);
+    // Reads the speciesAlias element at which reader is positioned,
+    // leaving it at the element's end.
+    CDSpeciesAlias(QXmlStreamReader& reader);
     QString toString(void);
 
     QString m_id;
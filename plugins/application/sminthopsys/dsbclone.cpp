@@ -306,12 +306,9 @@ QList<DSBReaction*> DSBClone::computeExitableReactions()
     return exitable.toList();
 }
 
-QList<DSBBranch*> DSBClone::findBranchesRec(
-        QList<QString>& seen, QList<QString> blacklist, bool forward, DSBNode *last)
+QList<DSBNode*> DSBClone::branchSuccessors(bool forward, DSBNode *last)
 {
-    seen.append(m_cloneId); // Mark self as seen.
-
-    QList<DSBBranch*> branches; // Prepare return value.
+    QList<DSBNode*> next; // Prepare return value.
 
     // Now consider all usable reactions.
     QList<DSBReaction*> usable =
@@ -328,24 +325,9 @@ QList<DSBBranch*> DSBClone::findBranchesRec(
             continue;
         }
 
-        // Consider whether this reaction has already been seen or not.
-        QString rid = reac->getReactionId();
-        if (seen.contains(rid))
-        {
-            // Reaction has already been seen, so we have found a cycle.
-            DSBBranch *b = new DSBBranch;
-            b->nodes.append(reac);
-            b->cycle = true;
-            branches.append(b);
-        }
-        else
-        {
-            // No cycle. Recurse.
-            QList<DSBBranch*> bb = reac->findBranchesRec(seen, blacklist, forward, this);
-            branches.append(bb);
-        }
+        next.append(reac);
     }
-    return mergeSelfWithBranches(branches, blacklist);
+    return next;
 }
 
 QList<DSBReaction*> DSBClone::getAllReactions()
@@ -357,20 +339,6 @@ QList<DSBReaction*> DSBClone::getAllReactions()
     return all;
 }
 
-void DSBClone::connectedComponent(QSet<DSBClone *> &ccClones, QSet<DSBReaction *> &ccReacs)
-{
-    ccClones.insert(this); // add self to component
-    // ignore reactions already seen
-    QSet<DSBReaction*> rset = getAllReactions().toSet().subtract(ccReacs);
-    // ask remaining ones to add to the connected component
-    foreach (DSBReaction *reac, rset)
-    {
-        // skip intercompartmental reactions
-        if (reac->isIntercompartmental()) { continue; }
-        reac->connectedComponent(ccClones, ccReacs);
-    }
-}
-
 }
 
 
@@ -66,8 +66,7 @@ public:
     QSizeF getSize();
     void acceptCanvasBaseAndRelPts(QPointF parentBasePt);
     QPointF getBasePt();
-    QList<DSBBranch*> findBranchesRec(
-            QList<QString>& seen, QList<QString> blacklist, bool forward, DSBNode *last);
+    QList<DSBNode*> branchSuccessors(bool forward, DSBNode *last);
     friend class DSBFork;
     friend class DSBSpecies;
     ShapeObj *getShape();
@@ -75,7 +74,6 @@ public:
     QRectF getBbox();
     DSBFork *getFork();
     void setFork(DSBFork *fork);
-    void connectedComponent(QSet<DSBClone*> &ccClones, QSet<DSBReaction*> &ccReacs);
     QList<Role> getAllRoles();
 
 private:
@@ -36,6 +36,9 @@
 #include <QApplication>
 #include <QTimer>
 #include <QThread>
+#include <QHash>
+#include <QVector>
+#include <QtConcurrentMap>
 
 #include <math.h>
 #include <assert.h>
@@ -108,6 +111,7 @@ QAction *CompShape2::buildAndExecContextMenu(QGraphicsSceneMouseEvent *event, QM
     // Add actions to menu.
     QAction *cloneCurrencyMolecules = menu.addAction(QObject::tr("Clone currency molecules"));
     QAction *showPathways = menu.addAction(QObject::tr("Show pathways"));
+    QAction *findAllPathways = menu.addAction(QObject::tr("Find all pathways"));
     //
 
     QAction *action = ShapeObj::buildAndExecContextMenu(event, menu);
@@ -122,6 +126,11 @@ QAction *CompShape2::buildAndExecContextMenu(QGraphicsSceneMouseEvent *event, QM
         m_compartment->buildConnectedPathways();
         m_compartment->redisplay();
     }
+    else if (action == findAllPathways)
+    {
+        m_compartment->findAllPathways(true);
+        m_compartment->redisplay();
+    }
     return action;
 }
 
@@ -225,6 +234,7 @@ QAction *CompartmentShape::buildAndExecContextMenu(QGraphicsSceneMouseEvent *eve
     // Add actions to menu.
     QAction *cloneCurrencyMolecules = menu.addAction(QObject::tr("Clone currency molecules"));
     QAction *showPathways = menu.addAction(QObject::tr("Show pathways"));
+    QAction *findAllPathways = menu.addAction(QObject::tr("Find all pathways"));
     //
 
 #ifndef CONTAINEDSHAPES
@@ -244,6 +254,11 @@ QAction *CompartmentShape::buildAndExecContextMenu(QGraphicsSceneMouseEvent *eve
         m_compartment->buildConnectedPathways();
         m_compartment->redisplay();
     }
+    else if (action == findAllPathways)
+    {
+        m_compartment->findAllPathways(true);
+        m_compartment->redisplay();
+    }
     return action;
 }
 
@@ -847,21 +862,213 @@ void DSBCompartment::dumpAllClonePositions()
     }
 }
 
+/* Find the connected components made up by the reactions and the current
+   clones, ignoring intercompartmental reactions. The clone-reaction graph
+   is indexed once into compact adjacency arrays, and then labelled in a
+   single breadth-first pass, so the work is linear in the size of the
+   network. Components are reported in the order of their first clone.
+  */
+void DSBCompartment::connectedComponents(
+        QList<QList<DSBClone*> > &ccClones, QList<QList<DSBReaction*> > &ccReacs)
+{
+    QList<DSBClone*> clones = getAllClones();
+    int numClones = clones.size();
+
+    // Number the reactions as they are met. Intercompartmental ones are
+    // recorded with index -1 so that they are tested only once.
+    QList<DSBReaction*> reacs;
+    QHash<DSBReaction*, int> reacIndex;
+    QVector<int> cloneStart(numClones + 1);
+    QVector<int> cloneReacs;
+    for (int i = 0; i < numClones; i++)
+    {
+        cloneStart[i] = cloneReacs.size();
+        foreach (DSBReaction *reac, clones.at(i)->getAllReactions())
+        {
+            QHash<DSBReaction*, int>::const_iterator it = reacIndex.find(reac);
+            int r;
+            if (it != reacIndex.end())
+            {
+                r = it.value();
+            }
+            else
+            {
+                r = reac->isIntercompartmental() ? -1 : reacs.size();
+                reacIndex.insert(reac, r);
+                if (r >= 0) { reacs.append(reac); }
+            }
+            if (r >= 0) { cloneReacs.append(r); }
+        }
+    }
+    cloneStart[numClones] = cloneReacs.size();
+
+    // Transpose to get the clones of each reaction.
+    int numReacs = reacs.size();
+    QVector<int> reacStart(numReacs + 1, 0);
+    for (int k = 0; k < cloneReacs.size(); k++)
+    {
+        reacStart[cloneReacs[k] + 1]++;
+    }
+    for (int r = 0; r < numReacs; r++)
+    {
+        reacStart[r + 1] += reacStart[r];
+    }
+    QVector<int> reacClones(cloneReacs.size());
+    QVector<int> fill(reacStart);
+    for (int i = 0; i < numClones; i++)
+    {
+        for (int k = cloneStart[i]; k < cloneStart[i + 1]; k++)
+        {
+            reacClones[fill[cloneReacs[k]]++] = i;
+        }
+    }
+
+    // Label the components.
+    QVector<bool> cloneSeen(numClones, false);
+    QVector<bool> reacSeen(numReacs, false);
+    QVector<int> queue;
+    queue.reserve(numClones);
+    for (int start = 0; start < numClones; start++)
+    {
+        if (cloneSeen[start]) { continue; }
+        QList<DSBClone*> compClones;
+        QList<DSBReaction*> compReacs;
+        queue.clear();
+        queue.append(start);
+        cloneSeen[start] = true;
+        for (int head = 0; head < queue.size(); head++)
+        {
+            int i = queue.at(head);
+            compClones.append(clones.at(i));
+            for (int k = cloneStart[i]; k < cloneStart[i + 1]; k++)
+            {
+                int r = cloneReacs[k];
+                if (reacSeen[r]) { continue; }
+                reacSeen[r] = true;
+                compReacs.append(reacs.at(r));
+                for (int m = reacStart[r]; m < reacStart[r + 1]; m++)
+                {
+                    int j = reacClones[m];
+                    if (!cloneSeen[j])
+                    {
+                        cloneSeen[j] = true;
+                        queue.append(j);
+                    }
+                }
+            }
+        }
+        ccClones.append(compClones);
+        ccReacs.append(compReacs);
+    }
+}
+
 /* Build one pathway (FreePathway class) for each connected component made
    up by the reactions and the current clones.
   */
 void DSBCompartment::buildConnectedPathways()
 {
-    QSet<DSBClone*> clones = getAllClones().toSet();
-    while (!clones.empty())
+    QList<QList<DSBClone*> > ccClones;
+    QList<QList<DSBReaction*> > ccReacs;
+    connectedComponents(ccClones, ccReacs);
+    for (int i = 0; i < ccClones.size(); i++)
     {
-        DSBClone *cl = clones.toList().first();
-        QSet<DSBClone*> ccClones; // connected component clones
-        QSet<DSBReaction*> ccReacs; // connected component reactions
-        cl->connectedComponent(ccClones, ccReacs);
-        FreePathway *pw = new FreePathway(ccClones.toList(), ccReacs.toList());
+        FreePathway *pw = new FreePathway(ccClones.at(i), ccReacs.at(i));
         m_pathways.append(pw);
-        clones.subtract(ccClones);
+    }
+}
+
+// A branch search from one endpoint, to be run alongside others.
+struct PathwaySearch
+{
+    DSBCompartment *compartment;
+    DSBClone *endpoint;
+    bool forward;
+    QList<QString> blacklist;
+    QList<DSBBranch*> branches;
+};
+
+static void runPathwaySearch(PathwaySearch &search)
+{
+    bool extended = true; // Throw away branches of length 1.
+    search.branches = search.endpoint->findBranches(
+            search.blacklist, search.forward, extended);
+}
+
+/* Build a branched pathway for every connected component of this
+   compartment and of all compartments inside it, without needing an
+   endpoint to be selected. Currency molecules are cloned first, as for
+   the Find Branches dialog. In each component the search starts from the
+   first clone that can be left in the search direction but not entered,
+   or failing that from the first clone that can be left at all.
+   Components that already belong to a branched pathway are left alone.
+
+   Components share no nodes, and the branch search only reads the
+   network, so the searches for all components run concurrently. The
+   pathways are then added on this thread.
+  */
+void DSBCompartment::findAllPathways(bool forward)
+{
+    QList<DSBCompartment*> comps;
+    comps.append(this);
+    for (int c = 0; c < comps.size(); c++)
+    {
+        comps.append(comps.at(c)->m_compartments);
+    }
+
+    QList<PathwaySearch> searches;
+    foreach (DSBCompartment *comp, comps)
+    {
+        comp->cloneCurrencyMolecules();
+
+        QList<QList<DSBClone*> > ccClones;
+        QList<QList<DSBReaction*> > ccReacs;
+        comp->connectedComponents(ccClones, ccReacs);
+        for (int i = 0; i < ccClones.size(); i++)
+        {
+            if (ccReacs.at(i).isEmpty()) { continue; }
+            // Skip components that already have a branched pathway, so
+            // that running this again does not add duplicates.
+            bool inPathway = false;
+            foreach (DSBClone *cl, ccClones.at(i))
+            {
+                if (cl->getPathway())
+                {
+                    inPathway = true;
+                    break;
+                }
+            }
+            if (inPathway) { continue; }
+
+            DSBClone *endpoint = NULL;
+            foreach (DSBClone *cl, ccClones.at(i))
+            {
+                if (cl->branchSuccessors(forward, NULL).isEmpty()) { continue; }
+                if (!endpoint) { endpoint = cl; }
+                if (cl->branchSuccessors(!forward, NULL).isEmpty())
+                {
+                    endpoint = cl;
+                    break;
+                }
+            }
+            if (!endpoint) { continue; }
+
+            PathwaySearch search;
+            search.compartment = comp;
+            search.endpoint = endpoint;
+            search.forward = forward;
+            search.blacklist = comp->m_default_blacklist;
+            searches.append(search);
+        }
+    }
+
+    QtConcurrent::blockingMap(searches, runPathwaySearch);
+
+    foreach (const PathwaySearch &search, searches)
+    {
+        if (search.branches.isEmpty()) { continue; }
+        DSBPathway *pathway = new DSBPathway(search.endpoint, search.branches);
+        pathway->setCanvas(search.compartment->m_canvas);
+        search.compartment->addPathway(pathway);
     }
 }
 
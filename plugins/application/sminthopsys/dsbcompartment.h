@@ -124,6 +124,7 @@ public:
     QList<DSBBranch*> findBranches(DSBClone *endpt, bool forward);
     QList<DSBBranch*> findBranches(DSBClone *endpt, bool forward, QList<QString> blacklist);
     void buildConnectedPathways(void);
+    void findAllPathways(bool forward);
     void setTrivialCloning(void);
     void setDiscreteCloningsByName(QList<QString> names);
     void cloneCurrencyMolecules(void);
@@ -173,6 +174,8 @@ private:
 
     QList<DSBClone*> getAllClones(void);
     QList<DSBClone*> getLooseClones(void);
+    void connectedComponents(QList<QList<DSBClone*> >& ccClones,
+                             QList<QList<DSBReaction*> >& ccReacs);
     QList<CanvasItem*> getAllShapes(void);
 
 
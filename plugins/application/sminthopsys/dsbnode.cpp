@@ -23,6 +23,7 @@
 */
 
 #include <QtGui>
+#include <QStack>
 
 #include <assert.h>
 
@@ -94,11 +95,65 @@ void DSBNode::addFork(DSBFork *fork)
 }
 #endif
 
+// One node on the path of the depth-first branch search.
+struct BranchSearchFrame
+{
+    BranchSearchFrame() : node(NULL), index(0) {}
+    BranchSearchFrame(DSBNode *n, QList<DSBNode*> s)
+        : node(n), next(s), index(0) {}
+    DSBNode *node;
+    QList<DSBNode*> next;      // Nodes the search may continue into.
+    int index;                 // The next one of those to visit.
+    QList<DSBBranch*> branches; // Branches found beyond this node so far.
+};
+
 QList<DSBBranch*> DSBNode::findBranches(
         QList<QString> blacklist, bool forward, bool extended)
 {
-    QList<QString> seen;
-    QList<DSBBranch*> branches = findBranchesRec(seen, blacklist, forward);
+    // Depth-first search from this node, run on an explicit stack so that
+    // long pathways cannot exhaust the call stack. The branches found
+    // beyond each node are merged with that node once all of its
+    // successors have been explored. Nodes already seen anywhere in the
+    // search end a branch as a cycle.
+    QSet<QString> blacknames = blacklist.toSet();
+    QSet<DSBNode*> seen;
+    QStack<BranchSearchFrame> stack;
+    QList<DSBBranch*> branches;
+
+    seen.insert(this);
+    stack.push(BranchSearchFrame(this, branchSuccessors(forward, NULL)));
+    while (!stack.isEmpty())
+    {
+        BranchSearchFrame& top = stack.top();
+        if (top.index < top.next.size())
+        {
+            DSBNode *node = top.next.at(top.index++);
+            if (seen.contains(node))
+            {
+                // Node has already been seen, so we have found a cycle.
+                DSBBranch *b = new DSBBranch;
+                b->nodes.append(node);
+                b->cycle = true;
+                top.branches.append(b);
+            }
+            else
+            {
+                // No cycle. Descend.
+                seen.insert(node);
+                QList<DSBNode*> next = node->branchSuccessors(forward, top.node);
+                stack.push(BranchSearchFrame(node, next));
+            }
+        }
+        else
+        {
+            QList<DSBBranch*> merged =
+                    top.node->mergeSelfWithBranches(top.branches, blacknames);
+            stack.pop();
+            if (stack.isEmpty()) { branches = merged; }
+            else { stack.top().branches.append(merged); }
+        }
+    }
+
     if (extended)
     {
         // Throw away branches of length 1.
@@ -114,7 +169,7 @@ QList<DSBBranch*> DSBNode::findBranches(
 }
 
 DSBBranch *DSBNode::findMergeTarget(
-        QList<DSBBranch *> branches, QList<QString> blacklist)
+        const QList<DSBBranch *>& branches, const QSet<QString>& blacklist)
 {
     // Will find longest linear branch, or, failing that, longest cycle.
 
@@ -216,7 +271,7 @@ DSBBranch *DSBNode::findMergeTarget(
 }
 
 QList<DSBBranch*> DSBNode::mergeSelfWithBranches(
-        QList<DSBBranch*> branches, QList<QString> blacklist)
+        QList<DSBBranch*> branches, const QSet<QString>& blacklist)
 {
     // Were there no branches?
     if (branches.isEmpty())
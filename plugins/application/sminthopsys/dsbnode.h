@@ -47,14 +47,14 @@ class DSBNode : public DSBRecLayout
 {
 public:
     DSBNode() : m_branch(NULL), m_pathway(NULL) {}
-    virtual QList<DSBBranch*> findBranchesRec(
-            QList<QString>& seen, QList<QString> blacklist,
-            bool forward, DSBNode *last = 0) = 0;
+    // The nodes into which a branch search may continue from this node,
+    // having arrived from node 'last'.
+    virtual QList<DSBNode*> branchSuccessors(bool forward, DSBNode *last) = 0;
 
     QList<DSBBranch*> findBranches(QList<QString> blacklist, bool forward, bool extended);
 
     QList<DSBBranch*> mergeSelfWithBranches(
-            QList<DSBBranch*> branches, QList<QString> blacklist);
+            QList<DSBBranch*> branches, const QSet<QString>& blacklist);
 
     void setBranchHeadNumber(int n);
     virtual ShapeObj *getShape() = 0;
@@ -65,7 +65,6 @@ public:
     DSBBranch *getBranch(void);
     void setPathway(DSBPathway *pw);
     DSBPathway *getPathway(void);
-    virtual void connectedComponent(QSet<DSBClone*> &ccClones, QSet<DSBReaction*> &ccReacs) = 0;
     bool isConnectedTo(DSBNode *other);
 #if 0
     void addBranch(DSBBranch *branch);
@@ -76,7 +75,7 @@ public:
 
 private:
     DSBBranch *findMergeTarget(
-            QList<DSBBranch*> branches, QList<QString> blacklist);
+            const QList<DSBBranch*>& branches, const QSet<QString>& blacklist);
     int m_branchHeadNumber;
 protected:
     DSBBranch *m_branch;
@@ -70,6 +70,54 @@ DSBReaction::DSBReaction(Reaction *reac) :
     {
         m_reversible = reac->getReversible(); // then accept the stated value.
     }
+
+    ListOfSpeciesReferences *lsr;
+    lsr = reac->getListOfReactants();
+    for (unsigned int i = 0; i < lsr->size(); i++)
+    {
+        addReactantId(QString(lsr->get(i)->getSpecies().c_str()));
+    }
+    lsr = reac->getListOfProducts();
+    for (unsigned int i = 0; i < lsr->size(); i++)
+    {
+        addProductId(QString(lsr->get(i)->getSpecies().c_str()));
+    }
+    lsr = reac->getListOfModifiers();
+    for (unsigned int i = 0; i < lsr->size(); i++)
+    {
+        addModifierId(QString(lsr->get(i)->getSpecies().c_str()));
+    }
+}
+
+DSBReaction::DSBReaction(QString id, QString name, QString compartmentName,
+                         bool reversible) :
+    DSBNode(),
+    m_sbmlReaction(NULL),
+    m_name(name),
+    m_id(id),
+    m_compartmentName(compartmentName),
+    m_canvas(NULL),
+    m_reversible(reversible),
+    m_compartment(NULL),
+    m_mainInput(NULL),
+    m_mainOutput(NULL),
+    m_shape(NULL),
+    shapeOnCanvas(false)
+{}
+
+void DSBReaction::addReactantId(QString specId)
+{
+    m_reactantIds.append(specId);
+}
+
+void DSBReaction::addProductId(QString specId)
+{
+    m_productIds.append(specId);
+}
+
+void DSBReaction::addModifierId(QString specId)
+{
+    m_modifierIds.append(specId);
 }
 
 void DSBReaction::setCompartment(DSBCompartment *comp)
@@ -156,18 +204,12 @@ bool DSBReaction::hasCloneAsInputOrOutput(DSBClone *cl)
   */
 void DSBReaction::doublyLink(QMap<QString, DSBSpecies*> map)
 {
-    ListOfSpeciesReferences *lsr;
-    SimpleSpeciesReference *ssr;
-    unsigned int N;
     QString specId;
 
     // "reactants", or inputs
-    lsr = m_sbmlReaction->getListOfReactants();
-    N = lsr->size();
-    for (unsigned int i = 0; i < N; i++)
+    for (int i = 0; i < m_reactantIds.size(); i++)
     {
-        ssr = lsr->get(i);
-        specId = QString(ssr->getSpecies().c_str());
+        specId = m_reactantIds.at(i);
         if (!map.contains(specId))
         {
             // TODO: Report error. Reaction is referring to a species that
@@ -183,12 +225,9 @@ void DSBReaction::doublyLink(QMap<QString, DSBSpecies*> map)
     }
 
     // "products", or outputs
-    lsr = m_sbmlReaction->getListOfProducts();
-    N = lsr->size();
-    for (unsigned int i = 0; i < N; i++)
+    for (int i = 0; i < m_productIds.size(); i++)
     {
-        ssr = lsr->get(i);
-        specId = QString(ssr->getSpecies().c_str());
+        specId = m_productIds.at(i);
         if (!map.contains(specId))
         {
             // TODO: Report error. Reaction is referring to a species that
@@ -204,12 +243,9 @@ void DSBReaction::doublyLink(QMap<QString, DSBSpecies*> map)
     }
 
     // modifiers (e.g. catalysts)
-    lsr = m_sbmlReaction->getListOfModifiers();
-    N = lsr->size();
-    for (unsigned int i = 0; i < N; i++)
+    for (int i = 0; i < m_modifierIds.size(); i++)
     {
-        ssr = lsr->get(i);
-        specId = QString(ssr->getSpecies().c_str());
+        specId = m_modifierIds.at(i);
         if (!map.contains(specId))
         {
             // TODO: Report error. Reaction is referring to a species that
@@ -274,12 +310,11 @@ QList<DSBClone*> DSBReaction::getOpposedClones(DSBClone *clone)
     return opp;
 }
 
-QList<DSBBranch*> DSBReaction::findBranchesRec(
-        QList<QString>& seen, QList<QString> blacklist, bool forward, DSBNode *last)
+QList<DSBNode*> DSBReaction::branchSuccessors(bool forward, DSBNode *last)
 {
-    seen.append(m_id); // Mark self as seen.
+    Q_UNUSED(forward);
 
-    QList<DSBBranch*> branches; // Prepare return value.
+    QList<DSBNode*> next; // Prepare return value.
 
     // Check which side of this reaction the last node 'last' lies on.
     // Then only consider flowing out on opposite side.
@@ -293,26 +328,9 @@ QList<DSBBranch*> DSBReaction::findBranchesRec(
         // Do not turn around and go backwards.
         if (cl == last) {continue;}
 
-        // Consider whether this clone has already been seen or not.
-        QString cid = cl->getCloneId();
-
-        if (seen.contains(cid))
-        {
-            // Clone has already been seen, so we have found a cycle.
-            DSBBranch *b = new DSBBranch;
-            b->nodes.append(cl);
-            b->cycle = true;
-            branches.append(b);
-        }
-        else
-        {
-            // No cycle. Recurse.
-            QList<DSBBranch*> bb = cl->findBranchesRec(seen, blacklist, forward, this);
-            branches.append(bb);
-        }
+        next.append(cl);
     }
-
-    return mergeSelfWithBranches(branches, blacklist);
+    return next;
 }
 
 void DSBReaction::buildOrbit()
@@ -628,18 +646,6 @@ void DSBReaction::moveShape(qreal dx, qreal dy)
     }
 }
 
-void DSBReaction::connectedComponent(QSet<DSBClone *> &ccClones, QSet<DSBReaction *> &ccReacs)
-{
-    ccReacs.insert(this); // add self to component
-    // ignore clones already seen
-    QSet<DSBClone*> cset = getAllClones().toSet().subtract(ccClones);
-    // ask remaining ones to add to the connected component
-    foreach (DSBClone *cl, cset)
-    {
-        cl->connectedComponent(ccClones, ccReacs);
-    }
-}
-
 }
 
 
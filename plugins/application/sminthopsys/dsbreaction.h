@@ -52,6 +52,8 @@ public:
     // Constructors
     DSBReaction();
     DSBReaction(Reaction *reac);
+    DSBReaction(QString id, QString name, QString compartmentName,
+                bool reversible);
     // Get and set
     QString getCompartmentName();
     void setCanvas(Canvas *canvas);
@@ -72,9 +74,11 @@ public:
     QSizeF getSize();
     void acceptCanvasBaseAndRelPts(QPointF parentBasePt);
     // other
+    void addReactantId(QString specId);
+    void addProductId(QString specId);
+    void addModifierId(QString specId);
     void doublyLink(QMap<QString,DSBSpecies*> map);
-    QList<DSBBranch*> findBranchesRec(
-            QList<QString>& seen, QList<QString> blacklist, bool forward, DSBNode *last);
+    QList<DSBNode*> branchSuccessors(bool forward, DSBNode *last);
     void addInputBranchHead(DSBClone *head);
     void addOutputBranchHead(DSBClone *head);
     void setMainInput(DSBClone *mi);
@@ -85,7 +89,6 @@ public:
     QPointF getBasePt();
     QRectF getBbox();
     void connectTo(DSBClone *cl);
-    void connectedComponent(QSet<DSBClone*> &ccClones, QSet<DSBReaction*> &ccReacs);
     void clearConnectors(void);
     void buildOrbit();
     QList<DSBClone*> getAllSatellites();
@@ -101,6 +104,10 @@ private:
     QList<DSBSpecies*> m_inputs;
     QList<DSBSpecies*> m_outputs;
     QList<DSBSpecies*> m_modifiers;
+    // Ids of the species referred to, until doublyLink is called.
+    QList<QString> m_reactantIds;
+    QList<QString> m_productIds;
+    QList<QString> m_modifierIds;
 
     QList<DSBClone*> m_inputBranchHeads;
     QList<DSBClone*> m_outputBranchHeads;
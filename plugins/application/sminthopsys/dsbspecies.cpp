@@ -45,6 +45,14 @@ DSBSpecies::DSBSpecies(Species *spec) :
     m_compartmentName = QString(spec->getCompartment().c_str());
 }
 
+DSBSpecies::DSBSpecies(QString id, QString name, QString compartmentName) :
+    m_nextCloneId(0),
+    m_sbmlSpecies(NULL),
+    m_name(name),
+    m_id(id),
+    m_compartmentName(compartmentName)
+{}
+
 void DSBSpecies::setCanvas(Canvas *canvas)
 {
     m_canvas = canvas;
@@ -60,6 +60,7 @@ class DSBSpecies
 public:
     DSBSpecies();
     DSBSpecies(Species *spec);
+    DSBSpecies(QString id, QString name, QString compartmentName);
     QString getName();
     QString getId();
     QString getCompartmentName();
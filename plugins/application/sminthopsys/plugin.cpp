@@ -30,7 +30,6 @@
 #include <QtGui>
 #include <QtCore>
 #include <QFileInfo>
-#include <QDomDocument>
 #include <QSvgGenerator>
 #include <QMap>
 #include <QList>
@@ -39,8 +38,6 @@
 #include <sstream>
 #include <math.h>
 
-#include "sbml/SBMLTypes.h"
-
 #include "libdunnartcanvas/applicationplugininterface.h"
 #include "libdunnartcanvas/canvas.h"
 #include "libdunnartcanvas/canvasitem.h"
@@ -56,6 +53,7 @@
 #include "dsbcompartment.h"
 #include "findBranchesDialog.h"
 #include "cdSpeciesAlias.h"
+#include "sbmlstreamreader.h"
 
 using namespace dunnart;
 
@@ -229,74 +227,10 @@ class SminthopsysPlugin : public QObject, public ApplicationPluginInterface,
             // TODO
             return false;
         }
-        // TODO: If not using this method, then delete it:
-        static QString nodeToString(const QDomNode& node)
-        {
-            QString nodeString;
-            QTextStream nodeTextStream(&nodeString);
-            node.save(nodeTextStream, 4);
-
-            return nodeString;
-        }
-
-        /**
-         * Returns first child of parent whose tag is as given.
-         * Returns parent itself if no such child is found.
-         */
-        QDomNode getFirstChildOfTag(QDomNode parent, QString tag)
-        {
-            QDomNode first = parent;
-            QDomNode node = parent.firstChild();
-            while (!node.isNull()) {
-                QString t = node.nodeName();
-                if (t==tag) {
-                    first = node; break;
-                }
-                node = node.nextSibling();
-            }
-            return first;
-        }
-
-        QList<CDSpeciesAlias*> buildSpeciesAliases(QDomNode listOfSpeciesAliases)
-        {
-            QList<CDSpeciesAlias*> sas;
-            QDomNode sa = listOfSpeciesAliases.firstChild();
-            while (!sa.isNull()) {
-                CDSpeciesAlias *cdsa = new CDSpeciesAlias(sa);
-                sas.append(cdsa);
-                sa = sa.nextSibling();
-            }
-            return sas;
-        }
-
-        QList<QDomNode> getTopLevelAnnotations(QDomNode node)
-        {
-            QList<QDomNode> tlas;
-            qDebug() << "writing all top-level tags";
-            node = node.firstChild();
-            while (!node.isNull()) {
-                //node = node.firstChild();
-                QString tag = node.nodeName();
-                qDebug() << tag;
-                if (tag == "annotation") {
-                    tlas.append(node);
-                }
-                node = node.nextSibling();
-            }
-            qDebug() << "done writing all top-level tags";
-            return tlas;
-        }
-
         bool loadDiagramFromFile(Canvas *canvas, const QFileInfo& fileInfo,
                 QString& errorMessage)
         {
             QString filename = fileInfo.absoluteFilePath();
-            SBMLDocument *doc = readSBML(filename.toStdString().c_str());
-
-            // %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-            // Let's try to parse it as generic xml, so we can get the
-            // CellDesigner annotation tags, if they are present.
-            QDomDocument dom(filename);
             QFile file(filename);
 
             if (!file.open(QIODevice::ReadOnly))
@@ -305,54 +239,25 @@ class SminthopsysPlugin : public QObject, public ApplicationPluginInterface,
                 return false;
             }
 
-            QString parsingError;
-            int errorLine;
-            int errorColumn;
-            if (!dom.setContent(&file, true, &parsingError, &errorLine, &errorColumn))
-            {
-                file.close();
-                errorMessage = tr("Error reading SVG: %1:%2: %3").arg(errorLine).
-                        arg(errorColumn).arg(parsingError);
-                return false;
-            }
+            // Read the species, reactions and any CellDesigner species
+            // aliases in a single pass, showing progress for large files.
+            QProgressDialog progressDialog(
+                    tr("Loading %1...").arg(fileInfo.fileName()),
+                    QString(), 0, 100);
+            progressDialog.setWindowModality(Qt::WindowModal);
+            SBMLStreamReader reader;
+            connect(&reader, SIGNAL(progress(int)),
+                    &progressDialog, SLOT(setValue(int)));
+            bool readOkay = reader.read(&file);
             file.close();
-
-            QDomElement sbmlTag = dom.documentElement();
-            QDomNode modelTag = sbmlTag.firstChild();
-            //QDomNode cdAnno = getFirstChildOfTag(modelTag, "annotation");
-            QDomNode cdAnno = modelTag.namedItem("annotation");
-            //QList<QDomNode> tlas = getTopLevelAnnotations(modelTag);
-
-            //QDomNode losa = getFirstChildOfTag(cdAnno, "celldesigner:listOfSpeciesAliases");
-            QDomNode losa = cdAnno.namedItem("listOfSpeciesAliases");
-
-            //qDebug() << losa.nodeName();
-            QList<CDSpeciesAlias*> cdsas = buildSpeciesAliases(losa);
-
-            //qDebug() << "Found " << tlas.length() << " top-level annotations.";
-            //getTopLevelAnnotations(tlas.at(0));
-
-
-            // %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-
-
-            // Check for errors.
-            unsigned int errors = doc->getNumErrors();
-            if (errors > 0)
+            if (!readOkay)
             {
-                std::stringstream ss;
-                ss << "Error reading SBML.\n";
-                doc->printErrors(ss);
-                errorMessage = QString(ss.str().c_str());
+                errorMessage = tr("Error reading SBML: %1").
+                        arg(reader.errorString());
                 return false;
             }
 
-            // Get the species and reactions.
-            Model *model = doc->getModel();
-            ListOfSpecies *los = model->getListOfSpecies();
-            unsigned int numSpecies = los->size();
-            Species *spec;
-            std::string id;
+            QList<CDSpeciesAlias*> cdsas = reader.speciesAliases();
 
             // Build a map from species id's to internal objects representing those species.
             QMap<QString, DSBSpecies*> speciesMap;
@@ -363,15 +268,12 @@ class SminthopsysPlugin : public QObject, public ApplicationPluginInterface,
             QList<DSBSpecies*> homelessSpecies;
             QList<DSBReaction*> homelessReacs;
 
-            for (unsigned int i = 0; i < numSpecies; i++)
+            foreach (DSBSpecies *dsbspec, reader.species())
             {
-                spec = los->get(i);
-                id = spec->getId();
-                DSBSpecies *dsbspec = new DSBSpecies(spec);
                 dsbspec->setCanvas(canvas);
 
                 // Save it in the species map.
-                speciesMap.insert(QString(id.c_str()), dsbspec);
+                speciesMap.insert(dsbspec->getId(), dsbspec);
 
                 // Get compartment name.
                 QString compName = dsbspec->getCompartmentName();
@@ -399,15 +301,9 @@ class SminthopsysPlugin : public QObject, public ApplicationPluginInterface,
                 }
             }
 
-            // Now get the reactions.
-            ListOfReactions *lor = model->getListOfReactions();
-            unsigned int numReacs = lor->size();
-            Reaction *reac;
-            for (unsigned int i = 0; i < numReacs; i++)
+            // Now link up the reactions.
+            foreach (DSBReaction *dsbreac, reader.reactions())
             {
-                reac = lor->get(i);
-                id = reac->getId();
-                DSBReaction *dsbreac = new DSBReaction(reac);
                 dsbreac->doublyLink(speciesMap);
                 dsbreac->setCanvas(canvas);
 
@@ -0,0 +1,274 @@
+/*
+ * Sminthopsys - Dunnart Systems Biology plugin
+ *
+ * Copyright (C) 2026  Dunnart contributors
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+*/
+
+#include <QtCore>
+
+#include "sbmlstreamreader.h"
+#include "dsbspecies.h"
+#include "dsbreaction.h"
+#include "cdSpeciesAlias.h"
+
+namespace dunnart {
+
+SBMLStreamReader::SBMLStreamReader(QObject *parent) :
+    QObject(parent),
+    m_device(NULL),
+    m_percent(-1)
+{}
+
+/* Reads the model from device.  On failure any objects built so far are
+   deleted, and errorString() describes the problem.
+  */
+bool SBMLStreamReader::read(QIODevice *device)
+{
+    // Objects from any earlier read now belong to the caller.
+    m_species.clear();
+    m_reactions.clear();
+    m_speciesAliases.clear();
+    m_device = device;
+    m_percent = -1;
+    m_reader.setDevice(device);
+
+    bool foundModel = false;
+    if (m_reader.readNextStartElement())
+    {
+        if (m_reader.name() != "sbml")
+        {
+            m_reader.raiseError(tr("The file is not an SBML file."));
+        }
+        while (!m_reader.hasError() && m_reader.readNextStartElement())
+        {
+            if (m_reader.name() == "model")
+            {
+                readModel();
+                foundModel = true;
+            }
+            else
+            {
+                m_reader.skipCurrentElement();
+            }
+        }
+    }
+    if (!m_reader.hasError() && !foundModel)
+    {
+        m_reader.raiseError(tr("The SBML file contains no model."));
+    }
+
+    if (m_reader.hasError())
+    {
+        deleteObjects();
+        return false;
+    }
+    emit progress(100);
+    return true;
+}
+
+QString SBMLStreamReader::errorString(void) const
+{
+    return tr("%1:%2: %3").arg(m_reader.lineNumber()).
+            arg(m_reader.columnNumber()).arg(m_reader.errorString());
+}
+
+QList<DSBSpecies*> SBMLStreamReader::species(void) const
+{
+    return m_species;
+}
+
+QList<DSBReaction*> SBMLStreamReader::reactions(void) const
+{
+    return m_reactions;
+}
+
+QList<CDSpeciesAlias*> SBMLStreamReader::speciesAliases(void) const
+{
+    return m_speciesAliases;
+}
+
+void SBMLStreamReader::readModel(void)
+{
+    while (m_reader.readNextStartElement())
+    {
+        if (m_reader.name() == "annotation")
+        {
+            readAnnotation();
+        }
+        else if (m_reader.name() == "listOfSpecies")
+        {
+            readListOfSpecies();
+        }
+        else if (m_reader.name() == "listOfReactions")
+        {
+            readListOfReactions();
+        }
+        else
+        {
+            m_reader.skipCurrentElement();
+        }
+    }
+}
+
+/* Looks for the CellDesigner listOfSpeciesAliases anywhere within the
+   model annotation (CellDesigner puts it inside its extension tag).
+  */
+void SBMLStreamReader::readAnnotation(void)
+{
+    while (m_reader.readNextStartElement())
+    {
+        if (m_reader.name() == "listOfSpeciesAliases")
+        {
+            while (m_reader.readNextStartElement())
+            {
+                if (m_reader.name() == "speciesAlias")
+                {
+                    m_speciesAliases.append(new CDSpeciesAlias(m_reader));
+                    reportProgress();
+                }
+                else
+                {
+                    m_reader.skipCurrentElement();
+                }
+            }
+        }
+        else
+        {
+            readAnnotation();
+        }
+    }
+}
+
+void SBMLStreamReader::readListOfSpecies(void)
+{
+    while (m_reader.readNextStartElement())
+    {
+        // Level 1 version 1 calls them "specie".
+        if (m_reader.name() == "species" || m_reader.name() == "specie")
+        {
+            QXmlStreamAttributes attrs = m_reader.attributes();
+            m_species.append(new DSBSpecies(attrs.value("id").toString(),
+                    attrs.value("name").toString(),
+                    attrs.value("compartment").toString()));
+            reportProgress();
+        }
+        m_reader.skipCurrentElement();
+    }
+}
+
+void SBMLStreamReader::readListOfReactions(void)
+{
+    while (m_reader.readNextStartElement())
+    {
+        if (m_reader.name() == "reaction")
+        {
+            readReaction();
+            reportProgress();
+        }
+        else
+        {
+            m_reader.skipCurrentElement();
+        }
+    }
+}
+
+void SBMLStreamReader::readReaction(void)
+{
+    QXmlStreamAttributes attrs = m_reader.attributes();
+    // Default to not reversible, unless reversibility has been stated.
+    QStringRef reversible = attrs.value("reversible");
+    DSBReaction *reac = new DSBReaction(attrs.value("id").toString(),
+            attrs.value("name").toString(),
+            attrs.value("compartment").toString(),
+            reversible == "true" || reversible == "1");
+    m_reactions.append(reac);
+
+    while (m_reader.readNextStartElement())
+    {
+        if (m_reader.name() == "listOfReactants" ||
+            m_reader.name() == "listOfProducts" ||
+            m_reader.name() == "listOfModifiers")
+        {
+            readSpeciesReferences(reac);
+        }
+        else
+        {
+            m_reader.skipCurrentElement();
+        }
+    }
+}
+
+void SBMLStreamReader::readSpeciesReferences(DSBReaction *reac)
+{
+    QString list = m_reader.name().toString();
+    while (m_reader.readNextStartElement())
+    {
+        QString specId = speciesAttribute();
+        if (list == "listOfReactants")
+        {
+            reac->addReactantId(specId);
+        }
+        else if (list == "listOfProducts")
+        {
+            reac->addProductId(specId);
+        }
+        else
+        {
+            reac->addModifierId(specId);
+        }
+        m_reader.skipCurrentElement();
+    }
+}
+
+QString SBMLStreamReader::speciesAttribute(void)
+{
+    QXmlStreamAttributes attrs = m_reader.attributes();
+    if (attrs.hasAttribute("species"))
+    {
+        return attrs.value("species").toString();
+    }
+    // Level 1 version 1 name.
+    return attrs.value("specie").toString();
+}
+
+void SBMLStreamReader::reportProgress(void)
+{
+    qint64 size = m_device->size();
+    if (m_device->isSequential() || size <= 0)
+    {
+        return;
+    }
+    int percent = (int) qMin((qint64) 100, 100 * m_device->pos() / size);
+    if (percent != m_percent)
+    {
+        m_percent = percent;
+        emit progress(percent);
+    }
+}
+
+void SBMLStreamReader::deleteObjects(void)
+{
+    qDeleteAll(m_species);
+    qDeleteAll(m_reactions);
+    qDeleteAll(m_speciesAliases);
+    m_species.clear();
+    m_reactions.clear();
+    m_speciesAliases.clear();
+}
+
+}
@@ -0,0 +1,81 @@
+/*
+ * Sminthopsys - Dunnart Systems Biology plugin
+ *
+ * Copyright (C) 2026  Dunnart contributors
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+*/
+
+#ifndef SBMLSTREAMREADER_H
+#define SBMLSTREAMREADER_H
+
+#include <QObject>
+#include <QString>
+#include <QList>
+#include <QXmlStreamReader>
+
+class QIODevice;
+struct CDSpeciesAlias;
+
+namespace dunnart {
+
+class DSBSpecies;
+class DSBReaction;
+
+//! @brief  Reads the species and reactions of an SBML model, along with
+//! any CellDesigner species aliases, in a single streaming pass.
+//!
+//! Only the parts of the file that are needed are examined, and nothing
+//! is kept in memory besides the objects built.  The caller takes
+//! ownership of the species, reactions and aliases once read() succeeds.
+class SBMLStreamReader : public QObject
+{
+    Q_OBJECT
+
+public:
+    SBMLStreamReader(QObject *parent = 0);
+    bool read(QIODevice *device);
+    QString errorString(void) const;
+    QList<DSBSpecies*> species(void) const;
+    QList<DSBReaction*> reactions(void) const;
+    QList<CDSpeciesAlias*> speciesAliases(void) const;
+
+signals:
+    //! Emitted as the file is read, with the percentage read so far.
+    void progress(int percent);
+
+private:
+    void readModel(void);
+    void readAnnotation(void);
+    void readListOfSpecies(void);
+    void readListOfReactions(void);
+    void readReaction(void);
+    void readSpeciesReferences(DSBReaction *reac);
+    QString speciesAttribute(void);
+    void reportProgress(void);
+    void deleteObjects(void);
+
+    QXmlStreamReader m_reader;
+    QIODevice *m_device;
+    int m_percent;
+    QList<DSBSpecies*> m_species;
+    QList<DSBReaction*> m_reactions;
+    QList<CDSpeciesAlias*> m_speciesAliases;
+};
+
+}
+
+#endif // SBMLSTREAMREADER_H
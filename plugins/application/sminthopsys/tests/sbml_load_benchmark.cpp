@@ -0,0 +1,261 @@
+/*
+ * Sminthopsys - Dunnart Systems Biology plugin
+ *
+ * Copyright (C) 2026  Dunnart contributors
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+*/
+
+// Times loading an SBML model the way the plugin does, with a single 
+// SBMLStreamReader pass, against the previous approach of reading it 
+// with libsbml and then again into a QDomDocument to find the 
+// CellDesigner species aliases.
+//
+// Usage: sbml_load_benchmark [species] [reactions] [repeats]
+//        sbml_load_benchmark file.sbml [repeats]
+// Without a file, a CellDesigner-style model of the given size is 
+// generated.
+
+#include <QtCore>
+#include <QDomDocument>
+#include <cstdio>
+#include <cstdlib>
+
+#include "sbml/SBMLTypes.h"
+
+#include "sbmlstreamreader.h"
+#include "dsbspecies.h"
+#include "dsbreaction.h"
+#include "cdSpeciesAlias.h"
+
+using namespace dunnart;
+
+// The species aliases are logged as they are read, which would dominate
+// the timings.
+static void quietMessages(QtMsgType type, const char *msg)
+{
+    if (type != QtDebugMsg)
+    {
+        fprintf(stderr, "%s\n", msg);
+    }
+}
+
+static void writeModel(QIODevice *device, const int species, 
+        const int reactions)
+{
+    QXmlStreamWriter w(device);
+    w.setAutoFormatting(true);
+    w.writeStartDocument();
+    w.writeStartElement("sbml");
+    w.writeDefaultNamespace("http://www.sbml.org/sbml/level2/version4");
+    w.writeAttribute("level", "2");
+    w.writeAttribute("version", "4");
+    w.writeStartElement("model");
+    w.writeAttribute("id", "benchmark");
+
+    const QString cd("http://www.sbml.org/2001/ns/celldesigner");
+    w.writeStartElement("annotation");
+    w.writeNamespace(cd, "celldesigner");
+    w.writeStartElement(cd, "extension");
+    w.writeStartElement(cd, "listOfSpeciesAliases");
+    for (int i = 0; i < species; ++i)
+    {
+        w.writeStartElement(cd, "speciesAlias");
+        w.writeAttribute("id", QString("sa%1").arg(i));
+        w.writeAttribute("species", QString("s%1").arg(i));
+        w.writeStartElement(cd, "bounds");
+        w.writeAttribute("x", QString::number((i % 100) * 90));
+        w.writeAttribute("y", QString::number((i / 100) * 50));
+        w.writeAttribute("w", "80");
+        w.writeAttribute("h", "40");
+        w.writeEndElement();
+        w.writeEndElement();
+    }
+    w.writeEndElement();
+    w.writeEndElement();
+    w.writeEndElement();
+
+    w.writeStartElement("listOfCompartments");
+    w.writeStartElement("compartment");
+    w.writeAttribute("id", "cell");
+    w.writeEndElement();
+    w.writeEndElement();
+
+    w.writeStartElement("listOfSpecies");
+    for (int i = 0; i < species; ++i)
+    {
+        w.writeStartElement("species");
+        w.writeAttribute("id", QString("s%1").arg(i));
+        w.writeAttribute("name", QString("Species %1").arg(i));
+        w.writeAttribute("compartment", "cell");
+        w.writeStartElement("notes");
+        w.writeStartElement("p");
+        w.writeDefaultNamespace("http://www.w3.org/1999/xhtml");
+        w.writeCharacters("A note that the reader skips.");
+        w.writeEndElement();
+        w.writeEndElement();
+        w.writeEndElement();
+    }
+    w.writeEndElement();
+
+    w.writeStartElement("listOfReactions");
+    qsrand(1);
+    for (int i = 0; i < reactions; ++i)
+    {
+        w.writeStartElement("reaction");
+        w.writeAttribute("id", QString("r%1").arg(i));
+        w.writeAttribute("reversible", (i % 2) ? "true" : "false");
+        const char *lists[] = 
+                { "listOfReactants", "listOfProducts", "listOfModifiers" };
+        const char *elements[] = { "speciesReference", "speciesReference",
+                "modifierSpeciesReference" };
+        for (int l = 0; l < 3; ++l)
+        {
+            w.writeStartElement(lists[l]);
+            for (int k = (l == 2) ? 1 : 0; k < 2; ++k)
+            {
+                w.writeStartElement(elements[l]);
+                w.writeAttribute("species", 
+                        QString("s%1").arg(qrand() % species));
+                w.writeEndElement();
+            }
+            w.writeEndElement();
+        }
+        w.writeStartElement("kineticLaw");
+        w.writeStartElement("math");
+        w.writeDefaultNamespace("http://www.w3.org/1998/Math/MathML");
+        w.writeStartElement("ci");
+        w.writeCharacters("k1");
+        w.writeEndElement();
+        w.writeEndElement();
+        w.writeEndElement();
+        w.writeEndElement();
+    }
+    w.writeEndElement();
+
+    w.writeEndElement();
+    w.writeEndElement();
+    w.writeEndDocument();
+}
+
+static bool streamRead(const QString& fileName, int& objects)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+    SBMLStreamReader reader;
+    if (!reader.read(&file))
+    {
+        fprintf(stderr, "%s\n", qPrintable(reader.errorString()));
+        return false;
+    }
+    objects = reader.species().size() + reader.reactions().size() +
+            reader.speciesAliases().size();
+    qDeleteAll(reader.species());
+    qDeleteAll(reader.reactions());
+    qDeleteAll(reader.speciesAliases());
+    return true;
+}
+
+static bool twoPassRead(const QString& fileName, int& objects)
+{
+    SBMLDocument *doc = readSBML(fileName.toStdString().c_str());
+    Model *model = doc->getModel();
+    if (!model)
+    {
+        delete doc;
+        return false;
+    }
+    objects = model->getNumSpecies() + model->getNumReactions();
+
+    QFile file(fileName);
+    QDomDocument dom(fileName);
+    if (!file.open(QIODevice::ReadOnly) || !dom.setContent(&file, true))
+    {
+        delete doc;
+        return false;
+    }
+    QDomNodeList aliases = dom.elementsByTagNameNS(
+            "http://www.sbml.org/2001/ns/celldesigner", "speciesAlias");
+    objects += aliases.size();
+    delete doc;
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+    qInstallMsgHandler(quietMessages);
+
+    QString fileName;
+    QTemporaryFile generated;
+    int repeats = 3;
+    if (argc > 1 && QFile::exists(argv[1]))
+    {
+        fileName = argv[1];
+        repeats = (argc > 2) ? atoi(argv[2]) : repeats;
+    }
+    else
+    {
+        const int species = (argc > 1) ? atoi(argv[1]) : 20000;
+        const int reactions = (argc > 2) ? atoi(argv[2]) : 20000;
+        repeats = (argc > 3) ? atoi(argv[3]) : repeats;
+        if (species < 1 || !generated.open())
+        {
+            fprintf(stderr, "Could not generate a model.\n");
+            return 1;
+        }
+        writeModel(&generated, species, reactions);
+        generated.close();
+        fileName = generated.fileName();
+        printf("generated model: %d species, %d reactions\n", species,
+                reactions);
+    }
+    printf("%s: %lld bytes, %d repeats\n", qPrintable(fileName),
+            QFileInfo(fileName).size(), repeats);
+
+    int streamObjects = 0, twoPassObjects = 0;
+    QTime timer;
+    timer.start();
+    for (int rep = 0; rep < repeats; ++rep)
+    {
+        if (!streamRead(fileName, streamObjects))
+        {
+            fprintf(stderr, "SBMLStreamReader failed.\n");
+            return 1;
+        }
+    }
+    const int streamMs = timer.elapsed();
+
+    timer.start();
+    for (int rep = 0; rep < repeats; ++rep)
+    {
+        if (!twoPassRead(fileName, twoPassObjects))
+        {
+            fprintf(stderr, "libsbml and QDomDocument failed.\n");
+            return 1;
+        }
+    }
+    const int twoPassMs = timer.elapsed();
+
+    printf("  SBMLStreamReader:       %8.3fs (%d objects)\n", 
+            streamMs / 1000.0, streamObjects);
+    printf("  libsbml + QDomDocument: %8.3fs (%d objects)\n", 
+            twoPassMs / 1000.0, twoPassObjects);
+    return 0;
+}
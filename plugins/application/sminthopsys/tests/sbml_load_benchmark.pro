@@ -0,0 +1,52 @@
+# Times loading SBML models.  Build with "qmake -config benchmarks".
+
+QT           += xml svg
+TEMPLATE      = app
+CONFIG       += console link_pkgconfig
+CONFIG       -= app_bundle
+
+TARGET        = sbml_load_benchmark
+
+DEPENDPATH += .. ../../../.. ../../../../libogdf
+INCLUDEPATH += .. ../../../.. ../../../../libogdf
+
+include(../../../../common_options.qmake)
+include(../../application_plugin_options.pri)
+
+PKGCONFIG += libsbml
+
+DESTDIR = $$DUNNARTBASE/build/tests
+
+# The plugin's model classes, without its plugin interface.
+HEADERS += ../findBranchesDialog.h \
+           ../pdepn.h \
+           ../pdcomplexepn.h \
+           ../pdphenotypeprocessnode.h \
+           ../pdlogicaloperators.h \
+           ../pdprocessnode.h \
+           ../sbmlstreamreader.h
+
+SOURCES += sbml_load_benchmark.cpp \
+           ../findBranchesDialog.cpp \
+           ../freepathway.cpp \
+           ../dsbpathway.cpp \
+           ../dsbbranch.cpp \
+           ../dsbfork.cpp \
+           ../dsbnode.cpp \
+           ../dsbspecies.cpp \
+           ../dsbreaction.cpp \
+           ../dsbcompartment.cpp \
+           ../dsbclone.cpp \
+           ../pdepn.cpp \
+           ../pdunspecifiedepn.cpp \
+           ../pdsourcesink.cpp \
+           ../pdsimplechemepn.cpp \
+           ../pdmacromolepn.cpp \
+           ../pdnucleicepn.cpp \
+           ../pdcomplexepn.cpp \
+           ../pdperturbingepn.cpp \
+           ../pdphenotypeprocessnode.cpp \
+           ../pdlogicaloperators.cpp \
+           ../pdprocessnode.cpp \
+           ../cdSpeciesAlias.cpp \
+           ../sbmlstreamreader.cpp